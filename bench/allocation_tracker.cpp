@@ -0,0 +1,155 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// Replacement global allocation functions that count allocations and track
+// live heap bytes for the benchmarks. Replacements must not be attached to a
+// named module, so this is a plain translation unit.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	// Every block carries its size in a header aligned like the block itself
+	constexpr std::size_t HEADER_SIZE = alignof( std::max_align_t );
+
+	std::atomic<std::size_t> allocationCount{ 0 };
+	std::atomic<std::size_t> liveBytes{ 0 };
+	std::atomic<std::size_t> peakBytes{ 0 };
+
+	// Header size that keeps a block of the given alignment aligned
+	constexpr std::size_t headerSizeFor( std::size_t alignment ) noexcept
+	{
+		return alignment > HEADER_SIZE ? alignment : HEADER_SIZE;
+	}
+
+	void* allocate( std::size_t size, std::size_t alignment = HEADER_SIZE )
+	{
+		auto header = headerSizeFor( alignment );
+		auto* block = static_cast< unsigned char* >( header == HEADER_SIZE
+			? std::malloc( size + header )
+			: std::aligned_alloc( header, ( size + 2 * header - 1 ) / header * header ) );
+		if( !block )
+			throw std::bad_alloc( );
+
+		*reinterpret_cast< std::size_t* >( block ) = size;
+		allocationCount.fetch_add( 1, std::memory_order_relaxed );
+
+		auto live = liveBytes.fetch_add( size, std::memory_order_relaxed ) + size;
+		auto peak = peakBytes.load( std::memory_order_relaxed );
+		while( live > peak && !peakBytes.compare_exchange_weak( peak, live, std::memory_order_relaxed ) )
+		{
+		}
+
+		return block + header;
+	}
+
+	void deallocate( void* ptr, std::size_t alignment = HEADER_SIZE ) noexcept
+	{
+		if( !ptr )
+			return;
+
+		auto* block = static_cast< unsigned char* >( ptr ) - headerSizeFor( alignment );
+		liveBytes.fetch_sub( *reinterpret_cast< std::size_t* >( block ), std::memory_order_relaxed );
+		std::free( block );
+	}
+}
+
+extern "C" std::size_t ticksBenchAllocationCount( )
+{
+	return allocationCount.load( std::memory_order_relaxed );
+}
+
+extern "C" std::size_t ticksBenchLiveBytes( )
+{
+	return liveBytes.load( std::memory_order_relaxed );
+}
+
+extern "C" std::size_t ticksBenchPeakBytes( )
+{
+	return peakBytes.load( std::memory_order_relaxed );
+}
+
+extern "C" void ticksBenchResetPeak( )
+{
+	peakBytes.store( liveBytes.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+}
+
+void* operator new( std::size_t size )
+{
+	return allocate( size );
+}
+
+void* operator new[ ]( std::size_t size )
+{
+	return allocate( size );
+}
+
+void operator delete( void* ptr ) noexcept
+{
+	deallocate( ptr );
+}
+
+void operator delete[ ]( void* ptr ) noexcept
+{
+	deallocate( ptr );
+}
+
+void operator delete( void* ptr, std::size_t ) noexcept
+{
+	deallocate( ptr );
+}
+
+void operator delete[ ]( void* ptr, std::size_t ) noexcept
+{
+	deallocate( ptr );
+}
+
+// Aligned forms, used among others by the std::pmr default resource
+void* operator new( std::size_t size, std::align_val_t alignment )
+{
+	return allocate( size, static_cast< std::size_t >( alignment ) );
+}
+
+void* operator new[ ]( std::size_t size, std::align_val_t alignment )
+{
+	return allocate( size, static_cast< std::size_t >( alignment ) );
+}
+
+void operator delete( void* ptr, std::align_val_t alignment ) noexcept
+{
+	deallocate( ptr, static_cast< std::size_t >( alignment ) );
+}
+
+void operator delete[ ]( void* ptr, std::align_val_t alignment ) noexcept
+{
+	deallocate( ptr, static_cast< std::size_t >( alignment ) );
+}
+
+void operator delete( void* ptr, std::size_t, std::align_val_t alignment ) noexcept
+{
+	deallocate( ptr, static_cast< std::size_t >( alignment ) );
+}
+
+void operator delete[ ]( void* ptr, std::size_t, std::align_val_t alignment ) noexcept
+{
+	deallocate( ptr, static_cast< std::size_t >( alignment ) );
+}
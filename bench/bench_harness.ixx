@@ -0,0 +1,151 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module bench.harness;
+
+import <chrono>;
+import <cstddef>;
+import <functional>;
+import <iomanip>;
+import <iostream>;
+import <limits>;
+import <string>;
+import <string_view>;
+import <utility>;
+import <vector>;
+
+// Provided by allocation_tracker.cpp
+extern "C" std::size_t ticksBenchAllocationCount( );
+extern "C" std::size_t ticksBenchLiveBytes( );
+extern "C" std::size_t ticksBenchPeakBytes( );
+extern "C" void ticksBenchResetPeak( );
+
+/**
+ * @brief Heap usage observed while an AllocationScope was alive
+ */
+export struct AllocationStats
+{
+	std::size_t allocations = 0;
+	std::size_t peakBytes = 0;
+};
+
+/**
+ * @brief Measures allocation count and peak heap growth during its lifetime
+ */
+export class AllocationScope
+{
+public:
+	// Constructor - starts measuring
+	AllocationScope( );
+
+	// Get the statistics gathered so far
+	[[nodiscard]] AllocationStats getStats( ) const;
+
+private:
+	std::size_t startCount_;
+	std::size_t startLiveBytes_;
+};
+
+export using BenchmarkFunction = std::function<void( )>;
+
+// Register a benchmark; returns true so it can initialize a static
+export bool registerBenchmark( std::string name, BenchmarkFunction function );
+
+// Run all benchmarks whose name contains filter
+export int runBenchmarks( std::string_view filter );
+
+// Print a single measurement
+export void report( std::string_view metric, double value, std::string_view unit );
+
+// Keep a computed value observable so the optimizer cannot drop its computation
+export void doNotOptimize( std::size_t value );
+
+// Run function the given number of times and return the fastest run in seconds
+export template<typename Function>
+[[nodiscard]] double measureSeconds( Function&& function, int repetitions = 3 )
+{
+	double best = std::numeric_limits<double>::max( );
+	for( int i = 0; i < repetitions; ++i ) {
+		auto start = std::chrono::steady_clock::now( );
+		function( );
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now( ) - start;
+		if( elapsed.count( ) < best )
+			best = elapsed.count( );
+	}
+	return best;
+}
+
+// Implementation
+namespace
+{
+	std::vector<std::pair<std::string, BenchmarkFunction>>& registry( )
+	{
+		static std::vector<std::pair<std::string, BenchmarkFunction>> benchmarks;
+		return benchmarks;
+	}
+
+	volatile std::size_t sink = 0;
+}
+
+AllocationScope::AllocationScope( )
+	: startCount_( ticksBenchAllocationCount( ) ),
+	startLiveBytes_( ticksBenchLiveBytes( ) )
+{
+	ticksBenchResetPeak( );
+}
+
+AllocationStats AllocationScope::getStats( ) const
+{
+	auto peak = ticksBenchPeakBytes( );
+	return AllocationStats{
+		ticksBenchAllocationCount( ) - startCount_,
+		peak > startLiveBytes_ ? peak - startLiveBytes_ : 0
+	};
+}
+
+bool registerBenchmark( std::string name, BenchmarkFunction function )
+{
+	registry( ).emplace_back( std::move( name ), std::move( function ) );
+	return true;
+}
+
+int runBenchmarks( std::string_view filter )
+{
+	int runCount = 0;
+	for( const auto& [name, function] : registry( ) ) {
+		if( name.find( filter ) == std::string::npos )
+			continue;
+
+		std::cout << "== " << name << std::endl;
+		function( );
+		++runCount;
+	}
+	return runCount;
+}
+
+void report( std::string_view metric, double value, std::string_view unit )
+{
+	std::cout << "  " << std::left << std::setw( 44 ) << metric
+		<< std::right << std::setw( 16 ) << std::fixed << std::setprecision( 2 ) << value
+		<< " " << unit << std::endl;
+}
+
+void doNotOptimize( std::size_t value )
+{
+	sink = sink + value;
+}
@@ -0,0 +1,34 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module bench_main;
+
+import bench.harness;
+import <iostream>;
+import <string_view>;
+
+// Usage: Ticks_bench [filter] - runs every benchmark whose name contains filter
+int main( int argc, char** argv )
+{
+	std::string_view filter = argc > 1 ? argv[ 1 ] : "";
+	if( runBenchmarks( filter ) == 0 ) {
+		std::cerr << "No benchmark matches '" << filter << "'" << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,221 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+module;
+
+#include <yaml-cpp/yaml.h>
+
+export module config_bench;
+
+import bench.harness;
+import model.config;
+import model.item;
+import <filesystem>;
+import <algorithm>;
+import <chrono>;
+import <fstream>;
+import <limits>;
+import <memory_resource>;
+import <optional>;
+import <utility>;
+import <span>;
+import <string>;
+import <vector>;
+
+namespace
+{
+	// Node-based loader the streaming reader replaced, kept as the baseline
+	std::vector<Item> loadWithDom( const std::filesystem::path& filePath )
+	{
+		YAML::Node rootNode = YAML::LoadFile( filePath.string( ) );
+
+		std::vector<Item> items;
+		for( const auto& itemNode : rootNode[ "items" ] ) {
+			if( !itemNode.IsMap( ) )
+				continue;
+
+			items.emplace_back(
+				itemNode[ "name" ] ? itemNode[ "name" ].as<std::string>( ) : "",
+				itemNode[ "type" ] ? itemNode[ "type" ].as<std::string>( ) : "",
+				itemNode[ "action" ] ? itemNode[ "action" ].as<std::string>( ) : "",
+				itemNode[ "timeout" ] ? itemNode[ "timeout" ].as<int>( ) : 0 );
+		}
+		return items;
+	}
+
+	// Node-based writer the streaming emitter replaced, kept as the baseline
+	bool saveWithDom( std::span<const Item> items, const std::filesystem::path& filePath )
+	{
+		YAML::Node rootNode;
+		YAML::Node itemsNode;
+		for( const auto& item : items ) {
+			YAML::Node itemNode;
+			itemNode[ "name" ] = std::string( item.getName( ) );
+			itemNode[ "type" ] = std::string( item.getType( ) );
+			itemNode[ "action" ] = std::string( item.getAction( ) );
+			itemNode[ "timeout" ] = item.getTimeout( );
+			itemsNode.push_back( itemNode );
+		}
+		rootNode[ "items" ] = itemsNode;
+
+		std::ofstream fout( filePath );
+		fout << YAML::Dump( rootNode );
+		return static_cast< bool >( fout );
+	}
+
+	Config createCatalog( int itemCount )
+	{
+		std::vector<Item> items;
+		items.reserve( itemCount );
+		for( int i = 0; i < itemCount; ++i ) {
+			items.emplace_back(
+				"Item number " + std::to_string( i ),
+				"Type " + std::to_string( i % 16 ),
+				"run-task --id " + std::to_string( i ) + " --verbose",
+				60 + i % 3600 );
+		}
+		return Config( items );
+	}
+
+	void runYamlBenchmark( int itemCount )
+	{
+		auto filePath = std::filesystem::temp_directory_path( ) / "ticks_config_bench.yaml";
+		auto domPath = std::filesystem::temp_directory_path( ) / "ticks_config_bench_dom.yaml";
+		auto catalog = createCatalog( itemCount );
+		catalog.saveToYaml( filePath );
+
+		auto megabytes = static_cast< double >( std::filesystem::file_size( filePath ) ) / ( 1024.0 * 1024.0 );
+		auto prefix = std::to_string( itemCount ) + " items ";
+		report( prefix + "file size", megabytes, "MiB" );
+
+		// Loading
+		{
+			AllocationScope scope;
+			auto config = Config::loadFromYaml( filePath );
+			doNotOptimize( config ? config->getItems( ).size( ) : 0 );
+			report( prefix + "streaming load peak heap", scope.getStats( ).peakBytes / 1024.0, "KiB" );
+		}
+		{
+			AllocationScope scope;
+			auto items = loadWithDom( filePath );
+			doNotOptimize( items.size( ) );
+			report( prefix + "DOM load peak heap", scope.getStats( ).peakBytes / 1024.0, "KiB" );
+		}
+
+		auto streamingLoad = measureSeconds( [&filePath]( )
+			{
+				auto config = Config::loadFromYaml( filePath );
+				doNotOptimize( config ? config->getItems( ).size( ) : 0 );
+			} );
+		auto domLoad = measureSeconds( [&filePath]( )
+			{
+				doNotOptimize( loadWithDom( filePath ).size( ) );
+			} );
+		report( prefix + "streaming load throughput", megabytes / streamingLoad, "MiB/s" );
+		report( prefix + "DOM load throughput", megabytes / domLoad, "MiB/s" );
+
+		// Saving
+		{
+			AllocationScope scope;
+			catalog.saveToYaml( filePath );
+			report( prefix + "streaming save peak heap", scope.getStats( ).peakBytes / 1024.0, "KiB" );
+		}
+		{
+			AllocationScope scope;
+			saveWithDom( catalog.getItems( ), domPath );
+			report( prefix + "DOM save peak heap", scope.getStats( ).peakBytes / 1024.0, "KiB" );
+		}
+
+		// The streaming save also syncs the file to disk, which the baseline does not
+		auto streamingSave = measureSeconds( [&]( ) { catalog.saveToYaml( filePath ); } );
+		auto domSave = measureSeconds( [&]( ) { saveWithDom( catalog.getItems( ), domPath ); } );
+		report( prefix + "streaming save throughput", megabytes / streamingSave, "MiB/s" );
+		report( prefix + "DOM save throughput", megabytes / domSave, "MiB/s" );
+
+		std::filesystem::remove( filePath );
+		std::filesystem::remove( domPath );
+	}
+
+	// Fastest of a few releases of a loaded configuration, in seconds
+	double measureTeardown( const std::filesystem::path& filePath, std::pmr::memory_resource* resource )
+	{
+		double best = std::numeric_limits<double>::max( );
+		for( int i = 0; i < 3; ++i ) {
+			auto config = Config::loadFromYaml( filePath, resource );
+			auto start = std::chrono::steady_clock::now( );
+			config.reset( );
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now( ) - start;
+			best = std::min( best, elapsed.count( ) );
+		}
+		return best;
+	}
+
+	// Per-version arena against one allocation per string from the default heap
+	void runArenaBenchmark( int itemCount )
+	{
+		auto filePath = std::filesystem::temp_directory_path( ) / "ticks_config_pmr_bench.yaml";
+		createCatalog( itemCount ).saveToYaml( filePath );
+		auto prefix = std::to_string( itemCount ) + " items ";
+		auto* heap = std::pmr::new_delete_resource( );
+
+		for( auto [name, resource] : { std::pair{ "arena", static_cast< std::pmr::memory_resource* >( nullptr ) }, std::pair{ "heap", heap } } ) {
+			{
+				AllocationScope scope;
+				auto config = Config::loadFromYaml( filePath, resource );
+				doNotOptimize( config ? config->getItems( ).size( ) : 0 );
+				report( prefix + name + " load allocations", static_cast< double >( scope.getStats( ).allocations ), "" );
+			}
+
+			auto load = measureSeconds( [&filePath, resource]( )
+				{
+					auto config = Config::loadFromYaml( filePath, resource );
+					doNotOptimize( config ? config->getItems( ).size( ) : 0 );
+				} );
+			report( prefix + name + " load", load * 1e3, "ms" );
+			report( prefix + name + " teardown", measureTeardown( filePath, resource ) * 1e3, "ms" );
+
+			// The parser allocates per event; copying a catalog shows the storage alone
+			auto config = Config::loadFromYaml( filePath, resource );
+			{
+				AllocationScope scope;
+				Config copy( config->getItems( ), resource );
+				doNotOptimize( copy.getItems( ).size( ) );
+				report( prefix + name + " copy allocations", static_cast< double >( scope.getStats( ).allocations ), "" );
+			}
+
+			auto edit = measureSeconds( [&config]( )
+				{
+					doNotOptimize( config->withAddedItem( Item( "Added" ) ).getItems( ).size( ) );
+				} );
+			report( prefix + name + " add item and drop version", edit * 1e3, "ms" );
+		}
+
+		std::filesystem::remove( filePath );
+	}
+
+	[[maybe_unused]] const bool configBenchmarkRegistered = registerBenchmark( "config/yaml", []( )
+		{
+			runYamlBenchmark( 1'000 );
+			runYamlBenchmark( 100'000 );
+		} );
+
+	[[maybe_unused]] const bool configArenaBenchmarkRegistered = registerBenchmark( "config/pmr", []( )
+		{
+			runArenaBenchmark( 100'000 );
+		} );
+}
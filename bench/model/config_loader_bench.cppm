@@ -0,0 +1,107 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module config_loader_bench;
+
+import bench.harness;
+import model.config;
+import model.config_loader;
+import model.item;
+import model.thread_pool;
+import <algorithm>;
+import <chrono>;
+import <filesystem>;
+import <string>;
+import <thread>;
+import <vector>;
+
+namespace
+{
+	// A catalog assembled from many team-owned files
+	constexpr int FRAGMENT_COUNT = 64;
+	constexpr int ITEMS_PER_FRAGMENT = 1'500;
+
+	void writeFragment( const std::filesystem::path& filePath, int fragment, int revision )
+	{
+		std::vector<Item> items;
+		items.reserve( ITEMS_PER_FRAGMENT );
+		for( int i = 0; i < ITEMS_PER_FRAGMENT; ++i ) {
+			items.emplace_back(
+				"Team " + std::to_string( fragment ) + " item " + std::to_string( i ),
+				"Type " + std::to_string( i % 16 ),
+				"run-task --id " + std::to_string( i ) + " --revision " + std::to_string( revision ),
+				60 + i % 3600 );
+		}
+		Config( items ).saveToYaml( filePath );
+	}
+
+	[[maybe_unused]] const bool configLoaderBenchmarkRegistered = registerBenchmark( "config/include", []( )
+		{
+			auto dir = std::filesystem::temp_directory_path( ) / "ticks_config_loader_bench";
+			std::filesystem::remove_all( dir );
+			std::filesystem::create_directories( dir / "teams" );
+
+			Config( ).withIncludes( { "teams/*.yaml" } ).saveToYaml( dir / "root.yaml" );
+			for( int i = 0; i < FRAGMENT_COUNT; ++i )
+				writeFragment( dir / "teams" / ( "team" + std::to_string( i ) + ".yaml" ), i, 0 );
+
+			auto prefix = std::to_string( FRAGMENT_COUNT ) + "x" + std::to_string( ITEMS_PER_FRAGMENT ) + " items ";
+			auto coreCount = std::max( 1u, std::thread::hardware_concurrency( ) );
+			report( "hardware threads", coreCount, "" );
+
+			for( auto threadCount : { 1u, coreCount } ) {
+				ThreadPool threadPool( threadCount );
+				auto cold = measureSeconds( [&threadPool, &dir]( )
+					{
+						ConfigLoader loader( threadPool );
+						auto config = loader.load( dir / "root.yaml" );
+						doNotOptimize( config ? config->merged.getItems( ).size( ) : 0 );
+					} );
+				report( prefix + "cold load, " + std::to_string( threadCount ) + " thread(s)", cold * 1e3, "ms" );
+				if( coreCount == 1 )
+					break;
+			}
+
+			ThreadPool threadPool;
+			ConfigLoader loader( threadPool );
+			doNotOptimize( loader.load( dir / "root.yaml" ) ? 1 : 0 );
+
+			auto unchanged = measureSeconds( [&loader, &dir]( )
+				{
+					auto config = loader.load( dir / "root.yaml" );
+					doNotOptimize( config ? config->merged.getItems( ).size( ) : 0 );
+				} );
+			report( prefix + "reload, nothing changed", unchanged * 1e3, "ms" );
+
+			int revision = 0;
+			auto oneChanged = measureSeconds( [&loader, &dir, &revision]( )
+				{
+					auto fragmentPath = dir / "teams" / "team7.yaml";
+					writeFragment( fragmentPath, 7, ++revision );
+					std::filesystem::last_write_time( fragmentPath,
+						std::filesystem::last_write_time( fragmentPath ) + std::chrono::seconds( revision ) );
+
+					auto config = loader.load( dir / "root.yaml" );
+					doNotOptimize( config ? config->merged.getItems( ).size( ) : 0 );
+				} );
+			report( prefix + "reload, one fragment changed", oneChanged * 1e3, "ms" );
+			report( prefix + "fragments parsed on last reload", static_cast< double >( loader.getParsedCount( ) ), "" );
+
+			std::filesystem::remove_all( dir );
+		} );
+}
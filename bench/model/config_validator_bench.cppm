@@ -0,0 +1,85 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module config_validator_bench;
+
+import bench.harness;
+import model.config;
+import model.config_validator;
+import model.item;
+import model.thread_pool;
+import <algorithm>;
+import <filesystem>;
+import <string>;
+import <thread>;
+import <vector>;
+
+namespace
+{
+	// A large catalog with a few repeated names and missing timeouts
+	constexpr int VALIDATED_ITEM_COUNT = 100'000;
+
+	[[maybe_unused]] const bool configValidatorBenchmarkRegistered = registerBenchmark( "config/validate", []( )
+		{
+			auto filePath = std::filesystem::temp_directory_path( ) / "ticks_config_validator_bench.yaml";
+
+			std::vector<Item> items;
+			items.reserve( VALIDATED_ITEM_COUNT );
+			for( int i = 0; i < VALIDATED_ITEM_COUNT; ++i ) {
+				int nameIndex = i % 5'000 == 4'999 ? i - 1 : i;
+				items.emplace_back(
+					"Catalog item " + std::to_string( nameIndex ),
+					"Type " + std::to_string( i % 16 ),
+					"run-task --id " + std::to_string( i ),
+					i % 7'000 == 0 ? 0 : 60 + i % 3600 );
+			}
+			Config( items ).saveToYaml( filePath );
+
+			ConfigSource source;
+			std::size_t itemCount = 0;
+			auto parse = measureSeconds( [&filePath, &source, &itemCount]( )
+				{
+					source = ConfigSource{ };
+					auto config = Config::loadFromYaml( filePath, nullptr, &source );
+					itemCount = config ? config->getItems( ).size( ) : 0;
+					doNotOptimize( itemCount );
+				} );
+			auto prefix = std::to_string( itemCount ) + " items ";
+			report( prefix + "parse", parse * 1e3, "ms" );
+
+			auto coreCount = std::max( 1u, std::thread::hardware_concurrency( ) );
+			std::size_t problemCount = 0;
+			for( auto threadCount : { 1u, coreCount } ) {
+				ThreadPool threadPool( threadCount );
+				ConfigValidator validator( threadPool );
+				auto validate = measureSeconds( [&validator, &items, &source, &filePath, &problemCount]( )
+					{
+						problemCount = validator.validate( items, source.items, filePath ).size( );
+						doNotOptimize( problemCount );
+					} );
+				auto label = prefix + "validate, " + std::to_string( threadCount ) + " thread(s)";
+				report( label, validate * 1e3, "ms" );
+				report( label + ", share of parse", validate / parse * 100, "%" );
+				if( coreCount == 1 )
+					break;
+			}
+			report( prefix + "problems found", static_cast< double >( problemCount ), "" );
+
+			std::filesystem::remove( filePath );
+		} );
+}
@@ -0,0 +1,238 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module item_schema_bench;
+
+import bench.harness;
+import model.item;
+import model.item_schema;
+import <charconv>;
+import <cstdint>;
+import <optional>;
+import <string>;
+import <string_view>;
+import <vector>;
+
+namespace
+{
+	constexpr int SCHEMA_ITEM_COUNT = 100'000;
+
+	// Handwritten counterparts of the code expanded from ItemSchema, field by field
+
+	bool handwrittenEqual( const Item& a, const Item& b )
+	{
+		return a.getName( ) == b.getName( ) && a.getType( ) == b.getType( ) && a.getAction( ) == b.getAction( ) &&
+			a.getTimeout( ) == b.getTimeout( ) && a.getSchedule( ) == b.getSchedule( );
+	}
+
+	std::size_t handwrittenHash( const Item& item )
+	{
+		std::uint64_t state = 0xcbf29ce484222325ull;
+		auto mix = [&state]( std::uint64_t value )
+			{
+				for( int i = 0; i < 8; ++i, value >>= 8 ) {
+					state ^= value & 0xff;
+					state *= 0x100000001b3ull;
+				}
+			};
+		auto text = [&state, &mix]( std::string_view value )
+			{
+				mix( value.size( ) );
+				for( unsigned char c : value ) {
+					state ^= c;
+					state *= 0x100000001b3ull;
+				}
+			};
+		text( item.getName( ) );
+		text( item.getType( ) );
+		text( item.getAction( ) );
+		mix( static_cast< std::uint32_t >( item.getTimeout( ) ) );
+		text( item.getSchedule( ) );
+		return static_cast< std::size_t >( state );
+	}
+
+	void putSchemaVarint( std::string& bytes, std::uint64_t value )
+	{
+		while( value >= 0x80 ) {
+			bytes.push_back( static_cast< char >( value | 0x80 ) );
+			value >>= 7;
+		}
+		bytes.push_back( static_cast< char >( value ) );
+	}
+
+	bool getSchemaVarint( std::string_view& bytes, std::uint64_t& value )
+	{
+		value = 0;
+		for( int shift = 0; shift < 64 && !bytes.empty( ); shift += 7 ) {
+			auto byte = static_cast< unsigned char >( bytes.front( ) );
+			bytes.remove_prefix( 1 );
+			value |= static_cast< std::uint64_t >( byte & 0x7f ) << shift;
+			if( ( byte & 0x80 ) == 0 )
+				return true;
+		}
+		return false;
+	}
+
+	void handwrittenEncode( const Item& item, std::string& bytes )
+	{
+		auto text = [&bytes]( std::string_view value )
+			{
+				putSchemaVarint( bytes, value.size( ) );
+				bytes.append( value );
+			};
+		bytes.push_back( 5 );
+		text( item.getName( ) );
+		text( item.getType( ) );
+		text( item.getAction( ) );
+		auto wide = static_cast< std::int64_t >( item.getTimeout( ) );
+		putSchemaVarint( bytes, ( static_cast< std::uint64_t >( wide ) << 1 ) ^ static_cast< std::uint64_t >( wide >> 63 ) );
+		text( item.getSchedule( ) );
+	}
+
+	std::optional<Item> handwrittenDecode( std::string_view bytes )
+	{
+		if( bytes.empty( ) || bytes.front( ) != 5 )
+			return std::nullopt;
+		bytes.remove_prefix( 1 );
+
+		std::string name, type, action, schedule;
+		std::uint64_t timeout = 0;
+		auto text = [&bytes]( std::string& value )
+			{
+				std::uint64_t size = 0;
+				if( !getSchemaVarint( bytes, size ) || size > bytes.size( ) )
+					return false;
+				value.assign( bytes.substr( 0, size ) );
+				bytes.remove_prefix( size );
+				return true;
+			};
+		if( !text( name ) || !text( type ) || !text( action ) || !getSchemaVarint( bytes, timeout ) || !text( schedule ) ||
+			!bytes.empty( ) )
+			return std::nullopt;
+		return Item( name, type, action,
+			static_cast< int >( static_cast< std::int64_t >( timeout >> 1 ) ^ -static_cast< std::int64_t >( timeout & 1 ) ), schedule );
+	}
+
+	void handwrittenColumns( const Item& item, std::string& row )
+	{
+		char timeout[ 16 ];
+		auto [end, ec] = std::to_chars( timeout, timeout + sizeof( timeout ), item.getTimeout( ) );
+		row.append( item.getName( ) ).append( item.getType( ) ).append( item.getAction( ) )
+			.append( timeout, end ).append( item.getSchedule( ) );
+	}
+
+	// Time per item of function applied to every item
+	template<typename Function>
+	double nanosPerItem( Function&& function )
+	{
+		return measureSeconds( function, 5 ) * 1e9 / SCHEMA_ITEM_COUNT;
+	}
+
+	[[maybe_unused]] const bool itemSchemaBenchmarkRegistered = registerBenchmark( "items/schema", []( )
+		{
+			std::vector<Item> items;
+			items.reserve( SCHEMA_ITEM_COUNT );
+			for( int i = 0; i < SCHEMA_ITEM_COUNT; ++i )
+				items.emplace_back(
+					"Catalog item " + std::to_string( i ),
+					"Type " + std::to_string( i % 16 ),
+					"run-task --id " + std::to_string( i ),
+					60 + i % 3600,
+					i % 10 == 0 ? "every 15m" : "" );
+			std::vector<Item> copies( items.begin( ), items.end( ) );
+
+			auto compare = [&items, &copies]( auto equal )
+				{
+					return nanosPerItem( [&]( )
+						{
+							std::size_t equalCount = 0;
+							for( std::size_t i = 0; i < items.size( ); ++i )
+								equalCount += equal( items[ i ], copies[ i ] ) ? 1 : 0;
+							doNotOptimize( equalCount );
+						} );
+				};
+			report( "equality, handwritten", compare( handwrittenEqual ), "ns/item" );
+			report( "equality, defaulted", compare( []( const Item& a, const Item& b ) { return a == b; } ), "ns/item" );
+
+			auto hashAll = [&items]( auto hash )
+				{
+					return nanosPerItem( [&]( )
+						{
+							std::size_t combined = 0;
+							for( const auto& item : items )
+								combined ^= hash( item );
+							doNotOptimize( combined );
+						} );
+				};
+			report( "hash, handwritten", hashAll( handwrittenHash ), "ns/item" );
+			report( "hash, schema", hashAll( []( const Item& item ) { return ItemSchema::hash( item ); } ), "ns/item" );
+
+			std::string bytes;
+			auto encodeAll = [&items, &bytes]( auto encode )
+				{
+					return nanosPerItem( [&]( )
+						{
+							bytes.clear( );
+							for( const auto& item : items )
+								encode( item, bytes );
+							doNotOptimize( bytes.size( ) );
+						} );
+				};
+			report( "binary encode, handwritten", encodeAll( handwrittenEncode ), "ns/item" );
+			report( "binary encode, schema", encodeAll( []( const Item& item, std::string& out ) { ItemSchema::encode( item, out ); } ), "ns/item" );
+
+			// Single items as drag and drop carries them
+			std::vector<std::string> encoded;
+			encoded.reserve( items.size( ) );
+			for( const auto& item : items ) {
+				ItemSchema::encode( item, encoded.emplace_back( ) );
+				if( handwrittenDecode( encoded.back( ) ) != ItemSchema::decode( encoded.back( ) ) )
+					report( "binary decode mismatch", 1, "" );
+			}
+			auto decodeAll = [&encoded]( auto decode )
+				{
+					return nanosPerItem( [&]( )
+						{
+							std::size_t decodedCount = 0;
+							for( const auto& itemBytes : encoded )
+								decodedCount += decode( itemBytes ) ? 1 : 0;
+							doNotOptimize( decodedCount );
+						} );
+				};
+			report( "binary decode, handwritten", decodeAll( handwrittenDecode ), "ns/item" );
+			report( "binary decode, schema", decodeAll( []( std::string_view itemBytes ) { return ItemSchema::decode( itemBytes ); } ), "ns/item" );
+
+			std::string row;
+			auto formatAll = [&items, &row]( auto format )
+				{
+					return nanosPerItem( [&]( )
+						{
+							for( const auto& item : items ) {
+								row.clear( );
+								format( item, row );
+							}
+							doNotOptimize( row.size( ) );
+						} );
+				};
+			report( "list columns, handwritten", formatAll( handwrittenColumns ), "ns/item" );
+			report( "list columns, schema", formatAll( []( const Item& item, std::string& out )
+				{
+					ItemSchema::formatColumns( item, [&out]( std::size_t, std::string_view text ) { out.append( text ); } );
+				} ), "ns/item" );
+		} );
+}
@@ -0,0 +1,130 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module refresh_bench;
+
+import bench.harness;
+import model.item;
+import model.timer_store;
+import <algorithm>;
+import <chrono>;
+import <functional>;
+import <optional>;
+import <random>;
+import <string>;
+import <string_view>;
+import <thread>;
+import <vector>;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+	using TimePoint = TimerStore::TimePoint;
+	using NextWakeup = std::function<std::optional<TimePoint>( const TimerStore&, TimePoint )>;
+
+	constexpr auto SIMULATED_TIME = 10min;
+	constexpr auto REFRESH_WINDOW = 100ms;
+	constexpr int ONE_SHOT_SAMPLES = 50;
+
+	struct RefreshStats
+	{
+		double wakeupsPerMinute = 0.0;
+		double meanLatencyMs = 0.0;
+		double maxLatencyMs = 0.0;
+	};
+
+	// Start timerCount timers at random phases and drive the store on a virtual clock
+	RefreshStats simulate( int timerCount, const NextWakeup& nextWakeup )
+	{
+		TimerStore timers;
+		auto start = TimePoint( 1'000'000s );
+		auto now = start;
+
+		double totalLatency = 0.0;
+		double maxLatency = 0.0;
+		int completions = 0;
+		timers.setRunListener( [&]( const TimerStore::RunEnd& runEnd )
+			{
+				double latency = std::chrono::duration<double, std::milli>( now - runEnd.endedAt ).count( );
+				totalLatency += latency;
+				maxLatency = std::max( maxLatency, latency );
+				++completions;
+			} );
+
+		std::mt19937 random( 7 );
+		for( int i = 0; i < timerCount; ++i ) {
+			auto id = timers.add( Item( "Timer " + std::to_string( i ), "Bench", "", 30 + static_cast< int >( random( ) % 270 ) ) );
+			timers.start( id, start + std::chrono::milliseconds( random( ) % 1000 ) );
+		}
+
+		int wakeups = 0;
+		auto end = start + SIMULATED_TIME;
+		while( auto next = nextWakeup( timers, now ) ) {
+			if( *next > end )
+				break;
+			now = std::max( now, *next );
+			timers.update( now );
+			++wakeups;
+		}
+
+		RefreshStats stats;
+		stats.wakeupsPerMinute = wakeups / std::chrono::duration<double, std::ratio<60>>( SIMULATED_TIME ).count( );
+		stats.meanLatencyMs = completions > 0 ? totalLatency / completions : 0.0;
+		stats.maxLatencyMs = maxLatency;
+		return stats;
+	}
+
+	void reportStats( std::string_view name, const RefreshStats& stats )
+	{
+		std::string prefix( name );
+		report( prefix + " wakeups", stats.wakeupsPerMinute, "per min" );
+		report( prefix + " completion latency mean", stats.meanLatencyMs, "ms" );
+		report( prefix + " completion latency max", stats.maxLatencyMs, "ms" );
+	}
+
+	[[maybe_unused]] const bool refreshBenchmarkRegistered = registerBenchmark( "timers/refresh", []( )
+		{
+			// The former unconditional 1 Hz tick
+			NextWakeup periodic = []( const TimerStore&, TimePoint now ) -> std::optional<TimePoint> { return now + 1s; };
+
+			// Deadline-driven while visible, expiries only while minimized
+			NextWakeup visible = []( const TimerStore& timers, TimePoint now ) { return timers.getNextDisplayChange( now, REFRESH_WINDOW ); };
+			NextWakeup minimized = []( const TimerStore& timers, TimePoint ) { return timers.getNextExpiry( ); };
+
+			for( int timerCount : { 0, 1, 10 } ) {
+				auto suffix = " (" + std::to_string( timerCount ) + " timers)";
+				reportStats( "1 Hz tick" + suffix, simulate( timerCount, periodic ) );
+				reportStats( "deadline-driven" + suffix, simulate( timerCount, visible ) );
+				reportStats( "minimized" + suffix, simulate( timerCount, minimized ) );
+			}
+
+			// How late a one-shot wakeup lands on this system
+			double totalJitter = 0.0;
+			double maxJitter = 0.0;
+			for( int i = 0; i < ONE_SHOT_SAMPLES; ++i ) {
+				auto deadline = std::chrono::steady_clock::now( ) + 10ms;
+				std::this_thread::sleep_until( deadline );
+				double jitter = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now( ) - deadline ).count( );
+				totalJitter += jitter;
+				maxJitter = std::max( maxJitter, jitter );
+			}
+			report( "one-shot wakeup jitter mean", totalJitter / ONE_SHOT_SAMPLES, "ms" );
+			report( "one-shot wakeup jitter max", maxJitter, "ms" );
+		} );
+}
@@ -0,0 +1,73 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module run_history_bench;
+
+import bench.harness;
+import model.item;
+import model.run_history;
+import <cstdint>;
+import <filesystem>;
+import <string>;
+
+namespace
+{
+	// Roughly half a year of a busy instance: ~2000 runs a day over 50 items
+	constexpr int RUN_COUNT = 365'000;
+	constexpr int ITEM_COUNT = 50;
+
+	[[maybe_unused]] const bool runHistoryBenchmarkRegistered = registerBenchmark( "history/open", []( )
+		{
+			auto filePath = std::filesystem::temp_directory_path( ) / "ticks_run_history_bench.bin";
+			auto snapshotPath = filePath;
+			snapshotPath += ".stats";
+			std::filesystem::remove( filePath );
+			std::filesystem::remove( snapshotPath );
+
+			{
+				RunHistory history( filePath );
+				std::int64_t start = 1'700'000'000'000;
+				for( int i = 0; i < RUN_COUNT; ++i ) {
+					auto key = RunHistory::keyOf( Item( "Item " + std::to_string( i % ITEM_COUNT ) ) );
+					history.record( RunRecord{ key, start, 60'000 + ( i * 7919ll ) % 600'000, RunOutcome::Completed } );
+					start += 43'000;
+				}
+			}
+
+			report( "history file size", static_cast< double >( std::filesystem::file_size( filePath ) ) / 1024.0, "KiB" );
+			report( "history bytes per run", static_cast< double >( std::filesystem::file_size( filePath ) ) / RUN_COUNT, "bytes" );
+
+			auto withSnapshot = measureSeconds( [&filePath]( )
+				{
+					RunHistory history( filePath );
+					doNotOptimize( history.getReplayedCount( ) );
+				} );
+			report( "open with snapshot", withSnapshot * 1e3, "ms" );
+
+			auto fullReplay = measureSeconds( [&filePath, &snapshotPath]( )
+				{
+					std::filesystem::remove( snapshotPath );
+					RunHistory history( filePath );
+					doNotOptimize( history.getReplayedCount( ) );
+				} );
+			report( "open replaying all runs", fullReplay * 1e3, "ms" );
+
+			std::filesystem::remove( filePath );
+			std::filesystem::remove( snapshotPath );
+		} );
+}
@@ -0,0 +1,124 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module schedule_bench;
+
+import bench.harness;
+import model.item;
+import model.schedule;
+import model.timer_store;
+import <chrono>;
+import <ctime>;
+import <string>;
+import <vector>;
+
+namespace
+{
+	constexpr int QUERY_COUNT = 2'000;
+	constexpr int RECURRING_COUNT = 10'000;
+	constexpr int TICK_COUNT = 60;
+
+	using namespace std::chrono_literals;
+
+	// Baseline: step minute by minute through local time until mon 09:00
+	Schedule::TimePoint naiveNextMonday9( Schedule::TimePoint after )
+	{
+		auto candidate = std::chrono::floor<std::chrono::minutes>( after ) + 1min;
+		for( ;; candidate += 1min ) {
+			auto time = Schedule::Clock::to_time_t( candidate );
+			const std::tm* local = std::localtime( &time );
+			if( local->tm_wday == 1 && local->tm_hour == 9 && local->tm_min == 0 )
+				return candidate;
+		}
+	}
+
+	// Queries spread over two weeks, so the naive scan walks a week on average
+	std::vector<Schedule::TimePoint> queryTimes( )
+	{
+		std::vector<Schedule::TimePoint> times;
+		auto start = Schedule::Clock::now( );
+		for( int i = 0; i < QUERY_COUNT; ++i )
+			times.push_back( start + std::chrono::minutes( ( i * 7919 ) % ( 14 * 24 * 60 ) ) );
+		return times;
+	}
+
+	// Start count timers following schedules produced by expression( i )
+	template<typename Expression>
+	void startRecurring( TimerStore& store, TimerStore::TimePoint start, Expression expression, std::size_t& fired )
+	{
+		for( int i = 0; i < RECURRING_COUNT; ++i ) {
+			auto id = store.add( Item( "Timer " + std::to_string( i ), "Recurring", "", 0, expression( i ) ),
+				[&fired]( ) { ++fired; } );
+			store.start( id, start );
+		}
+	}
+
+	// Update TICK_COUNT times step apart and report time and allocations of the re-arming updates
+	void measureTicks( TimerStore& store, TimerStore::TimePoint start, std::chrono::seconds step,
+		const std::string& prefix, const std::size_t& fired )
+	{
+		AllocationScope scope;
+		auto elapsed = measureSeconds( [&store, start, step]( )
+			{
+				for( int tick = 1; tick <= TICK_COUNT; ++tick )
+					store.update( start + tick * step );
+			}, 1 );
+		report( prefix + " occurrences fired", static_cast< double >( fired ), "" );
+		report( prefix + " per update", elapsed * 1e3 / TICK_COUNT, "ms" );
+		report( prefix + " allocations", static_cast< double >( scope.getStats( ).allocations ), "" );
+	}
+
+	[[maybe_unused]] const bool scheduleBenchmarkRegistered = registerBenchmark( "timers/recurring", []( )
+		{
+			auto schedule = Schedule::parse( "mon 09:00" );
+			auto times = queryTimes( );
+
+			auto compiled = measureSeconds( [&schedule, &times]( )
+				{
+					for( auto time : times )
+						doNotOptimize( schedule->nextAfter( time ).time_since_epoch( ).count( ) );
+				} );
+			report( "mon 09:00 next occurrence, compiled", compiled * 1e6 / QUERY_COUNT, "us" );
+
+			auto naive = measureSeconds( [&times]( )
+				{
+					for( auto time : times )
+						doNotOptimize( naiveNextMonday9( time ).time_since_epoch( ).count( ) );
+				} );
+			report( "mon 09:00 next occurrence, minute scan", naive * 1e6 / QUERY_COUNT, "us" );
+
+			auto prefix = std::to_string( RECURRING_COUNT ) + " timers";
+			auto start = TimerStore::TimePoint( std::chrono::floor<std::chrono::minutes>( TimerStore::Clock::now( ) ) );
+
+			// Intervals of 1 to 10 seconds; about 3k re-arms per update
+			{
+				std::size_t fired = 0;
+				TimerStore store;
+				startRecurring( store, start, []( int i ) { return "every " + std::to_string( 1 + i % 10 ) + "s"; }, fired );
+				measureTicks( store, start, 1s, prefix + " every 1-10s", fired );
+			}
+
+			// Hourly calendar times spread over the hour; each minute re-arms a sixtieth of them
+			{
+				std::size_t fired = 0;
+				TimerStore store;
+				startRecurring( store, start, []( int i ) { return "*:" + std::string( i % 60 < 10 ? "0" : "" ) + std::to_string( i % 60 ); }, fired );
+				measureTicks( store, start, 60s, prefix + " hourly", fired );
+			}
+		} );
+}
@@ -0,0 +1,129 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module task_bench;
+
+import bench.harness;
+import model.item;
+import model.task;
+import model.timer_store;
+import <chrono>;
+import <cstddef>;
+import <vector>;
+
+namespace
+{
+	constexpr int WAIT_COUNT = 100'000;
+	constexpr int CHAIN_LENGTH = 8;
+
+	using namespace std::chrono_literals;
+	const TimerStore::TimePoint START = TimerStore::TimePoint( 1'000'000s );
+
+	Task awaitCompletion( TimerStore& store, TimerStore::TimerId id, std::size_t& resumed )
+	{
+		bool completed = co_await store.completion( id );
+		resumed += completed ? 1 : 0;
+	}
+
+	// One coroutine waiting for a run of timers in sequence
+	Task awaitChain( TimerStore& store, const std::vector<TimerStore::TimerId>& ids, std::size_t first, std::size_t& resumed )
+	{
+		for( std::size_t i = first; i < first + CHAIN_LENGTH; ++i ) {
+			store.start( ids[ i ], START );
+			bool completed = co_await store.completion( ids[ i ] );
+			resumed += completed ? 1 : 0;
+		}
+	}
+
+	[[maybe_unused]] const bool taskBenchmarkRegistered = registerBenchmark( "timers/await", []( )
+		{
+			const Item item( "Build Project", "Development", "make", 60 );
+			auto prefix = std::to_string( WAIT_COUNT ) + " waits ";
+
+			// Callback path: one callback per timer, invoked from update
+			{
+				std::size_t resumed = 0;
+				TimerStore store;
+				AllocationScope setupScope;
+				for( int i = 0; i < WAIT_COUNT; ++i )
+					store.start( store.add( item, [&resumed]( ) { ++resumed; } ), START );
+				auto setup = setupScope.getStats( );
+
+				AllocationScope completeScope;
+				auto begin = std::chrono::steady_clock::now( );
+				store.update( START + 60s );
+				std::chrono::duration<double> elapsed = std::chrono::steady_clock::now( ) - begin;
+
+				report( prefix + "callback setup allocations", static_cast< double >( setup.allocations ), "" );
+				report( prefix + "callback completion allocations", static_cast< double >( completeScope.getStats( ).allocations ), "" );
+				report( prefix + "callback completion", elapsed.count( ) * 1e3, "ms" );
+				doNotOptimize( resumed );
+			}
+
+			// Coroutine path: one suspended task per timer, resumed from update
+			{
+				std::size_t resumed = 0;
+				TimerStore store;
+				std::vector<TimerStore::TimerId> ids;
+				ids.reserve( WAIT_COUNT );
+				for( int i = 0; i < WAIT_COUNT; ++i ) {
+					ids.push_back( store.add( item ) );
+					store.start( ids.back( ), START );
+				}
+
+				std::vector<Task> tasks;
+				tasks.reserve( WAIT_COUNT );
+				AllocationScope setupScope;
+				for( auto id : ids )
+					tasks.push_back( awaitCompletion( store, id, resumed ) );
+				auto setup = setupScope.getStats( );
+
+				AllocationScope completeScope;
+				auto begin = std::chrono::steady_clock::now( );
+				store.update( START + 60s );
+				std::chrono::duration<double> elapsed = std::chrono::steady_clock::now( ) - begin;
+
+				report( prefix + "coroutine setup allocations", static_cast< double >( setup.allocations ), "" );
+				report( prefix + "coroutine completion allocations", static_cast< double >( completeScope.getStats( ).allocations ), "" );
+				report( prefix + "coroutine completion", elapsed.count( ) * 1e3, "ms" );
+				doNotOptimize( resumed );
+			}
+
+			// Sequential waits inside one coroutine share its single frame
+			{
+				std::size_t resumed = 0;
+				TimerStore store;
+				std::vector<TimerStore::TimerId> ids;
+				ids.reserve( WAIT_COUNT );
+				for( int i = 0; i < WAIT_COUNT; ++i )
+					ids.push_back( store.add( item ) );
+
+				AllocationScope scope;
+				std::vector<Task> tasks;
+				tasks.reserve( WAIT_COUNT / CHAIN_LENGTH );
+				for( std::size_t first = 0; first < ids.size( ); first += CHAIN_LENGTH )
+					tasks.push_back( awaitChain( store, ids, first, resumed ) );
+				for( int step = 1; step <= CHAIN_LENGTH; ++step )
+					store.update( START + step * 60s );
+
+				report( prefix + "in chains of " + std::to_string( CHAIN_LENGTH ) + ", allocations per wait",
+					static_cast< double >( scope.getStats( ).allocations ) / static_cast< double >( resumed ), "" );
+				doNotOptimize( resumed );
+			}
+		} );
+}
@@ -0,0 +1,181 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module timer_store_bench;
+
+import bench.harness;
+import model.active_item;
+import model.completion_archive;
+import model.item;
+import model.timer_store;
+import <chrono>;
+import <string>;
+import <vector>;
+
+namespace
+{
+	constexpr int TIMER_COUNT = 100'000;
+	constexpr int CATALOG_SIZE = 50;
+	constexpr int TYPE_COUNT = 50;
+
+	std::vector<Item> createCatalog( )
+	{
+		std::vector<Item> catalog;
+		for( int i = 0; i < CATALOG_SIZE; ++i ) {
+			catalog.emplace_back(
+				"Catalog item with a descriptive name " + std::to_string( i ),
+				"Maintenance",
+				"run-maintenance-task --id " + std::to_string( i ),
+				3600 + i );
+		}
+		return catalog;
+	}
+
+	[[maybe_unused]] const bool timerStoreBenchmarkRegistered = registerBenchmark( "timers/store", []( )
+		{
+			auto catalog = createCatalog( );
+			auto onComplete = []( ) { doNotOptimize( 1 ); };
+
+			// Memory per timer
+			{
+				AllocationScope scope;
+				std::vector<ActiveItem> activeItems;
+				for( int i = 0; i < TIMER_COUNT; ++i )
+					activeItems.emplace_back( catalog[ i % CATALOG_SIZE ], onComplete );
+				report( "vector<ActiveItem> heap per timer", static_cast< double >( scope.getStats( ).peakBytes ) / TIMER_COUNT, "bytes" );
+				report( "vector<ActiveItem> allocations per timer", static_cast< double >( scope.getStats( ).allocations ) / TIMER_COUNT, "" );
+			}
+			{
+				AllocationScope scope;
+				TimerStore store;
+				for( int i = 0; i < TIMER_COUNT; ++i )
+					store.add( catalog[ i % CATALOG_SIZE ], onComplete );
+				report( "TimerStore heap per timer", static_cast< double >( scope.getStats( ).peakBytes ) / TIMER_COUNT, "bytes" );
+				report( "TimerStore allocations per timer", static_cast< double >( scope.getStats( ).allocations ) / TIMER_COUNT, "" );
+				report( "TimerStore reserved per timer", static_cast< double >( store.memoryUsage( ) ) / TIMER_COUNT, "bytes" );
+				report( "TimerStore array bytes per timer", static_cast< double >( TimerStore::bytesPerTimer( ) ), "bytes" );
+			}
+
+			// Per-tick expiry scan with nothing due
+			std::vector<ActiveItem> activeItems;
+			TimerStore store;
+			for( int i = 0; i < TIMER_COUNT; ++i ) {
+				activeItems.emplace_back( catalog[ i % CATALOG_SIZE ], onComplete );
+				activeItems.back( ).start( );
+				store.start( store.add( catalog[ i % CATALOG_SIZE ], onComplete ) );
+			}
+
+			constexpr int TICKS = 20;
+			auto activeItemScan = measureSeconds( [&activeItems]( )
+				{
+					for( int tick = 0; tick < TICKS; ++tick ) {
+						for( auto& activeItem : activeItems )
+							activeItem.update( );
+					}
+				} );
+			auto now = TimerStore::Clock::now( );
+			auto storeScan = measureSeconds( [&store, now]( )
+				{
+					for( int tick = 0; tick < TICKS; ++tick )
+						doNotOptimize( store.update( now ) );
+				} );
+			report( "vector<ActiveItem> update per tick", activeItemScan / TICKS * 1e6, "us" );
+			report( "TimerStore update per tick", storeScan / TICKS * 1e6, "us" );
+		} );
+
+	[[maybe_unused]] const bool timerBulkBenchmarkRegistered = registerBenchmark( "timers/bulk", []( )
+		{
+			// Every tenth timer runs, spread over TYPE_COUNT types
+			using namespace std::chrono_literals;
+			const TimerStore::TimePoint start( 1'000'000s );
+			TimerStore store;
+			std::vector<TimerStore::TimerId> ids;
+			for( int i = 0; i < TIMER_COUNT; ++i ) {
+				ids.push_back( store.add( Item( "Timer " + std::to_string( i % CATALOG_SIZE ),
+					"Type " + std::to_string( i % TYPE_COUNT ), "", 3600 ) ) );
+				if( i % 10 == 0 )
+					store.start( ids.back( ), start );
+			}
+
+			auto selector = TimerSelector( ).withType( "Type 0" ).withState( TimerState::Running );
+			auto indexed = measureSeconds( [&store, &selector]( )
+				{
+					doNotOptimize( store.select( selector ).size( ) );
+				} );
+			report( "select type and state, indexed", indexed * 1e6, "us" );
+
+			auto scanned = measureSeconds( [&store, &ids, &selector]( )
+				{
+					std::vector<TimerStore::TimerId> selected;
+					for( auto id : ids ) {
+						if( selector.matches( store.getItem( id ), store.getState( id ) ) )
+							selected.push_back( id );
+					}
+					doNotOptimize( selected.size( ) );
+				} );
+			report( "select type and state, full scan", scanned * 1e6, "us" );
+			report( "timers selected", static_cast< double >( store.select( selector ).size( ) ), "" );
+
+			auto stopped = measureSeconds( [&store, &selector, start]( )
+				{
+					doNotOptimize( store.stopAll( selector, start + 1s ) );
+					doNotOptimize( store.startAll( TimerSelector( ).withType( "Type 0" ).withState( TimerState::Stopped ), start + 1s ) );
+				}, 1 );
+			report( "stop then start one type", stopped * 1e6, "us" );
+		} );
+
+	[[maybe_unused]] const bool timerRetentionBenchmarkRegistered = registerBenchmark( "timers/retention", []( )
+		{
+			// Weeks of uptime compressed: batches of short timers complete and are evicted
+			constexpr int BATCH_SIZE = 1'000;
+			constexpr int BATCH_COUNT = 1'000;
+			using namespace std::chrono_literals;
+
+			auto catalog = createCatalog( );
+			RetentionPolicy policy;
+			CompletionArchive archive( policy.archiveSize );
+			TimerStore store;
+			auto now = TimerStore::TimePoint( 1'000'000s );
+			double evictSeconds = 0.0;
+
+			AllocationScope scope;
+			for( int batch = 1; batch <= BATCH_COUNT; ++batch ) {
+				for( int i = 0; i < BATCH_SIZE; ++i )
+					store.start( store.add( catalog[ i % CATALOG_SIZE ].withTimeout( 1 ) ), now );
+				now += 1s;
+				store.update( now );
+
+				evictSeconds += measureSeconds( [&store, &policy, &archive, now]( )
+					{
+						store.evictCompleted( policy, now, [&archive]( const TimerStore::Eviction& eviction )
+							{
+								archive.add( eviction.item, eviction.startedAt, eviction.completedAt );
+							} );
+					}, 1 );
+
+				if( batch == 10 || batch == 100 || batch == BATCH_COUNT )
+					report( "store bytes after " + std::to_string( batch * BATCH_SIZE ) + " completions",
+						static_cast< double >( store.memoryUsage( ) ) / 1024.0, "KiB" );
+			}
+
+			report( "timers kept", static_cast< double >( store.size( ) ), "" );
+			report( "archived records kept", static_cast< double >( archive.size( ) ), "" );
+			report( "eviction per completed timer", evictSeconds * 1e9 / ( BATCH_SIZE * BATCH_COUNT ), "ns" );
+			report( "peak heap", static_cast< double >( scope.getStats( ).peakBytes ) / 1024.0, "KiB" );
+		} );
+}
@@ -17,6 +17,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 import controller.application;
+import model.shared_timer_table;
 
 #include <wx/wx.h>
 #include <wx/stdpaths.h>
@@ -63,6 +64,16 @@ bool Application::initialize( int& argc, char** argv )
 	// Show the frame
 	mainFrame_->getFrame( )->Show( true );
 
+	// Optionally share active timers with other instances on this host
+	if( hasOption( argc, argv, "--shared-table" ) ) {
+		auto sharedTable = SharedTimerTable::open( );
+		if( sharedTable )
+			mainFrame_->setSharedTable( std::move( sharedTable ) );
+		else
+			wxMessageBox( "Failed to open the shared timer table. Timers stay private to this instance.",
+				"Shared Timers", wxOK | wxICON_WARNING );
+	}
+
 	// Load configuration
 	std::filesystem::path configPath = "config/default_config.yaml";
 	auto config = loadConfiguration( configPath );
@@ -72,7 +83,7 @@ bool Application::initialize( int& argc, char** argv )
 	else
 	{
 		// Create an empty configuration
-		mainFrame_->initialize( Config( ) );
+		mainFrame_->initialize( LoadedConfig( ) );
 
 		// Show error message
 		wxMessageBox( "Failed to load configuration. Using empty configuration.",
@@ -87,10 +98,18 @@ int Application::run( )
 	return app_->OnRun( );
 }
 
-std::optional<Config> Application::loadConfiguration( const std::filesystem::path& path )
+bool Application::hasOption( int argc, char** argv, std::string_view option )
+{
+	for( int i = 1; i < argc; ++i )
+		if( argv[ i ] == option )
+			return true;
+	return false;
+}
+
+std::optional<LoadedConfig> Application::loadConfiguration( const std::filesystem::path& path )
 {
 	// Try to load from the specified path
-	auto config = Config::loadFromYaml( path );
+	auto config = mainFrame_->loadConfig( path );
 	if( config ) {
 		return config;
 	}
@@ -100,5 +119,5 @@ std::optional<Config> Application::loadConfiguration( const std::filesystem::pat
 	auto exeDir = std::filesystem::path( exePath.ToStdString( ) ).parent_path( );
 	auto defaultPath = exeDir / "config" / "default_config.yaml";
 
-	return Config::loadFromYaml( defaultPath );
+	return mainFrame_->loadConfig( defaultPath );
 }
@@ -20,10 +20,12 @@ export module controller.application;
 
 import view.main_frame;
 import model.config;
+import model.config_loader;
 
 import <memory>;
 import <optional>;
 import <filesystem>;
+import <string_view>;
 
 import <wx/app.h>;
 
@@ -48,7 +50,10 @@ public:
 
 private:
 	// Load configuration
-	std::optional<Config> loadConfiguration( const std::filesystem::path& path );
+	std::optional<LoadedConfig> loadConfiguration( const std::filesystem::path& path );
+
+	// Check whether a command line option was given
+	static bool hasOption( int argc, char** argv, std::string_view option );
 
 	// wxApp instance
 	wxApp* app_ = nullptr;
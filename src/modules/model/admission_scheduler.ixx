@@ -0,0 +1,322 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.admission_scheduler;
+
+export import model.resource_class;
+import <algorithm>;
+import <cstdint>;
+import <functional>;
+import <optional>;
+import <queue>;
+import <set>;
+import <string>;
+import <unordered_map>;
+import <utility>;
+import <vector>;
+
+/**
+ * @brief Admits submitted runs within per-type concurrency budgets
+ *
+ * Runs beyond their class budget, or beyond the overall limit, wait in a
+ * queue ordered by class priority and then by submission order. Whenever
+ * slots free up, admit() hands out the runs that may start.
+ */
+export class AdmissionScheduler
+{
+public:
+	// Identifies a run, typically a TimerStore timer id
+	using Id = std::uint32_t;
+
+	// Remaining seconds of an admitted run
+	using RemainingSeconds = std::function<int( Id )>;
+
+	// Constructor
+	AdmissionScheduler( ) = default;
+
+	// Replace the resource classes and the overall limit (0 for unlimited)
+	void configure( const std::vector<ResourceClass>& resourceClasses, int maxConcurrent = 0 );
+
+	// Queue a run of the given type and duration; call admit() afterwards
+	void submit( Id id, const std::string& type, int durationSeconds );
+
+	// Drop a run, freeing its slot if it was admitted
+	void release( Id id );
+
+	// Admit queued runs in priority/FIFO order while budgets allow
+	[[nodiscard]] std::vector<Id> admit( );
+
+	// Check whether a run is known, admitted or still queued
+	[[nodiscard]] bool contains( Id id ) const noexcept;
+	[[nodiscard]] bool isAdmitted( Id id ) const;
+	[[nodiscard]] bool isQueued( Id id ) const;
+
+	// One-based position in the admission queue; linear in the queue length
+	[[nodiscard]] std::optional<std::size_t> getQueuePosition( Id id ) const;
+
+	// One-based positions of every queued run, in a single pass over the queue
+	[[nodiscard]] std::unordered_map<Id, std::size_t> getQueuePositions( ) const;
+
+	// Number of admitted runs of a type
+	[[nodiscard]] int getRunningCount( const std::string& type ) const;
+
+	// Number of queued runs
+	[[nodiscard]] std::size_t getQueuedCount( ) const noexcept;
+
+	// Estimate seconds until each queued run is admitted, assuming no further submissions
+	[[nodiscard]] std::unordered_map<Id, int> estimateWaits( const RemainingSeconds& remainingSeconds ) const;
+
+private:
+	struct ClassState
+	{
+		int concurrency = 0;
+		int priority = 0;
+		int running = 0;
+	};
+
+	struct Ticket
+	{
+		std::size_t classIndex = 0;
+		std::uint64_t sequence = 0;
+		int durationSeconds = 0;
+		bool admitted = false;
+	};
+
+	// Queue order: higher priority first, then submission order
+	struct QueueKey
+	{
+		int priority;
+		std::uint64_t sequence;
+		Id id;
+
+		bool operator<( const QueueKey& other ) const noexcept
+		{
+			if( priority != other.priority )
+				return priority > other.priority;
+			return sequence < other.sequence;
+		}
+	};
+
+	[[nodiscard]] std::size_t classIndexOf( const std::string& type );
+	[[nodiscard]] QueueKey queueKeyOf( Id id, const Ticket& ticket ) const;
+
+	[[nodiscard]] static bool hasSlot( const ClassState& state ) noexcept;
+	[[nodiscard]] bool hasOverallSlot( int running ) const noexcept;
+
+	std::vector<ClassState> classes_;
+	std::unordered_map<std::string, std::size_t> classIndices_;
+	std::unordered_map<Id, Ticket> tickets_;
+	std::set<QueueKey> queue_;
+	std::uint64_t nextSequence_ = 0;
+	int maxConcurrent_ = 0;
+	int running_ = 0;
+};
+
+// Implementation
+void AdmissionScheduler::configure( const std::vector<ResourceClass>& resourceClasses, int maxConcurrent )
+{
+	maxConcurrent_ = std::max( maxConcurrent, 0 );
+
+	// Types no longer configured fall back to the unlimited default
+	for( auto& state : classes_ ) {
+		state.concurrency = 0;
+		state.priority = 0;
+	}
+
+	for( const auto& resourceClass : resourceClasses ) {
+		auto& state = classes_[ classIndexOf( resourceClass.type ) ];
+		state.concurrency = std::max( resourceClass.concurrency, 0 );
+		state.priority = resourceClass.priority;
+	}
+
+	// Priorities may have changed, so rebuild the queue order
+	queue_.clear( );
+	for( const auto& [id, ticket] : tickets_ )
+		if( !ticket.admitted )
+			queue_.insert( queueKeyOf( id, ticket ) );
+}
+
+void AdmissionScheduler::submit( Id id, const std::string& type, int durationSeconds )
+{
+	release( id );
+
+	Ticket ticket;
+	ticket.classIndex = classIndexOf( type );
+	ticket.sequence = nextSequence_++;
+	ticket.durationSeconds = std::max( durationSeconds, 0 );
+	queue_.insert( queueKeyOf( id, ticket ) );
+	tickets_.emplace( id, ticket );
+}
+
+void AdmissionScheduler::release( Id id )
+{
+	auto found = tickets_.find( id );
+	if( found == tickets_.end( ) )
+		return;
+
+	const auto& ticket = found->second;
+	if( ticket.admitted ) {
+		--classes_[ ticket.classIndex ].running;
+		--running_;
+	}
+	else
+		queue_.erase( queueKeyOf( id, ticket ) );
+
+	tickets_.erase( found );
+}
+
+std::vector<AdmissionScheduler::Id> AdmissionScheduler::admit( )
+{
+	std::vector<Id> admitted;
+
+	// A blocked class does not hold back lower priority classes with free slots
+	for( auto it = queue_.begin( ); it != queue_.end( ) && hasOverallSlot( running_ ); ) {
+		auto& ticket = tickets_.at( it->id );
+		auto& state = classes_[ ticket.classIndex ];
+		if( !hasSlot( state ) ) {
+			++it;
+			continue;
+		}
+
+		ticket.admitted = true;
+		++state.running;
+		++running_;
+		admitted.push_back( it->id );
+		it = queue_.erase( it );
+	}
+
+	return admitted;
+}
+
+bool AdmissionScheduler::contains( Id id ) const noexcept
+{
+	return tickets_.contains( id );
+}
+
+bool AdmissionScheduler::isAdmitted( Id id ) const
+{
+	auto found = tickets_.find( id );
+	return found != tickets_.end( ) && found->second.admitted;
+}
+
+bool AdmissionScheduler::isQueued( Id id ) const
+{
+	auto found = tickets_.find( id );
+	return found != tickets_.end( ) && !found->second.admitted;
+}
+
+std::optional<std::size_t> AdmissionScheduler::getQueuePosition( Id id ) const
+{
+	auto found = tickets_.find( id );
+	if( found == tickets_.end( ) || found->second.admitted )
+		return std::nullopt;
+
+	auto position = queue_.find( queueKeyOf( id, found->second ) );
+	return static_cast< std::size_t >( std::distance( queue_.begin( ), position ) ) + 1;
+}
+
+std::unordered_map<AdmissionScheduler::Id, std::size_t> AdmissionScheduler::getQueuePositions( ) const
+{
+	std::unordered_map<Id, std::size_t> positions;
+	positions.reserve( queue_.size( ) );
+	std::size_t position = 0;
+	for( const auto& key : queue_ )
+		positions.emplace( key.id, ++position );
+	return positions;
+}
+
+int AdmissionScheduler::getRunningCount( const std::string& type ) const
+{
+	auto found = classIndices_.find( type );
+	return found != classIndices_.end( ) ? classes_[ found->second ].running : 0;
+}
+
+std::size_t AdmissionScheduler::getQueuedCount( ) const noexcept
+{
+	return queue_.size( );
+}
+
+std::unordered_map<AdmissionScheduler::Id, int> AdmissionScheduler::estimateWaits( const RemainingSeconds& remainingSeconds ) const
+{
+	std::unordered_map<Id, int> waits;
+	if( queue_.empty( ) )
+		return waits;
+
+	// Replay admissions on a copy of the budgets, advancing to each next finish
+	using Finish = std::pair<int, std::size_t>;
+	std::priority_queue<Finish, std::vector<Finish>, std::greater<>> finishes;
+	std::vector<ClassState> classes = classes_;
+	int running = running_;
+	for( const auto& [id, ticket] : tickets_ )
+		if( ticket.admitted )
+			finishes.emplace( std::max( remainingSeconds( id ), 0 ), ticket.classIndex );
+
+	std::vector<QueueKey> pending( queue_.begin( ), queue_.end( ) );
+	int now = 0;
+	while( !pending.empty( ) ) {
+		std::erase_if( pending, [&]( const QueueKey& key )
+			{
+				const auto& ticket = tickets_.at( key.id );
+				auto& state = classes[ ticket.classIndex ];
+				if( !hasOverallSlot( running ) || !hasSlot( state ) )
+					return false;
+
+				waits.emplace( key.id, now );
+				finishes.emplace( now + ticket.durationSeconds, ticket.classIndex );
+				++state.running;
+				++running;
+				return true;
+			} );
+
+		if( pending.empty( ) || finishes.empty( ) )
+			break;
+
+		// Free every slot finishing at the next point in time
+		now = std::max( now, finishes.top( ).first );
+		while( !finishes.empty( ) && finishes.top( ).first <= now ) {
+			--classes[ finishes.top( ).second ].running;
+			--running;
+			finishes.pop( );
+		}
+	}
+
+	return waits;
+}
+
+std::size_t AdmissionScheduler::classIndexOf( const std::string& type )
+{
+	auto [found, inserted] = classIndices_.try_emplace( type, classes_.size( ) );
+	if( inserted )
+		classes_.emplace_back( );
+	return found->second;
+}
+
+AdmissionScheduler::QueueKey AdmissionScheduler::queueKeyOf( Id id, const Ticket& ticket ) const
+{
+	return QueueKey{ classes_[ ticket.classIndex ].priority, ticket.sequence, id };
+}
+
+bool AdmissionScheduler::hasSlot( const ClassState& state ) noexcept
+{
+	return state.concurrency == 0 || state.running < state.concurrency;
+}
+
+bool AdmissionScheduler::hasOverallSlot( int running ) const noexcept
+{
+	return maxConcurrent_ == 0 || running < maxConcurrent_;
+}
@@ -0,0 +1,120 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.async_event;
+
+export import model.waiter_list;
+import <coroutine>;
+
+/**
+ * @brief Manual-reset event that coroutines can co_await
+ *
+ * Meant for completions the timer engine does not own, such as an action's
+ * process exiting: whoever observes the exit calls set. Waiters are resumed
+ * in the order they started waiting, on the thread calling set.
+ */
+export class AsyncEvent
+{
+public:
+	/**
+	 * @brief Suspends the awaiting coroutine until the event is set
+	 */
+	class Awaiter : public Waiter
+	{
+	public:
+		explicit Awaiter( AsyncEvent& event ) noexcept
+			: event_( event )
+		{
+		}
+
+		[[nodiscard]] bool await_ready( ) const noexcept
+		{
+			return event_.isSet( );
+		}
+
+		void await_suspend( std::coroutine_handle<> awaiting ) noexcept
+		{
+			handle = awaiting;
+			event_.waiters_.pushBack( *this );
+		}
+
+		// Returns false if the wait was cancelled instead of the event being set
+		[[nodiscard]] bool await_resume( ) const noexcept
+		{
+			return !cancelled;
+		}
+
+	private:
+		AsyncEvent& event_;
+	};
+
+	AsyncEvent( ) = default;
+	AsyncEvent( const AsyncEvent& ) = delete;
+	AsyncEvent& operator=( const AsyncEvent& ) = delete;
+
+	// Set the event and resume every waiter
+	void set( );
+
+	// Resume every waiter with a cancelled result, leaving the event unset
+	void cancel( );
+
+	// Clear the event so later awaits suspend again
+	void reset( ) noexcept;
+
+	// Check if the event is set
+	[[nodiscard]] bool isSet( ) const noexcept;
+
+	// Await the event
+	[[nodiscard]] Awaiter operator co_await( ) noexcept;
+
+private:
+	WaiterList waiters_;
+	bool set_ = false;
+};
+
+// Implementation
+void AsyncEvent::set( )
+{
+	// Only current waiters are resumed, even if one of them resets the event and waits again
+	set_ = true;
+	WaiterList ready;
+	ready.takeAll( waiters_, false );
+	ready.resumeAll( );
+}
+
+void AsyncEvent::cancel( )
+{
+	WaiterList cancelled;
+	cancelled.takeAll( waiters_, true );
+	cancelled.resumeAll( );
+}
+
+void AsyncEvent::reset( ) noexcept
+{
+	set_ = false;
+}
+
+bool AsyncEvent::isSet( ) const noexcept
+{
+	return set_;
+}
+
+AsyncEvent::Awaiter AsyncEvent::operator co_await( ) noexcept
+{
+	return Awaiter( *this );
+}
@@ -0,0 +1,161 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.completion_archive;
+
+import model.item;
+import model.run_history;
+import model.utf8;
+import <algorithm>;
+import <array>;
+import <chrono>;
+import <cstddef>;
+import <cstdint>;
+import <string_view>;
+import <vector>;
+
+/**
+ * @brief Compact record of a completed timer that left the active list
+ *
+ * The name is truncated into a fixed buffer at a character boundary, so
+ * records hold no heap memory.
+ * The key matches RunHistory::keyOf, linking a record to the run statistics.
+ */
+export struct ArchivedRun
+{
+	static constexpr std::size_t NAME_SIZE = 48;
+
+	std::array<char, NAME_SIZE> name{ };
+	std::uint8_t nameLength = 0;
+	std::uint64_t key = 0;
+	std::int64_t startedAt = 0;   // milliseconds since epoch
+	std::int64_t completedAt = 0; // milliseconds since epoch
+
+	// Get the possibly truncated item name
+	[[nodiscard]] std::string_view getName( ) const noexcept;
+};
+
+/**
+ * @brief Capped in-memory log of archived runs
+ *
+ * Records live in a ring allocated once for the capacity; when it is full
+ * the oldest record is overwritten, so memory stays flat however long the
+ * application runs.
+ */
+export class CompletionArchive
+{
+public:
+	using TimePoint = std::chrono::system_clock::time_point;
+
+	// Constructor
+	explicit CompletionArchive( std::size_t capacity = 1000 );
+
+	// Change the capacity, keeping the newest records that fit
+	void setCapacity( std::size_t capacity );
+
+	// Archive a completed run, dropping the oldest record when full
+	void add( const Item& item, TimePoint startedAt, TimePoint completedAt );
+
+	// Get a record, 0 being the oldest kept
+	[[nodiscard]] const ArchivedRun& operator[]( std::size_t index ) const noexcept;
+
+	// Get number of records kept
+	[[nodiscard]] std::size_t size( ) const noexcept;
+
+	// Get maximum number of records kept
+	[[nodiscard]] std::size_t capacity( ) const noexcept;
+
+	// Get number of runs ever archived, including dropped ones
+	[[nodiscard]] std::uint64_t getTotalCount( ) const noexcept;
+
+private:
+	std::vector<ArchivedRun> records_;
+	std::size_t capacity_;
+	std::size_t oldest_ = 0;
+	std::uint64_t totalCount_ = 0;
+};
+
+// Implementation
+std::string_view ArchivedRun::getName( ) const noexcept
+{
+	return std::string_view( name.data( ), nameLength );
+}
+
+CompletionArchive::CompletionArchive( std::size_t capacity )
+	: capacity_( capacity )
+{
+	records_.reserve( capacity_ );
+}
+
+void CompletionArchive::setCapacity( std::size_t capacity )
+{
+	// Unroll the ring, oldest first, then keep the newest that fit
+	std::rotate( records_.begin( ), records_.begin( ) + static_cast< std::ptrdiff_t >( oldest_ ), records_.end( ) );
+	oldest_ = 0;
+	if( records_.size( ) > capacity )
+		records_.erase( records_.begin( ), records_.end( ) - static_cast< std::ptrdiff_t >( capacity ) );
+
+	capacity_ = capacity;
+	records_.shrink_to_fit( );
+	records_.reserve( capacity_ );
+}
+
+void CompletionArchive::add( const Item& item, TimePoint startedAt, TimePoint completedAt )
+{
+	using std::chrono::duration_cast;
+	using std::chrono::milliseconds;
+
+	++totalCount_;
+	if( capacity_ == 0 )
+		return;
+
+	ArchivedRun run;
+	auto name = item.getName( ).substr( 0, utf8Prefix( item.getName( ), ArchivedRun::NAME_SIZE ) );
+	std::copy( name.begin( ), name.end( ), run.name.begin( ) );
+	run.nameLength = static_cast< std::uint8_t >( name.size( ) );
+	run.key = RunHistory::keyOf( item );
+	run.startedAt = duration_cast< milliseconds >( startedAt.time_since_epoch( ) ).count( );
+	run.completedAt = duration_cast< milliseconds >( completedAt.time_since_epoch( ) ).count( );
+
+	if( records_.size( ) < capacity_ ) {
+		records_.push_back( run );
+		return;
+	}
+	records_[ oldest_ ] = run;
+	oldest_ = ( oldest_ + 1 ) % capacity_;
+}
+
+const ArchivedRun& CompletionArchive::operator[]( std::size_t index ) const noexcept
+{
+	return records_[ ( oldest_ + index ) % records_.size( ) ];
+}
+
+std::size_t CompletionArchive::size( ) const noexcept
+{
+	return records_.size( );
+}
+
+std::size_t CompletionArchive::capacity( ) const noexcept
+{
+	return capacity_;
+}
+
+std::uint64_t CompletionArchive::getTotalCount( ) const noexcept
+{
+	return totalCount_;
+}
@@ -20,88 +20,594 @@
 //#include <yaml-cpp/yaml.h>
 
 import model.config;
+import model.config_source;
 import model.item;
+import model.item_schema;
+import model.resource_class;
+import model.retention_policy;
 
 #include <yaml-cpp/yaml.h>
+#include <yaml-cpp/eventhandler.h>
 //import <yaml-cpp/yaml.h>;
+#include <atomic>
+#include <fstream>
+#include <charconv>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
 
-// Custom namespace for YAML conversion
-namespace YAML
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
 {
-	template<>
-	struct convert<Item>
+	// Positions record present keys as bits of their schema index
+	static_assert( ItemSource::NAME == 1 << ItemSchema::indexOf( "name" ) );
+	static_assert( ItemSource::TYPE == 1 << ItemSchema::indexOf( "type" ) );
+	static_assert( ItemSource::ACTION == 1 << ItemSchema::indexOf( "action" ) );
+	static_assert( ItemSource::TIMEOUT == 1 << ItemSchema::indexOf( "timeout" ) );
+	static_assert( ItemSource::SCHEDULE == 1 << ItemSchema::indexOf( "schedule" ) );
+
+	// Buffer size used for streaming configuration files in and out
+	constexpr std::size_t STREAM_BUFFER_SIZE = 64 * 1024;
+
+	// Smallest first arena block; a loaded file is sized from its length instead
+	constexpr std::size_t MIN_ARENA_SIZE = 4 * 1024;
+
+	/**
+	 * @brief Builds Items and ResourceClasses directly from parser events without materializing a node tree
+	 *
+	 * Only the fields of the entry currently being parsed are held, so memory
+	 * overhead stays constant regardless of the number of items. Unknown keys
+	 * and non-map entries are skipped, matching the previous node-based loader;
+	 * when a source is given they are reported there along with item positions.
+	 */
+	class ConfigEventHandler : public YAML::EventHandler
 	{
-		static Node encode( const Item& item )
+	public:
+		ConfigEventHandler( std::pmr::vector<Item>& items, std::vector<ResourceClass>& resourceClasses, int& maxConcurrent,
+			std::vector<std::string>& includes, RetentionPolicy& retention, ConfigSource* source,
+			const std::filesystem::path& filePath )
+			: items_( items ),
+			resourceClasses_( resourceClasses ),
+			maxConcurrent_( maxConcurrent ),
+			includes_( includes ),
+			retention_( retention ),
+			source_( source ),
+			filePath_( filePath )
 		{
-			Node node;
-			node[ "name" ] = item.getName( );
-			node[ "type" ] = item.getType( );
-			node[ "action" ] = item.getAction( );
-			node[ "timeout" ] = item.getTimeout( );
-			return node;
 		}
 
-		static bool decode( const Node& node, Item& item )
+		void OnDocumentStart( const YAML::Mark& ) override
 		{
-			if( !node.IsMap( ) )
-				return false;
+		}
+
+		void OnDocumentEnd( ) override
+		{
+		}
+
+		void OnNull( const YAML::Mark& mark, YAML::anchor_t ) override
+		{
+			if( skipDepth_ > 0 )
+				return;
+
+			if( state_ == State::Items )
+				warn( mark, "empty item entry skipped" );
+			onValueEnd( );
+		}
+
+		void OnAlias( const YAML::Mark& mark, YAML::anchor_t ) override
+		{
+			// Aliases are not resolved - treat them like a missing value
+			if( skipDepth_ > 0 )
+				return;
+
+			if( state_ == State::Items )
+				warn( mark, "item entry is an alias, skipped" );
+			onValueEnd( );
+		}
+
+		void OnScalar( const YAML::Mark& mark, const std::string&, YAML::anchor_t, const std::string& value ) override
+		{
+			if( skipDepth_ > 0 )
+				return;
+
+			if( isMapState( ) && expectingKey_ ) {
+				if( state_ == State::Item && ItemSchema::indexOf( value ) == ItemSchema::FIELD_COUNT )
+					warn( mark, "unknown item key '" + value + "' ignored" );
+				key_ = value;
+				expectingKey_ = false;
+
+				// The first of repeated root keys wins, as with the node-based loader; an
+				// empty key matches no section, so the repeated value is skipped
+				if( state_ == State::Root && !rootKeys_.insert( value ).second ) {
+					warn( mark, "repeated key '" + value + "' ignored, the first one is used" );
+					key_.clear( );
+				}
+				return;
+			}
+
+			if( state_ == State::Items )
+				warn( mark, "item entry '" + value + "' is not a map, skipped" );
+
+			if( state_ == State::Item )
+				setField( mark, value );
+			else if( state_ == State::Resource )
+				setResourceField( mark, value );
+			else if( state_ == State::Retention )
+				setRetentionField( mark, value );
+			else if( state_ == State::Includes ) {
+				includes_.push_back( value );
+				return;
+			}
+			else if( state_ == State::Root && key_ == "max_concurrent" )
+				maxConcurrent_ = parseCount( mark, value );
+			else if( state_ == State::Root && key_ == "include" )
+				includes_.push_back( value );
+
+			onValueEnd( );
+		}
+
+		void OnSequenceStart( const YAML::Mark& mark, const std::string&, YAML::anchor_t, YAML::EmitterStyle::value ) override
+		{
+			if( skipDepth_ > 0 || state_ != State::Root || expectingKey_ ) {
+				if( skipDepth_ == 0 && state_ == State::Items )
+					warn( mark, "item entry is a sequence, skipped" );
+				++skipDepth_;
+				return;
+			}
+
+			if( key_ == "items" )
+				state_ = State::Items;
+			else if( key_ == "resources" )
+				state_ = State::Resources;
+			else if( key_ == "include" )
+				state_ = State::Includes;
+			else
+				++skipDepth_;
+		}
+
+		void OnSequenceEnd( ) override
+		{
+			if( skipDepth_ > 0 ) {
+				endSkippedContainer( );
+				return;
+			}
+
+			// The entry maps toggled the shared key flag; the next root scalar is a key
+			state_ = State::Root;
+			expectingKey_ = true;
+		}
+
+		void OnMapStart( const YAML::Mark& mark, const std::string&, YAML::anchor_t, YAML::EmitterStyle::value ) override
+		{
+			if( skipDepth_ > 0 ) {
+				++skipDepth_;
+				return;
+			}
+
+			switch( state_ ) {
+				case State::Document:
+					state_ = State::Root;
+					expectingKey_ = true;
+					break;
+				case State::Items:
+					state_ = State::Item;
+					expectingKey_ = true;
+					ItemSchema::reset( values_ );
+					itemMark_ = mark;
+					fields_ = 0;
+					break;
+				case State::Resources:
+					state_ = State::Resource;
+					expectingKey_ = true;
+					resourceClass_ = ResourceClass{ };
+					break;
+				case State::Root:
+					if( expectingKey_ || key_ != "retention" ) {
+						++skipDepth_;
+						break;
+					}
+					state_ = State::Retention;
+					expectingKey_ = true;
+					break;
+				default:
+					++skipDepth_;
+					break;
+			}
+		}
+
+		void OnMapEnd( ) override
+		{
+			if( skipDepth_ > 0 ) {
+				endSkippedContainer( );
+				return;
+			}
 
-			// Use default values if properties are missing
-			std::string name = node[ "name" ] ? node[ "name" ].as<std::string>( ) : "";
-			std::string type = node[ "type" ] ? node[ "type" ].as<std::string>( ) : "";
-			std::string action = node[ "action" ] ? node[ "action" ].as<std::string>( ) : "";
-			int timeout = node[ "timeout" ] ? node[ "timeout" ].as<int>( ) : 0;
+			if( state_ == State::Item ) {
+				// Text is copied into the storage of the items; the field buffers are reused
+				items_.push_back( ItemSchema::makeItem( values_, items_.get_allocator( ) ) );
+				if( source_ )
+					source_->items.push_back( { itemMark_.line + 1, itemMark_.column + 1, fields_ } );
+				state_ = State::Items;
+			}
+			else if( state_ == State::Resource ) {
+				resourceClasses_.push_back( std::move( resourceClass_ ) );
+				state_ = State::Resources;
+			}
+			else if( state_ == State::Retention ) {
+				state_ = State::Root;
+				expectingKey_ = true;
+			}
+			else if( state_ == State::Root )
+				state_ = State::Done;
+		}
+
+	private:
+		enum class State
+		{
+			Document,
+			Root,
+			Items,
+			Item,
+			Resources,
+			Resource,
+			Includes,
+			Retention,
+			Done
+		};
+
+		[[nodiscard]] bool isMapState( ) const noexcept
+		{
+			return state_ == State::Root || state_ == State::Item || state_ == State::Resource || state_ == State::Retention;
+		}
+
+		// A complete value (or key) was consumed at the current level
+		void onValueEnd( )
+		{
+			if( isMapState( ) )
+				expectingKey_ = !expectingKey_;
+		}
+
+		void endSkippedContainer( )
+		{
+			if( --skipDepth_ == 0 )
+				onValueEnd( );
+		}
+
+		// Record a skipped entry or key
+		void warn( const YAML::Mark& mark, std::string message )
+		{
+			if( source_ )
+				source_->warnings.push_back( { filePath_, std::move( message ), mark.line + 1, mark.column + 1 } );
+		}
 
-			item = Item( name, type, action, timeout );
-			return true;
+		void setField( const YAML::Mark& mark, const std::string& value )
+		{
+			// Unknown keys were reported when read
+			auto index = ItemSchema::indexOf( key_ );
+			if( index == ItemSchema::FIELD_COUNT )
+				return;
+
+			// Invalid values, such as malformed schedules, fail the load so running items never hold them
+			if( !ItemSchema::parseField( values_, index, value ) )
+				throw YAML::ParserException( mark, "invalid " + key_ + " '" + value + "'" );
+			fields_ |= static_cast< std::uint8_t >( 1 << index );
+		}
+
+		void setResourceField( const YAML::Mark& mark, const std::string& value )
+		{
+			if( key_ == "type" )
+				resourceClass_.type = value;
+			else if( key_ == "concurrency" )
+				resourceClass_.concurrency = parseCount( mark, value );
+			else if( key_ == "priority" )
+				resourceClass_.priority = parseInt( mark, value );
 		}
+
+		void setRetentionField( const YAML::Mark& mark, const std::string& value )
+		{
+			if( key_ == "keep_completed" )
+				retention_.keepCompleted = static_cast< std::size_t >( parseCount( mark, value ) );
+			else if( key_ == "max_age" )
+				retention_.maxAgeSeconds = parseCount( mark, value );
+			else if( key_ == "archive_size" )
+				retention_.archiveSize = static_cast< std::size_t >( parseCount( mark, value ) );
+		}
+
+		static int parseCount( const YAML::Mark& mark, const std::string& value )
+		{
+			int result = parseInt( mark, value );
+			if( result < 0 )
+				throw YAML::ParserException( mark, "expected a non-negative count, got '" + value + "'" );
+
+			return result;
+		}
+
+		static int parseInt( const YAML::Mark& mark, const std::string& value )
+		{
+			const char* first = value.data( );
+			const char* last = first + value.size( );
+			if( first != last && *first == '+' )
+				++first;
+
+			int result = 0;
+			auto [ptr, ec] = std::from_chars( first, last, result );
+			if( ec != std::errc( ) || ptr != last || first == last )
+				throw YAML::ParserException( mark, "expected an integer, got '" + value + "'" );
+
+			return result;
+		}
+
+		std::pmr::vector<Item>& items_;
+		std::vector<ResourceClass>& resourceClasses_;
+		int& maxConcurrent_;
+		std::vector<std::string>& includes_;
+		RetentionPolicy& retention_;
+		ConfigSource* source_;
+		const std::filesystem::path& filePath_;
+		State state_ = State::Document;
+		bool expectingKey_ = false;
+		int skipDepth_ = 0;
+		std::string key_;
+		std::unordered_set<std::string> rootKeys_;
+
+		// Fields of the item being parsed
+		ItemSchema::Values values_;
+		YAML::Mark itemMark_;
+		std::uint8_t fields_ = 0;
+
+		// Fields of the resource class being parsed
+		ResourceClass resourceClass_;
 	};
+
+	// Flush file contents to the storage device
+	bool syncFile( const std::filesystem::path& filePath )
+	{
+#ifdef _WIN32
+		int fd = ::_wopen( filePath.c_str( ), _O_WRONLY | _O_BINARY );
+		if( fd < 0 )
+			return false;
+		bool synced = ::_commit( fd ) == 0;
+		::_close( fd );
+#else
+		int fd = ::open( filePath.c_str( ), O_WRONLY | O_CLOEXEC );
+		if( fd < 0 )
+			return false;
+		bool synced = ::fsync( fd ) == 0;
+		::close( fd );
+#endif
+		return synced;
+	}
+
+	// Persist the rename itself; directories cannot be synced on Windows
+	void syncDirectory( const std::filesystem::path& dirPath )
+	{
+#ifndef _WIN32
+		int fd = ::open( dirPath.empty( ) ? "." : dirPath.c_str( ), O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+		if( fd >= 0 ) {
+			::fsync( fd );
+			::close( fd );
+		}
+#endif
+	}
+
+	// Sibling temporary path unique to this process and call, so concurrent
+	// writers of the same file never share one
+	std::filesystem::path uniqueTempPath( const std::filesystem::path& filePath )
+	{
+		static std::atomic<unsigned> counter{ 0 };
+#ifdef _WIN32
+		auto processId = ::_getpid( );
+#else
+		auto processId = ::getpid( );
+#endif
+		auto tempPath = filePath;
+		tempPath += "." + std::to_string( processId ) + "." + std::to_string( counter++ ) + ".tmp";
+		return tempPath;
+	}
+
+	// Stream through a sibling temporary file, sync it and rename it over the target,
+	// so readers see either the old or the new file but never a truncated one
+	template<typename Writer>
+	bool writeFileAtomically( const std::filesystem::path& filePath, Writer&& write )
+	{
+		auto tempPath = uniqueTempPath( filePath );
+
+		std::error_code ec;
+		{
+			std::vector<char> buffer( STREAM_BUFFER_SIZE );
+			std::ofstream fout;
+			fout.rdbuf( )->pubsetbuf( buffer.data( ), static_cast< std::streamsize >( buffer.size( ) ) );
+			fout.open( tempPath, std::ios::binary | std::ios::trunc );
+			if( !fout )
+				return false;
+
+			bool written = write( fout );
+			fout.close( );
+			if( !written || !fout ) {
+				std::filesystem::remove( tempPath, ec );
+				return false;
+			}
+		}
+
+		if( !syncFile( tempPath ) ) {
+			std::filesystem::remove( tempPath, ec );
+			return false;
+		}
+
+		std::filesystem::rename( tempPath, filePath, ec );
+		if( ec ) {
+			std::filesystem::remove( tempPath, ec );
+			return false;
+		}
+
+		syncDirectory( filePath.parent_path( ) );
+		return true;
+	}
+}
+
+Config::Storage::Storage( std::pmr::memory_resource* resource, std::size_t initialSize )
+	: items( resource ? resource : &arena.emplace( std::max( initialSize, MIN_ARENA_SIZE ) ) )
+{
+}
+
+Config::Config( std::span<const Item> items, std::pmr::memory_resource* resource )
+	: Config( items, { }, 0, resource )
+{
+}
+
+Config::Config( std::initializer_list<Item> items )
+	: Config( std::span<const Item>( items.begin( ), items.size( ) ) )
+{
+}
+
+Config::Config( std::span<const Item> items, std::vector<ResourceClass> resourceClasses, int maxConcurrent,
+	std::pmr::memory_resource* resource )
+	: resourceClasses_( std::move( resourceClasses ) ),
+	maxConcurrent_( maxConcurrent ),
+	resource_( resource )
+{
+	auto storage = makeStorage( items.size( ), textBytesOf( items ) );
+	storage->items.assign( items.begin( ), items.end( ) );
+	storage_ = std::move( storage );
+}
+
+std::shared_ptr<Config::Storage> Config::makeStorage( std::size_t count, std::size_t textBytes ) const
+{
+	auto storage = std::make_shared<Storage>( resource_, count * sizeof( Item ) + textBytes );
+	storage->items.reserve( count );
+	return storage;
 }
 
-Config::Config( std::vector<Item> items )
-	: items_( std::move( items ) )
+std::size_t Config::textBytesOf( std::span<const Item> items ) noexcept
 {
+	std::size_t bytes = 0;
+	for( const auto& item : items )
+		bytes += ItemSchema::textBytes( item );
+	return bytes;
 }
 
-std::optional<Config> Config::loadFromYaml( const std::filesystem::path& filePath ) {
+std::optional<Config> Config::loadFromYaml( const std::filesystem::path& filePath, std::pmr::memory_resource* resource,
+	ConfigSource* source ) {
+	auto fail = [source, &filePath]( std::string message, int line = 0, int column = 0 ) -> std::optional<Config>
+		{
+			if( source )
+				source->error = ConfigDiagnostic{ filePath, std::move( message ), line, column };
+			return std::nullopt;
+		};
+
 	try {
 		if( !std::filesystem::exists( filePath ) )
-			return std::nullopt;
+			return fail( "file not found" );
 
-		YAML::Node rootNode = YAML::LoadFile( filePath.string( ) );
-		if( !rootNode[ "items" ] || !rootNode[ "items" ].IsSequence( ) )
-			return Config( ); // Return empty config if no items section
+		std::vector<char> buffer( STREAM_BUFFER_SIZE );
+		std::ifstream fin;
+		fin.rdbuf( )->pubsetbuf( buffer.data( ), static_cast< std::streamsize >( buffer.size( ) ) );
+		fin.open( filePath, std::ios::binary );
+		if( !fin )
+			return fail( "cannot open file" );
 
-		std::vector<Item> items;
-		for( const auto& itemNode : rootNode[ "items" ] ) {
-			if( itemNode.IsMap( ) )
-				items.push_back( itemNode.as<Item>( ) );
-		}
+		// The file length bounds the text of the items, so the arena rarely needs a second block
+		std::error_code ec;
+		auto fileSize = std::filesystem::file_size( filePath, ec );
+		auto storage = std::make_shared<Storage>( resource, ec ? 0 : static_cast< std::size_t >( fileSize ) );
+
+		// Items are built straight from parser events; a missing or malformed
+		// items section yields an empty config
+		Config config;
+		config.resource_ = resource;
+		ConfigEventHandler handler( storage->items, config.resourceClasses_, config.maxConcurrent_, config.includes_,
+			config.retention_, source, filePath );
+		YAML::Parser parser( fin );
+		parser.HandleNextDocument( handler );
 
-		return Config( std::move( items ) );
+		config.storage_ = std::move( storage );
+		return config;
 	}
-	catch( const std::exception& )
+	catch( const YAML::Exception& e )
+	{
+		if( e.mark.is_null( ) )
+			return fail( e.msg );
+		return fail( e.msg, e.mark.line + 1, e.mark.column + 1 );
+	}
+	catch( const std::exception& e )
 	{
-		return std::nullopt;
+		return fail( e.what( ) );
 	}
 }
 
 bool Config::saveToYaml( const std::filesystem::path& filePath ) const {
 	try {
-		YAML::Node rootNode;
-		YAML::Node itemsNode;
+		return writeFileAtomically( filePath, [this]( std::ostream& out )
+			{
+				// Items are emitted one by one straight into the buffered file stream;
+				// the emitter takes std::string, so one scratch buffer is reused for all text
+				YAML::Emitter emitter( out );
+				std::string text;
+				auto scalar = [&text]( std::string_view value ) -> const std::string&
+					{
+						text.assign( value );
+						return text;
+					};
 
-		for( const auto& item : items_ )
-			itemsNode.push_back( item );
+				emitter << YAML::BeginMap << YAML::Key << "items" << YAML::Value << YAML::BeginSeq;
+				for( const auto& item : getItems( ) ) {
+					emitter << YAML::BeginMap;
+					ItemSchema::forEachField( [&emitter, &scalar, &item]( const auto& field )
+						{
+							auto value = ( item.*field.get )( );
+							if constexpr( std::is_same_v<decltype( value ), int> )
+								emitter << YAML::Key << field.key << YAML::Value << value;
+							else if( !value.empty( ) || !( field.flags & ItemSchema::OMIT_EMPTY ) )
+								emitter << YAML::Key << field.key << YAML::Value << scalar( value );
+						} );
+					emitter << YAML::EndMap;
+				}
+				emitter << YAML::EndSeq;
 
-		rootNode[ "items" ] = itemsNode;
+				// Admission settings are only written when configured
+				if( maxConcurrent_ != 0 )
+					emitter << YAML::Key << "max_concurrent" << YAML::Value << maxConcurrent_;
 
-		std::ofstream fout( filePath );
-		if( !fout )
-			return false;
+				if( !includes_.empty( ) ) {
+					emitter << YAML::Key << "include" << YAML::Value << YAML::BeginSeq;
+					for( const auto& include : includes_ )
+						emitter << include;
+					emitter << YAML::EndSeq;
+				}
 
-		fout << YAML::Dump( rootNode );
-		return true;
+				// Retention is only written when it differs from the defaults
+				if( retention_ != RetentionPolicy{ } ) {
+					emitter << YAML::Key << "retention" << YAML::Value << YAML::BeginMap
+						<< YAML::Key << "keep_completed" << YAML::Value << retention_.keepCompleted
+						<< YAML::Key << "max_age" << YAML::Value << retention_.maxAgeSeconds
+						<< YAML::Key << "archive_size" << YAML::Value << retention_.archiveSize
+						<< YAML::EndMap;
+				}
+
+				if( !resourceClasses_.empty( ) ) {
+					emitter << YAML::Key << "resources" << YAML::Value << YAML::BeginSeq;
+					for( const auto& resourceClass : resourceClasses_ ) {
+						emitter << YAML::BeginMap
+							<< YAML::Key << "type" << YAML::Value << resourceClass.type
+							<< YAML::Key << "concurrency" << YAML::Value << resourceClass.concurrency
+							<< YAML::Key << "priority" << YAML::Value << resourceClass.priority
+							<< YAML::EndMap;
+					}
+					emitter << YAML::EndSeq;
+				}
+
+				emitter << YAML::EndMap << YAML::Newline;
+				return emitter.good( );
+			} );
 	}
 	catch( const std::exception& )
 	{
@@ -109,35 +615,89 @@ bool Config::saveToYaml( const std::filesystem::path& filePath ) const {
 	}
 }
 
-const std::vector<Item>& Config::getItems( ) const noexcept
+std::span<const Item> Config::getItems( ) const noexcept
+{
+	if( !storage_ )
+		return { };
+	return storage_->items;
+}
+
+const std::vector<ResourceClass>& Config::getResourceClasses( ) const noexcept
+{
+	return resourceClasses_;
+}
+
+int Config::getMaxConcurrent( ) const noexcept
 {
-	return items_;
+	return maxConcurrent_;
+}
+
+const std::vector<std::string>& Config::getIncludes( ) const noexcept
+{
+	return includes_;
+}
+
+const RetentionPolicy& Config::getRetention( ) const noexcept
+{
+	return retention_;
 }
 
 Config Config::withAddedItem( Item item ) const
 {
-	auto newItems = items_;
-	newItems.push_back( std::move( item ) );
-	return Config( std::move( newItems ) );
+	auto items = getItems( );
+	auto storage = makeStorage( items.size( ) + 1, textBytesOf( items ) + textBytesOf( { &item, 1 } ) );
+	storage->items.assign( items.begin( ), items.end( ) );
+	storage->items.push_back( std::move( item ) );
+
+	Config result = *this;
+	result.storage_ = std::move( storage );
+	return result;
 }
 
 Config Config::withRemovedItem( const Item& item ) const
 {
-	auto newItems = items_;
-	newItems.erase(
-		std::remove_if( newItems.begin( ), newItems.end( ),
-		[&item]( const auto& existingItem ) { return existingItem == item; } ),
-		newItems.end( )
-	);
-	return Config( std::move( newItems ) );
+	auto items = getItems( );
+	auto storage = makeStorage( items.size( ), textBytesOf( items ) );
+	std::copy_if( items.begin( ), items.end( ), std::back_inserter( storage->items ),
+		[&item]( const auto& existingItem ) { return existingItem != item; } );
+
+	Config result = *this;
+	result.storage_ = std::move( storage );
+	return result;
 }
 
 Config Config::withUpdatedItem( const Item& oldItem, Item newItem ) const
 {
-	auto newItems = items_;
-	std::replace_if( newItems.begin( ), newItems.end( ),
-		[&oldItem]( const auto& existingItem ) { return existingItem == oldItem; },
-		std::move( newItem )
-	);
-	return Config( std::move( newItems ) );
+	auto items = getItems( );
+	auto storage = makeStorage( items.size( ), textBytesOf( items ) + textBytesOf( { &newItem, 1 } ) );
+	for( const auto& existingItem : items )
+		storage->items.push_back( existingItem == oldItem ? newItem : existingItem );
+
+	Config result = *this;
+	result.storage_ = std::move( storage );
+	return result;
+}
+
+Config Config::withItems( std::span<const Item> items ) const
+{
+	auto storage = makeStorage( items.size( ), textBytesOf( items ) );
+	storage->items.assign( items.begin( ), items.end( ) );
+
+	Config result = *this;
+	result.storage_ = std::move( storage );
+	return result;
+}
+
+Config Config::withIncludes( std::vector<std::string> includes ) const
+{
+	Config result = *this;
+	result.includes_ = std::move( includes );
+	return result;
+}
+
+Config Config::withRetention( const RetentionPolicy& retention ) const
+{
+	Config result = *this;
+	result.retention_ = retention;
+	return result;
 }
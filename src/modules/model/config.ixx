@@ -19,6 +19,9 @@
 export module model.config;
 
 import model.item;
+export import model.config_source;
+export import model.resource_class;
+export import model.retention_policy;
 import <string>;
 import <vector>;
 import <functional>;
@@ -26,6 +29,10 @@ import <optional>;
 import <filesystem>;
 import <algorithm>;
 import <fstream>;
+import <initializer_list>;
+import <memory>;
+import <memory_resource>;
+import <span>;
 
 // Forward declare YAML::Node for use with header-only yaml-cpp library
 namespace YAML
@@ -35,6 +42,11 @@ namespace YAML
 
 /**
  * @brief Configuration manager that handles loading and saving YAML configuration
+ *
+ * Items of one configuration version live in a shared, immutable storage.
+ * By default it is a monotonic arena, so a catalog is built with a few
+ * large allocations and released in one shot when the last copy of the
+ * version is dropped. Copies of a Config share the storage.
  */
 export class Config
 {
@@ -42,25 +54,70 @@ public:
 	// Default constructor
 	Config( ) = default;
 
-	// Constructor with items
-	explicit Config( std::vector<Item> items );
+	// Constructor with items; resource, if given, replaces the arena
+	explicit Config( std::span<const Item> items, std::pmr::memory_resource* resource = nullptr );
+	Config( std::initializer_list<Item> items );
+
+	// Constructor with items and admission settings
+	Config( std::span<const Item> items, std::vector<ResourceClass> resourceClasses, int maxConcurrent,
+		std::pmr::memory_resource* resource = nullptr );
 
-	// Load from YAML file
-	[[nodiscard]] static std::optional<Config> loadFromYaml( const std::filesystem::path& filePath );
+	// Load from YAML file; resource, if given, replaces the arena, and source,
+	// if given, receives item positions, skipped entries and the load error
+	[[nodiscard]] static std::optional<Config> loadFromYaml( const std::filesystem::path& filePath,
+		std::pmr::memory_resource* resource = nullptr, ConfigSource* source = nullptr );
 
 	// Save to YAML file
 	bool saveToYaml( const std::filesystem::path& filePath ) const;
 
 	// Get all items
-	[[nodiscard]] const std::vector<Item>& getItems( ) const noexcept;
+	[[nodiscard]] std::span<const Item> getItems( ) const noexcept;
+
+	// Get per-type concurrency budgets and priorities
+	[[nodiscard]] const std::vector<ResourceClass>& getResourceClasses( ) const noexcept;
+
+	// Get the overall limit of concurrently running items, 0 for unlimited
+	[[nodiscard]] int getMaxConcurrent( ) const noexcept;
+
+	// Get the fragment patterns listed under the root-level include key
+	[[nodiscard]] const std::vector<std::string>& getIncludes( ) const noexcept;
+
+	// Get how many completed timers stay in the active list before being archived
+	[[nodiscard]] const RetentionPolicy& getRetention( ) const noexcept;
 
 	// Functional add, remove, update operations (immutable)
 	[[nodiscard]] Config withAddedItem( Item item ) const;
 	[[nodiscard]] Config withRemovedItem( const Item& item ) const;
 	[[nodiscard]] Config withUpdatedItem( const Item& oldItem, Item newItem ) const;
+	[[nodiscard]] Config withItems( std::span<const Item> items ) const;
+	[[nodiscard]] Config withIncludes( std::vector<std::string> includes ) const;
+	[[nodiscard]] Config withRetention( const RetentionPolicy& retention ) const;
 
 private:
-	std::vector<Item> items_;
+	/**
+	 * @brief Items of one configuration version and the memory they live in
+	 */
+	struct Storage
+	{
+		// Use resource, or an arena of about initialSize bytes when it is null
+		Storage( std::pmr::memory_resource* resource, std::size_t initialSize );
+
+		std::optional<std::pmr::monotonic_buffer_resource> arena;
+		std::pmr::vector<Item> items;
+	};
+
+	// Create storage sized for count items holding about textBytes of text
+	[[nodiscard]] std::shared_ptr<Storage> makeStorage( std::size_t count, std::size_t textBytes ) const;
+
+	// Bytes of text held by items
+	[[nodiscard]] static std::size_t textBytesOf( std::span<const Item> items ) noexcept;
+
+	std::shared_ptr<const Storage> storage_;
+	std::vector<ResourceClass> resourceClasses_;
+	int maxConcurrent_ = 0;
+	std::vector<std::string> includes_;
+	RetentionPolicy retention_;
+	std::pmr::memory_resource* resource_ = nullptr;
 };
 
 // Implementation will be added separately since it depends on yaml-cpp
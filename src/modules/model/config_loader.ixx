@@ -0,0 +1,407 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.config_loader;
+
+import model.config;
+export import model.config_source;
+import model.config_validator;
+import model.item;
+import model.thread_pool;
+import <algorithm>;
+import <atomic>;
+import <cstdint>;
+import <filesystem>;
+import <future>;
+import <iterator>;
+import <memory>;
+import <memory_resource>;
+import <mutex>;
+import <optional>;
+import <string>;
+import <string_view>;
+import <system_error>;
+import <unordered_map>;
+import <unordered_set>;
+import <vector>;
+
+/**
+ * @brief A root configuration as written and as merged with its fragments
+ */
+export struct LoadedConfig
+{
+	// The root file's own items, includes and settings; what is saved back
+	Config root;
+
+	// Root and fragment items for the panels, with the root's settings and no includes
+	Config merged;
+
+	// Path of the root file, which its include patterns are relative to
+	std::filesystem::path rootPath;
+};
+
+/**
+ * @brief Loads a root configuration together with the fragments it includes
+ *
+ * The root file may list glob patterns under a top-level include key, relative
+ * to its directory. Fragments are parsed concurrently on the thread pool and
+ * merged in declared order: root items first, then each pattern's matches in
+ * path order. When names collide the first item wins and a diagnostic is
+ * recorded. Only the root's include key and admission settings are honored.
+ * Each file is validated (see ConfigValidator) and its problems are recorded
+ * with their line and column.
+ *
+ * Parsed fragments are cached by path, modification time and size, so a
+ * reload only parses files that changed. The merged view is flattened and
+ * lists no includes, while the root is kept as written so saving it leaves
+ * the fragments in their own files. Not safe for concurrent calls to load.
+ */
+export class ConfigLoader
+{
+public:
+	// Constructor - fragments are parsed on threadPool
+	explicit ConfigLoader( ThreadPool& threadPool );
+
+	// Load a root file and its fragments; nullopt if the root itself cannot be loaded
+	[[nodiscard]] std::optional<LoadedConfig> load( const std::filesystem::path& filePath );
+
+	// Get the problems found by the last load, or why it failed
+	[[nodiscard]] const std::vector<ConfigDiagnostic>& getDiagnostics( ) const noexcept;
+
+	// Get the number of files the last load had to parse
+	[[nodiscard]] std::size_t getParsedCount( ) const noexcept;
+
+	// Expand a pattern relative to baseDir into sorted file paths;
+	// * and ? match within one path component and ** spans directories
+	[[nodiscard]] static std::vector<std::filesystem::path> expandPattern( const std::filesystem::path& baseDir, std::string_view pattern );
+
+	// Match a single path component against a pattern of * and ?
+	[[nodiscard]] static bool matchesWildcard( std::string_view pattern, std::string_view name ) noexcept;
+
+	// Rewrite the relative include patterns of root, written for a file in fromDir,
+	// so they match the same files from a file in toDir
+	[[nodiscard]] static Config rebaseIncludes( const Config& root, const std::filesystem::path& fromDir,
+		const std::filesystem::path& toDir );
+
+private:
+	struct ParsedFile
+	{
+		std::optional<Config> config;
+		std::shared_ptr<const ConfigSource> source;
+	};
+
+	struct CachedFragment
+	{
+		std::filesystem::file_time_type modified;
+		std::uintmax_t size = 0;
+		Config config;
+		std::shared_ptr<const ConfigSource> source;
+	};
+
+	// Parse a file unless an unchanged copy is cached
+	[[nodiscard]] ParsedFile loadFragment( const std::filesystem::path& filePath );
+
+	// Record what the parser skipped in a file, then its validation problems,
+	// or its load error prefixed with failureContext
+	void report( const ParsedFile& file, const std::filesystem::path& filePath, std::string_view failureContext );
+
+	// Collect files under dir matching components from index on
+	static void expandComponents( const std::filesystem::path& dir, const std::vector<std::string>& components,
+		std::size_t index, std::vector<std::filesystem::path>& matches );
+
+	// Cache key of a file
+	[[nodiscard]] static std::string keyOf( const std::filesystem::path& filePath );
+
+	ThreadPool& threadPool_;
+	ConfigValidator validator_;
+
+	std::mutex cacheMutex_;
+	std::unordered_map<std::string, CachedFragment> cache_;
+
+	std::vector<ConfigDiagnostic> diagnostics_;
+	std::atomic<std::size_t> parsedCount_{ 0 };
+};
+
+// Implementation
+ConfigLoader::ConfigLoader( ThreadPool& threadPool )
+	: threadPool_( threadPool ),
+	validator_( threadPool )
+{
+}
+
+std::optional<LoadedConfig> ConfigLoader::load( const std::filesystem::path& filePath )
+{
+	diagnostics_.clear( );
+	parsedCount_ = 0;
+
+	auto parsedRoot = loadFragment( filePath );
+	report( parsedRoot, filePath, "configuration not loaded" );
+	auto& root = parsedRoot.config;
+	if( !root )
+		return std::nullopt;
+
+	// Resolve patterns in declared order; a file matched twice is read once
+	std::vector<std::filesystem::path> fragmentPaths;
+	std::unordered_set<std::string> usedKeys{ keyOf( filePath ) };
+	for( const auto& pattern : root->getIncludes( ) ) {
+		auto matches = expandPattern( filePath.parent_path( ), pattern );
+		if( matches.empty( ) )
+			diagnostics_.push_back( { filePath, "include '" + pattern + "' matched no files" } );
+
+		for( auto& match : matches )
+			if( usedKeys.insert( keyOf( match ) ).second )
+				fragmentPaths.push_back( std::move( match ) );
+	}
+
+	std::vector<std::future<ParsedFile>> pending;
+	pending.reserve( fragmentPaths.size( ) );
+	for( const auto& fragmentPath : fragmentPaths )
+		pending.push_back( threadPool_.submit( [this, fragmentPath]( ) { return loadFragment( fragmentPath ); } ) );
+
+	std::vector<ParsedFile> fragments;
+	fragments.reserve( pending.size( ) );
+	for( auto& future : pending )
+		fragments.push_back( future.get( ) );
+
+	// Merge in declared order; names point into the fragments kept alive above,
+	// and the merged items are staged in a scratch arena before the final copy
+	std::size_t itemCount = root->getItems( ).size( );
+	for( const auto& fragment : fragments )
+		itemCount += fragment.config ? fragment.config->getItems( ).size( ) : 0;
+
+	std::pmr::monotonic_buffer_resource scratch;
+	std::pmr::vector<Item> items( &scratch );
+	items.reserve( itemCount );
+	std::unordered_map<std::string_view, const std::filesystem::path*> owners;
+	owners.reserve( itemCount );
+	auto merge = [this, &items, &owners]( const Config& source, const std::filesystem::path& sourcePath )
+		{
+			for( const auto& item : source.getItems( ) ) {
+				// Duplicates within one file were reported by its validation
+				auto [owner, inserted] = owners.try_emplace( item.getName( ), &sourcePath );
+				if( inserted )
+					items.push_back( item );
+				else if( owner->second != &sourcePath )
+					diagnostics_.push_back( { sourcePath, "duplicate item '" + std::string( item.getName( ) ) +
+						"' ignored, first defined in " + owner->second->string( ) } );
+			}
+		};
+
+	merge( *root, filePath );
+	for( std::size_t i = 0; i < fragments.size( ); ++i ) {
+		report( fragments[ i ], fragmentPaths[ i ], "fragment skipped" );
+		const auto& fragment = fragments[ i ].config;
+		if( !fragment )
+			continue;
+		if( !fragment->getIncludes( ).empty( ) )
+			diagnostics_.push_back( { fragmentPaths[ i ], "include ignored, only the root file may include fragments" } );
+
+		merge( *fragment, fragmentPaths[ i ] );
+	}
+
+	// Drop fragments that are no longer included
+	{
+		std::lock_guard lock( cacheMutex_ );
+		std::erase_if( cache_, [&usedKeys]( const auto& entry ) { return !usedKeys.contains( entry.first ); } );
+	}
+
+	auto merged = root->withItems( items ).withIncludes( { } );
+	return LoadedConfig{ std::move( *root ), std::move( merged ), filePath };
+}
+
+const std::vector<ConfigDiagnostic>& ConfigLoader::getDiagnostics( ) const noexcept
+{
+	return diagnostics_;
+}
+
+std::size_t ConfigLoader::getParsedCount( ) const noexcept
+{
+	return parsedCount_.load( );
+}
+
+ConfigLoader::ParsedFile ConfigLoader::loadFragment( const std::filesystem::path& filePath )
+{
+	auto unreadable = [&filePath]( const std::error_code& ec )
+		{
+			auto source = std::make_shared<ConfigSource>( );
+			source->error = ConfigDiagnostic{ filePath, ec.message( ) };
+			return ParsedFile{ std::nullopt, std::move( source ) };
+		};
+
+	std::error_code ec;
+	auto modified = std::filesystem::last_write_time( filePath, ec );
+	if( ec )
+		return unreadable( ec );
+	auto size = std::filesystem::file_size( filePath, ec );
+	if( ec )
+		return unreadable( ec );
+
+	auto key = keyOf( filePath );
+	{
+		std::lock_guard lock( cacheMutex_ );
+		auto cached = cache_.find( key );
+		if( cached != cache_.end( ) && cached->second.modified == modified && cached->second.size == size )
+			return { cached->second.config, cached->second.source };
+	}
+
+	// Stamped with the state seen before parsing, so a concurrent edit is picked up next time
+	auto source = std::make_shared<ConfigSource>( );
+	auto config = Config::loadFromYaml( filePath, nullptr, source.get( ) );
+	++parsedCount_;
+	if( config ) {
+		std::lock_guard lock( cacheMutex_ );
+		cache_.insert_or_assign( std::move( key ), CachedFragment{ modified, size, *config, source } );
+	}
+	return { std::move( config ), std::move( source ) };
+}
+
+void ConfigLoader::report( const ParsedFile& file, const std::filesystem::path& filePath, std::string_view failureContext )
+{
+	const auto& source = *file.source;
+	diagnostics_.insert( diagnostics_.end( ), source.warnings.begin( ), source.warnings.end( ) );
+
+	if( !file.config ) {
+		auto error = source.error.value_or( ConfigDiagnostic{ filePath, "unknown error" } );
+		error.message.insert( 0, std::string( failureContext ) + ": " );
+		diagnostics_.push_back( std::move( error ) );
+		return;
+	}
+
+	auto problems = validator_.validate( file.config->getItems( ), source.items, filePath );
+	diagnostics_.insert( diagnostics_.end( ), std::make_move_iterator( problems.begin( ) ),
+		std::make_move_iterator( problems.end( ) ) );
+}
+
+std::vector<std::filesystem::path> ConfigLoader::expandPattern( const std::filesystem::path& baseDir, std::string_view pattern )
+{
+	std::filesystem::path patternPath( pattern );
+	auto dir = patternPath.is_absolute( ) ? patternPath.root_path( ) : baseDir;
+
+	std::vector<std::string> components;
+	for( const auto& component : patternPath.relative_path( ) )
+		components.push_back( component.string( ) );
+
+	std::vector<std::filesystem::path> matches;
+	if( !components.empty( ) )
+		expandComponents( dir, components, 0, matches );
+
+	std::sort( matches.begin( ), matches.end( ) );
+	matches.erase( std::unique( matches.begin( ), matches.end( ) ), matches.end( ) );
+	return matches;
+}
+
+void ConfigLoader::expandComponents( const std::filesystem::path& dir, const std::vector<std::string>& components,
+	std::size_t index, std::vector<std::filesystem::path>& matches )
+{
+	std::error_code ec;
+	if( index == components.size( ) ) {
+		if( std::filesystem::is_regular_file( dir, ec ) )
+			matches.push_back( dir );
+		return;
+	}
+
+	const auto& component = components[ index ];
+	if( component == "**" ) {
+		// Zero directories, or one more level with the same component
+		expandComponents( dir, components, index + 1, matches );
+		for( std::filesystem::directory_iterator it( dir, ec ), end; !ec && it != end; it.increment( ec ) )
+			if( it->is_directory( ec ) && !it->is_symlink( ec ) )
+				expandComponents( it->path( ), components, index, matches );
+		return;
+	}
+
+	if( component.find_first_of( "*?" ) == std::string::npos ) {
+		auto next = dir / component;
+		if( std::filesystem::exists( next, ec ) )
+			expandComponents( next, components, index + 1, matches );
+		return;
+	}
+
+	for( std::filesystem::directory_iterator it( dir, ec ), end; !ec && it != end; it.increment( ec ) )
+		if( matchesWildcard( component, it->path( ).filename( ).string( ) ) )
+			expandComponents( it->path( ), components, index + 1, matches );
+}
+
+bool ConfigLoader::matchesWildcard( std::string_view pattern, std::string_view name ) noexcept
+{
+	// Greedy match that backtracks to the last star on a mismatch
+	std::size_t p = 0;
+	std::size_t n = 0;
+	std::size_t star = std::string_view::npos;
+	std::size_t starMatch = 0;
+	while( n < name.size( ) ) {
+		if( p < pattern.size( ) && ( pattern[ p ] == '?' || pattern[ p ] == name[ n ] ) ) {
+			++p;
+			++n;
+		}
+		else if( p < pattern.size( ) && pattern[ p ] == '*' ) {
+			star = p++;
+			starMatch = n;
+		}
+		else if( star != std::string_view::npos ) {
+			p = star + 1;
+			n = ++starMatch;
+		}
+		else
+			return false;
+	}
+
+	while( p < pattern.size( ) && pattern[ p ] == '*' )
+		++p;
+	return p == pattern.size( );
+}
+
+Config ConfigLoader::rebaseIncludes( const Config& root, const std::filesystem::path& fromDir,
+	const std::filesystem::path& toDir )
+{
+	auto absoluteDir = []( const std::filesystem::path& dir )
+		{
+			std::error_code ec;
+			auto absolutePath = std::filesystem::absolute( dir, ec );
+			return ( ec ? dir : absolutePath ).lexically_normal( );
+		};
+
+	auto from = absoluteDir( fromDir );
+	auto to = absoluteDir( toDir );
+	if( from == to )
+		return root;
+
+	// Wildcards are plain components to the lexical operations, so a pattern rebases like a path
+	std::vector<std::string> includes;
+	includes.reserve( root.getIncludes( ).size( ) );
+	for( const auto& pattern : root.getIncludes( ) ) {
+		std::filesystem::path patternPath( pattern );
+		if( patternPath.is_absolute( ) ) {
+			includes.push_back( pattern );
+			continue;
+		}
+
+		// Directories on another root name have no relative path between them
+		auto target = ( from / patternPath ).lexically_normal( );
+		auto relative = target.lexically_relative( to );
+		includes.push_back( ( relative.empty( ) ? target : relative ).generic_string( ) );
+	}
+	return root.withIncludes( std::move( includes ) );
+}
+
+std::string ConfigLoader::keyOf( const std::filesystem::path& filePath )
+{
+	std::error_code ec;
+	auto absolutePath = std::filesystem::absolute( filePath, ec );
+	return ( ec ? filePath : absolutePath ).lexically_normal( ).string( );
+}
@@ -0,0 +1,87 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.config_source;
+
+import <cstdint>;
+import <filesystem>;
+import <optional>;
+import <string>;
+import <vector>;
+
+/**
+ * @brief Problem found in a configuration file, positioned when it points at an entry
+ */
+export struct ConfigDiagnostic
+{
+	std::filesystem::path filePath;
+	std::string message;
+
+	// Position in the file, 1-based; 0 when the problem is not tied to one
+	int line = 0;
+	int column = 0;
+};
+
+/**
+ * @brief Where a loaded item was read from and which of its keys were present
+ */
+export struct ItemSource
+{
+	// Keys of an item entry
+	enum Field : std::uint8_t
+	{
+		NAME = 1 << 0,
+		TYPE = 1 << 1,
+		ACTION = 1 << 2,
+		TIMEOUT = 1 << 3,
+		SCHEDULE = 1 << 4
+	};
+
+	// Position of the entry, 1-based
+	int line = 0;
+	int column = 0;
+
+	// Field bits of the keys given a value
+	std::uint8_t fields = 0;
+
+	// Check whether the entry gave field a value
+	[[nodiscard]] bool has( Field field ) const noexcept;
+};
+
+/**
+ * @brief Details of one configuration file gathered while it is parsed
+ *
+ * Filled on request by Config::loadFromYaml for diagnostics and validation.
+ */
+export struct ConfigSource
+{
+	// One entry per loaded item, in item order
+	std::vector<ItemSource> items;
+
+	// Entries and keys the parser skipped
+	std::vector<ConfigDiagnostic> warnings;
+
+	// Why the file could not be loaded
+	std::optional<ConfigDiagnostic> error;
+};
+
+// Implementation
+bool ItemSource::has( Field field ) const noexcept
+{
+	return ( fields & field ) != 0;
+}
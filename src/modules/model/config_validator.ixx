@@ -0,0 +1,233 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.config_validator;
+
+import model.item;
+export import model.config_source;
+import model.thread_pool;
+import <algorithm>;
+import <array>;
+import <cstddef>;
+import <filesystem>;
+import <functional>;
+import <future>;
+import <iterator>;
+import <mutex>;
+import <span>;
+import <string>;
+import <string_view>;
+import <unordered_map>;
+import <vector>;
+
+/**
+ * @brief Checks loaded items for missing keys, out-of-range values and duplicate names
+ *
+ * Large catalogs are split into chunks checked on the thread pool. Names are
+ * first collected into a sharded concurrent index of first occurrences, then
+ * every chunk checks its items against it, so the problems come back in item
+ * order whatever the scheduling. A duplicate is reported against the entry
+ * that repeats the name, pointing at the first one.
+ */
+export class ConfigValidator
+{
+public:
+	// Timeouts accepted for items without a schedule, matching the item dialog
+	static constexpr int MIN_TIMEOUT = 1;
+	static constexpr int MAX_TIMEOUT = 86400;
+
+	// Constructor - large catalogs are checked on threadPool
+	explicit ConfigValidator( ThreadPool& threadPool );
+
+	// Check items loaded from filePath; sources, if not empty, holds one position per item.
+	// Waits for the pool, so it must not be called from one of its tasks
+	[[nodiscard]] std::vector<ConfigDiagnostic> validate( std::span<const Item> items, std::span<const ItemSource> sources,
+		const std::filesystem::path& filePath ) const;
+
+private:
+	// Items checked by one task; smaller catalogs are checked on the calling thread
+	static constexpr std::size_t MIN_CHUNK_SIZE = 4096;
+
+	ThreadPool& threadPool_;
+};
+
+// Implementation
+namespace
+{
+	/**
+	 * @brief Concurrent map from an item name to the index of its first occurrence
+	 *
+	 * Names are spread by hash over mutex-guarded shards, so threads inserting
+	 * different names rarely contend. Lookups are valid once all inserts are done.
+	 */
+	class FirstOccurrenceIndex
+	{
+	public:
+		explicit FirstOccurrenceIndex( std::size_t expectedCount )
+		{
+			for( auto& shard : shards_ )
+				shard.firsts.reserve( expectedCount / SHARD_COUNT + 1 );
+		}
+
+		// Record name at index, keeping the lowest index seen
+		void insert( std::string_view name, std::size_t index )
+		{
+			auto& shard = shardOf( name );
+			std::lock_guard lock( shard.mutex );
+			auto [first, inserted] = shard.firsts.try_emplace( name, index );
+			if( !inserted && index < first->second )
+				first->second = index;
+		}
+
+		// Index of the first item named name
+		[[nodiscard]] std::size_t firstOf( std::string_view name ) const
+		{
+			return shardOf( name ).firsts.find( name )->second;
+		}
+
+	private:
+		static constexpr std::size_t SHARD_COUNT = 64;
+
+		// Padded so neighbouring locks do not share a cache line
+		struct alignas( 64 ) Shard
+		{
+			std::mutex mutex;
+			std::unordered_map<std::string_view, std::size_t> firsts;
+		};
+
+		[[nodiscard]] Shard& shardOf( std::string_view name )
+		{
+			return shards_[ std::hash<std::string_view>{ }( name ) % SHARD_COUNT ];
+		}
+
+		[[nodiscard]] const Shard& shardOf( std::string_view name ) const
+		{
+			return shards_[ std::hash<std::string_view>{ }( name ) % SHARD_COUNT ];
+		}
+
+		std::array<Shard, SHARD_COUNT> shards_;
+	};
+}
+
+ConfigValidator::ConfigValidator( ThreadPool& threadPool )
+	: threadPool_( threadPool )
+{
+}
+
+std::vector<ConfigDiagnostic> ConfigValidator::validate( std::span<const Item> items, std::span<const ItemSource> sources,
+	const std::filesystem::path& filePath ) const
+{
+	FirstOccurrenceIndex firsts( items.size( ) );
+
+	auto sourceOf = [sources]( std::size_t index )
+		{
+			return index < sources.size( ) ? sources[ index ] : ItemSource{ };
+		};
+
+	auto indexNames = [items, &firsts]( std::size_t begin, std::size_t end )
+		{
+			for( std::size_t i = begin; i < end; ++i )
+				if( !items[ i ].getName( ).empty( ) )
+					firsts.insert( items[ i ].getName( ), i );
+		};
+
+	auto checkItems = [items, sources, &sourceOf, &firsts, &filePath]( std::size_t begin, std::size_t end )
+		{
+			std::vector<ConfigDiagnostic> diagnostics;
+			for( std::size_t i = begin; i < end; ++i ) {
+				const auto& item = items[ i ];
+				auto source = sourceOf( i );
+				auto report = [&diagnostics, &filePath, &source]( std::string message )
+					{
+						diagnostics.push_back( { filePath, std::move( message ), source.line, source.column } );
+					};
+
+				auto name = item.getName( );
+				if( name.empty( ) ) {
+					report( source.has( ItemSource::NAME ) ? "item has an empty name" : "item has no name" );
+					continue;
+				}
+
+				auto first = firsts.firstOf( name );
+				if( first != i ) {
+					auto firstSource = sourceOf( first );
+					report( "duplicate item '" + std::string( name ) + "' ignored, first defined " +
+						( firstSource.line > 0 ? "at line " + std::to_string( firstSource.line ) : "as item " + std::to_string( first + 1 ) ) );
+				}
+
+				// Scheduled items repeat and do not use their timeout
+				if( !item.getSchedule( ).empty( ) )
+					continue;
+
+				if( !sources.empty( ) && !source.has( ItemSource::TIMEOUT ) )
+					report( "item '" + std::string( name ) + "' has no timeout" );
+				else if( item.getTimeout( ) < MIN_TIMEOUT || item.getTimeout( ) > MAX_TIMEOUT )
+					report( "timeout of item '" + std::string( name ) + "' must be between " + std::to_string( MIN_TIMEOUT ) + " and " +
+						std::to_string( MAX_TIMEOUT ) + " seconds, got " + std::to_string( item.getTimeout( ) ) );
+			}
+			return diagnostics;
+		};
+
+	// One chunk per few items a thread can take, bounded so small catalogs stay on this thread
+	std::size_t chunkCount = std::min( threadPool_.getThreadCount( ) * 4, items.size( ) / MIN_CHUNK_SIZE );
+	if( chunkCount <= 1 ) {
+		indexNames( 0, items.size( ) );
+		return checkItems( 0, items.size( ) );
+	}
+
+	auto boundOf = [&items, chunkCount]( std::size_t chunk )
+		{
+			return items.size( ) * chunk / chunkCount;
+		};
+
+	// Tasks refer to this frame, so every chunk is waited for before a failure is rethrown
+	auto waitAll = []( auto& futures )
+		{
+			for( auto& future : futures )
+				future.wait( );
+		};
+
+	// The second pass starts once the index is complete
+	std::vector<std::future<void>> indexed;
+	indexed.reserve( chunkCount );
+	for( std::size_t chunk = 0; chunk < chunkCount; ++chunk )
+		indexed.push_back( threadPool_.submit( [&indexNames, begin = boundOf( chunk ), end = boundOf( chunk + 1 )]( )
+			{
+				indexNames( begin, end );
+			} ) );
+	waitAll( indexed );
+	for( auto& future : indexed )
+		future.get( );
+
+	std::vector<std::future<std::vector<ConfigDiagnostic>>> checked;
+	checked.reserve( chunkCount );
+	for( std::size_t chunk = 0; chunk < chunkCount; ++chunk )
+		checked.push_back( threadPool_.submit( [&checkItems, begin = boundOf( chunk ), end = boundOf( chunk + 1 )]( )
+			{
+				return checkItems( begin, end );
+			} ) );
+
+	waitAll( checked );
+	std::vector<ConfigDiagnostic> diagnostics;
+	for( auto& future : checked ) {
+		auto chunkDiagnostics = future.get( );
+		diagnostics.insert( diagnostics.end( ), std::make_move_iterator( chunkDiagnostics.begin( ) ),
+			std::make_move_iterator( chunkDiagnostics.end( ) ) );
+	}
+	return diagnostics;
+}
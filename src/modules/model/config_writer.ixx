@@ -0,0 +1,150 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.config_writer;
+
+import model.config;
+import <memory>;
+import <functional>;
+import <filesystem>;
+import <vector>;
+import <thread>;
+import <mutex>;
+import <condition_variable>;
+import <algorithm>;
+
+/**
+ * @brief Background writer that saves immutable Config snapshots off the UI thread
+ *
+ * Requests for the same file that arrive while a write is pending are collapsed,
+ * so only the latest snapshot is written.
+ */
+export class ConfigWriter
+{
+public:
+	using Snapshot = std::shared_ptr<const Config>;
+	using OnSaved = std::function<void( const std::filesystem::path&, bool )>;
+	using Save = std::function<bool( const Config&, const std::filesystem::path& )>;
+
+	// Constructor - onSaved is invoked from the writer thread after each write;
+	// save, if given, replaces Config::saveToYaml
+	explicit ConfigWriter( OnSaved onSaved = nullptr, Save save = nullptr );
+
+	// Destructor - writes any pending snapshots before returning
+	~ConfigWriter( );
+
+	ConfigWriter( const ConfigWriter& ) = delete;
+	ConfigWriter& operator=( const ConfigWriter& ) = delete;
+
+	// Queue a snapshot to be saved, replacing any pending one for the same file
+	void requestSave( Snapshot config, std::filesystem::path filePath );
+
+	// Block until every queued snapshot has been written
+	void flush( );
+
+private:
+	struct Request
+	{
+		Snapshot config;
+		std::filesystem::path filePath;
+	};
+
+	// Writer thread loop
+	void run( );
+
+	OnSaved onSaved_;
+	Save save_;
+
+	std::mutex mutex_;
+	std::condition_variable wakeUp_;
+	std::condition_variable idle_;
+	std::vector<Request> pending_;
+	bool writing_ = false;
+	bool stopping_ = false;
+
+	// Started last so all state above is initialized
+	std::thread worker_;
+};
+
+// Implementation
+ConfigWriter::ConfigWriter( OnSaved onSaved, Save save )
+	: onSaved_( std::move( onSaved ) ),
+	save_( save ? std::move( save ) : Save( []( const Config& config, const std::filesystem::path& filePath )
+		{
+			return config.saveToYaml( filePath );
+		} ) ),
+	worker_( [this]( ) { run( ); } )
+{
+}
+
+ConfigWriter::~ConfigWriter( )
+{
+	{
+		std::lock_guard lock( mutex_ );
+		stopping_ = true;
+	}
+	wakeUp_.notify_one( );
+	worker_.join( );
+}
+
+void ConfigWriter::requestSave( Snapshot config, std::filesystem::path filePath )
+{
+	{
+		std::lock_guard lock( mutex_ );
+		auto existing = std::find_if( pending_.begin( ), pending_.end( ),
+			[&filePath]( const auto& request ) { return request.filePath == filePath; } );
+
+		if( existing != pending_.end( ) )
+			existing->config = std::move( config );
+		else
+			pending_.push_back( Request{ std::move( config ), std::move( filePath ) } );
+	}
+	wakeUp_.notify_one( );
+}
+
+void ConfigWriter::flush( )
+{
+	std::unique_lock lock( mutex_ );
+	idle_.wait( lock, [this]( ) { return pending_.empty( ) && !writing_; } );
+}
+
+void ConfigWriter::run( )
+{
+	std::unique_lock lock( mutex_ );
+	for( ;; ) {
+		wakeUp_.wait( lock, [this]( ) { return stopping_ || !pending_.empty( ); } );
+		if( pending_.empty( ) )
+			return; // Stopping and nothing left to write
+
+		auto batch = std::move( pending_ );
+		pending_.clear( );
+		writing_ = true;
+		lock.unlock( );
+
+		for( const auto& request : batch ) {
+			bool saved = request.config && save_( *request.config, request.filePath );
+			if( onSaved_ )
+				onSaved_( request.filePath, saved );
+		}
+
+		lock.lock( );
+		writing_ = false;
+		if( pending_.empty( ) )
+			idle_.notify_all( );
+	}
+}
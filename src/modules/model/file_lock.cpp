@@ -0,0 +1,89 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+import model.file_lock;
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+FileLock::FileLock( const std::filesystem::path& filePath )
+{
+	HANDLE file = ::CreateFileW( filePath.c_str( ), GENERIC_READ | GENERIC_WRITE,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr );
+	if( file == INVALID_HANDLE_VALUE )
+		return;
+
+	// Lock the whole range, however far the file grows
+	OVERLAPPED overlapped{ };
+	if( !::LockFileEx( file, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped ) ) {
+		::CloseHandle( file );
+		return;
+	}
+	handle_ = reinterpret_cast< std::intptr_t >( file );
+}
+
+FileLock::~FileLock( )
+{
+	if( handle_ == -1 )
+		return;
+
+	auto file = reinterpret_cast< HANDLE >( handle_ );
+	OVERLAPPED overlapped{ };
+	::UnlockFileEx( file, 0, MAXDWORD, MAXDWORD, &overlapped );
+	::CloseHandle( file );
+}
+
+#else
+
+FileLock::FileLock( const std::filesystem::path& filePath )
+{
+	int fd = ::open( filePath.c_str( ), O_RDWR | O_CREAT | O_CLOEXEC, 0600 );
+	if( fd < 0 )
+		return;
+
+	// Waiting may be interrupted by signals
+	while( ::flock( fd, LOCK_EX ) != 0 ) {
+		if( errno != EINTR ) {
+			::close( fd );
+			return;
+		}
+	}
+	handle_ = fd;
+}
+
+FileLock::~FileLock( )
+{
+	// Closing the descriptor releases the lock
+	if( handle_ != -1 )
+		::close( static_cast< int >( handle_ ) );
+}
+
+#endif
+
+bool FileLock::isLocked( ) const noexcept
+{
+	return handle_ != -1;
+}
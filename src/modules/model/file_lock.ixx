@@ -0,0 +1,52 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.file_lock;
+
+import <cstdint>;
+import <filesystem>;
+
+/**
+ * @brief Exclusive advisory lock on a file, held for the lifetime of the object
+ *
+ * Processes sharing a file take the lock around read-modify-write sequences
+ * such as scanning its tail and appending. The file is created if missing.
+ * Locks are per instance, so two instances in one process exclude each
+ * other as well. Uses flock on POSIX and LockFileEx on Windows.
+ */
+export class FileLock
+{
+public:
+	// Constructor - blocks until the lock on filePath is held, or fails
+	explicit FileLock( const std::filesystem::path& filePath );
+
+	// Destructor - releases the lock
+	~FileLock( );
+
+	FileLock( const FileLock& ) = delete;
+	FileLock& operator=( const FileLock& ) = delete;
+
+	// Check whether the lock is held
+	[[nodiscard]] bool isLocked( ) const noexcept;
+
+private:
+	// File descriptor or handle, -1 when the file could not be opened or locked
+	std::intptr_t handle_ = -1;
+};
+
+// Implementation will be added separately since it depends on platform headers
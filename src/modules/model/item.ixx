@@ -19,41 +19,74 @@
 export module model.item;
 
 import <string>;
+import <string_view>;
 import <functional>;
+import <memory_resource>;
 import <optional>;
 
 /**
- * @brief Represents an immutable item with name, type, action, and timeout
+ * @brief Represents an immutable item with name, type, action, timeout, and schedule
+ *
+ * An item with a schedule (see Schedule) repeats; its timeout is not used.
+ *
+ * Text is held in std::pmr strings, so containers using a memory resource
+ * (such as Config's arena) place items and their text in it. Copies made
+ * without an allocator use the default resource and do not borrow from it.
+ *
+ * Fields are described once in ItemSchema, which expands file, binary and
+ * list handling from them; a new field is added there as well.
  */
 export class Item {
 public:
+	using allocator_type = std::pmr::polymorphic_allocator<>;
+
 	// Constructor with default values
-	explicit Item( std::string name = "",
-		std::string type = "",
-		std::string action = "",
-		int timeout = 0 );
+	explicit Item( std::string_view name = "",
+		std::string_view type = "",
+		std::string_view action = "",
+		int timeout = 0,
+		std::string_view schedule = "",
+		const allocator_type& allocator = { } );
+
+	// Constructor of an item without schedule placed with an allocator
+	Item( std::string_view name, std::string_view type, std::string_view action, int timeout,
+		const allocator_type& allocator );
+
+	// Allocator-extended copy and move constructors
+	Item( const Item& other ) = default;
+	Item( Item&& other ) noexcept = default;
+	Item( const Item& other, const allocator_type& allocator );
+	Item( Item&& other, const allocator_type& allocator );
+
+	Item& operator=( const Item& other ) = default;
+	Item& operator=( Item&& other ) = default;
 
 	// Pure functional setters that return new items
-	[[nodiscard]] Item withName( std::string newName ) const;
-	[[nodiscard]] Item withType( std::string newType ) const;
-	[[nodiscard]] Item withAction( std::string newAction ) const;
+	[[nodiscard]] Item withName( std::string_view newName ) const;
+	[[nodiscard]] Item withType( std::string_view newType ) const;
+	[[nodiscard]] Item withAction( std::string_view newAction ) const;
 	[[nodiscard]] Item withTimeout( int newTimeout ) const;
+	[[nodiscard]] Item withSchedule( std::string_view newSchedule ) const;
 
 	// Getters
-	[[nodiscard]] const std::string& getName( ) const noexcept;
-	[[nodiscard]] const std::string& getType( ) const noexcept;
-	[[nodiscard]] const std::string& getAction( ) const noexcept;
+	[[nodiscard]] std::string_view getName( ) const noexcept;
+	[[nodiscard]] std::string_view getType( ) const noexcept;
+	[[nodiscard]] std::string_view getAction( ) const noexcept;
 	[[nodiscard]] int getTimeout( ) const noexcept;
+	[[nodiscard]] std::string_view getSchedule( ) const noexcept;
+
+	// Get the allocator the text was allocated with
+	[[nodiscard]] allocator_type get_allocator( ) const noexcept;
 
-	// Equality operators
-	bool operator==( const Item& other ) const;
-	bool operator!=( const Item& other ) const;
+	// Equality of all fields
+	bool operator==( const Item& other ) const = default;
 
 private:
-	std::string name_;
-	std::string type_;
-	std::string action_;
+	std::pmr::string name_;
+	std::pmr::string type_;
+	std::pmr::string action_;
 	int timeout_;
+	std::pmr::string schedule_;
 };
 
 // Factory function
@@ -64,45 +97,76 @@ export template<typename... Args>
 }
 
 // Implementation
-Item::Item( std::string name, std::string type, std::string action, int timeout )
-	: name_( std::move( name ) ),
-	type_( std::move( type ) ),
-	action_( std::move( action ) ),
-	timeout_( timeout )
+Item::Item( std::string_view name, std::string_view type, std::string_view action, int timeout, std::string_view schedule,
+	const allocator_type& allocator )
+	: name_( name, allocator ),
+	type_( type, allocator ),
+	action_( action, allocator ),
+	timeout_( timeout ),
+	schedule_( schedule, allocator )
+{
+}
+
+Item::Item( std::string_view name, std::string_view type, std::string_view action, int timeout,
+	const allocator_type& allocator )
+	: Item( name, type, action, timeout, "", allocator )
+{
+}
+
+Item::Item( const Item& other, const allocator_type& allocator )
+	: name_( other.name_, allocator ),
+	type_( other.type_, allocator ),
+	action_( other.action_, allocator ),
+	timeout_( other.timeout_ ),
+	schedule_( other.schedule_, allocator )
+{
+}
+
+Item::Item( Item&& other, const allocator_type& allocator )
+	: name_( std::move( other.name_ ), allocator ),
+	type_( std::move( other.type_ ), allocator ),
+	action_( std::move( other.action_ ), allocator ),
+	timeout_( other.timeout_ ),
+	schedule_( std::move( other.schedule_ ), allocator )
 {
 }
 
-Item Item::withName( std::string newName ) const
+Item Item::withName( std::string_view newName ) const
 {
-	return Item( std::move( newName ), type_, action_, timeout_ );
+	return Item( newName, type_, action_, timeout_, schedule_ );
 }
 
-Item Item::withType( std::string newType ) const
+Item Item::withType( std::string_view newType ) const
 {
-	return Item( name_, std::move( newType ), action_, timeout_ );
+	return Item( name_, newType, action_, timeout_, schedule_ );
 }
 
-Item Item::withAction( std::string newAction ) const
+Item Item::withAction( std::string_view newAction ) const
 {
-	return Item( name_, type_, std::move( newAction ), timeout_ );
+	return Item( name_, type_, newAction, timeout_, schedule_ );
 }
 
 Item Item::withTimeout( int newTimeout ) const
 {
-	return Item( name_, type_, action_, newTimeout );
+	return Item( name_, type_, action_, newTimeout, schedule_ );
 }
 
-const std::string& Item::getName( ) const noexcept
+Item Item::withSchedule( std::string_view newSchedule ) const
+{
+	return Item( name_, type_, action_, timeout_, newSchedule );
+}
+
+std::string_view Item::getName( ) const noexcept
 {
 	return name_;
 }
 
-const std::string& Item::getType( ) const noexcept
+std::string_view Item::getType( ) const noexcept
 {
 	return type_;
 }
 
-const std::string& Item::getAction( ) const noexcept
+std::string_view Item::getAction( ) const noexcept
 {
 	return action_;
 }
@@ -112,15 +176,12 @@ int Item::getTimeout( ) const noexcept
 	return timeout_;
 }
 
-bool Item::operator==( const Item& other ) const
+std::string_view Item::getSchedule( ) const noexcept
 {
-	return name_ == other.name_ &&
-		type_ == other.type_ &&
-		action_ == other.action_ &&
-		timeout_ == other.timeout_;
+	return schedule_;
 }
 
-bool Item::operator!=( const Item& other ) const
+Item::allocator_type Item::get_allocator( ) const noexcept
 {
-	return !( *this == other );
-}
\ No newline at end of file
+	return name_.get_allocator( );
+}
@@ -0,0 +1,420 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.item_schema;
+
+import model.item;
+import model.schedule;
+import <charconv>;
+import <cstddef>;
+import <cstdint>;
+import <limits>;
+import <optional>;
+import <string>;
+import <string_view>;
+import <system_error>;
+import <tuple>;
+import <type_traits>;
+import <utility>;
+
+/**
+ * @brief Describes one field of Item: where it is stored in files and lists, and how it is read
+ */
+export template<typename Value>
+struct ItemField
+{
+	using value_type = Value;
+
+	// Key in configuration files
+	const char* key;
+
+	// Header of the list column showing the field
+	const char* label;
+
+	// Getter of the value
+	Value ( Item::*get )( ) const noexcept;
+
+	// ItemSchema::Flag bits
+	std::uint8_t flags = 0;
+
+	// Check of a loaded value, nullptr to accept any
+	bool ( *isValid )( Value value ) = nullptr;
+};
+
+/**
+ * @brief Compile-time description of the fields of Item and the code expanded from it
+ *
+ * FIELDS lists the fields in the order of the Item constructor. Reading and
+ * writing configuration files, the binary form used for drag and drop,
+ * hashing and the list columns of the panels are expanded from it at compile
+ * time, so a new field is added to Item and described here once.
+ */
+export class ItemSchema
+{
+public:
+	enum Flag : std::uint8_t
+	{
+		// Left out of saved files when empty
+		OMIT_EMPTY = 1 << 0,
+
+		// Shown as a column of the active timers
+		TIMER_COLUMN = 1 << 1
+	};
+
+	// Check a schedule expression
+	[[nodiscard]] static bool isValidSchedule( std::string_view schedule );
+
+	static constexpr std::tuple FIELDS{
+		ItemField<std::string_view>{ "name", "Name", &Item::getName, TIMER_COLUMN },
+		ItemField<std::string_view>{ "type", "Type", &Item::getType, TIMER_COLUMN },
+		ItemField<std::string_view>{ "action", "Action", &Item::getAction, TIMER_COLUMN },
+		ItemField<int>{ "timeout", "Timeout", &Item::getTimeout },
+		ItemField<std::string_view>{ "schedule", "Schedule", &Item::getSchedule, OMIT_EMPTY, &isValidSchedule } };
+
+	static constexpr std::size_t FIELD_COUNT = std::tuple_size_v<decltype( FIELDS )>;
+
+private:
+	// Owning type holding a value while an item is read
+	template<typename Field>
+	using StoredOf = std::conditional_t<std::is_same_v<typename Field::value_type, std::string_view>, std::string,
+		typename Field::value_type>;
+
+	template<typename Fields>
+	struct ValuesOf;
+
+	template<typename... Fields>
+	struct ValuesOf<const std::tuple<Fields...>>
+	{
+		using type = std::tuple<StoredOf<Fields>...>;
+		using views = std::tuple<typename Fields::value_type...>;
+	};
+
+	// Field values borrowed from elsewhere, such as encoded bytes
+	using Views = typename ValuesOf<decltype( FIELDS )>::views;
+
+public:
+	// Field values of an item being read, in FIELDS order
+	using Values = typename ValuesOf<decltype( FIELDS )>::type;
+
+	// Call function with each field descriptor, in order
+	template<typename Function>
+	static constexpr void forEachField( Function&& function );
+
+	// Get the index of the field stored under key, FIELD_COUNT when there is none
+	[[nodiscard]] static constexpr std::size_t indexOf( std::string_view key ) noexcept;
+
+	// Count the fields with any of flags set
+	[[nodiscard]] static constexpr std::size_t countFields( std::uint8_t flags ) noexcept;
+
+	// Set the field at index from its text; false when the text is not a valid value
+	[[nodiscard]] static bool parseField( Values& values, std::size_t index, std::string_view text );
+
+	// Reset values to those of a default item, keeping the text buffers
+	static void reset( Values& values ) noexcept;
+
+	// Build an item from read values
+	[[nodiscard]] static Item makeItem( const Values& values, const Item::allocator_type& allocator = { } );
+
+	// Append the binary form of item to bytes
+	static void encode( const Item& item, std::string& bytes );
+
+	// Read an item written by encode; nullopt when the bytes are truncated or of another schema
+	[[nodiscard]] static std::optional<Item> decode( std::string_view bytes );
+
+	// Hash all fields of item
+	[[nodiscard]] static std::size_t hash( const Item& item ) noexcept;
+
+	// Bytes of text held by the fields of item
+	[[nodiscard]] static std::size_t textBytes( const Item& item ) noexcept;
+
+	// Call function( column, label ) for each field with any of flags set, or for every field when flags is 0
+	template<typename Function>
+	static void forEachColumn( Function&& function, std::uint8_t flags = 0 );
+
+	// Call function( column, text ) with the values of the columns listed by forEachColumn
+	template<typename Function>
+	static void formatColumns( const Item& item, Function&& function, std::uint8_t flags = 0 );
+
+private:
+	// Call function with std::integral_constant of each field index, so descriptors stay compile-time constants
+	template<typename Function>
+	static constexpr void forEachIndex( Function&& function );
+
+	// Parse an integer, allowing a leading plus sign
+	[[nodiscard]] static bool parseInt( std::string_view text, int& value ) noexcept;
+
+	// Variable-length unsigned integers of the binary form
+	static void putVarint( std::string& bytes, std::uint64_t value );
+	[[nodiscard]] static bool getVarint( std::string_view& bytes, std::uint64_t& value ) noexcept;
+};
+
+// Implementation
+bool ItemSchema::isValidSchedule( std::string_view schedule )
+{
+	return Schedule::parse( schedule ).has_value( );
+}
+
+template<typename Function>
+constexpr void ItemSchema::forEachIndex( Function&& function )
+{
+	[&function]<std::size_t... I>( std::index_sequence<I...> )
+	{
+		( function( std::integral_constant<std::size_t, I>{ } ), ... );
+	}( std::make_index_sequence<FIELD_COUNT>{ } );
+}
+
+template<typename Function>
+constexpr void ItemSchema::forEachField( Function&& function )
+{
+	forEachIndex( [&function]( auto index ) { function( std::get<index( )>( FIELDS ) ); } );
+}
+
+constexpr std::size_t ItemSchema::indexOf( std::string_view key ) noexcept
+{
+	std::size_t found = FIELD_COUNT;
+	forEachIndex( [key, &found]( auto index )
+		{
+			if( found == FIELD_COUNT && key == std::get<index( )>( FIELDS ).key )
+				found = index;
+		} );
+	return found;
+}
+
+constexpr std::size_t ItemSchema::countFields( std::uint8_t flags ) noexcept
+{
+	std::size_t count = 0;
+	forEachField( [flags, &count]( const auto& field )
+		{
+			if( flags == 0 || ( field.flags & flags ) != 0 )
+				++count;
+		} );
+	return count;
+}
+
+bool ItemSchema::parseField( Values& values, std::size_t index, std::string_view text )
+{
+	bool parsed = false;
+	forEachIndex( [&values, index, text, &parsed]( auto fieldIndex )
+		{
+			if( fieldIndex != index )
+				return;
+
+			constexpr auto isValid = std::get<fieldIndex( )>( FIELDS ).isValid;
+			auto accept = [isValid]( auto candidate )
+				{
+					if constexpr( isValid == nullptr )
+						return true;
+					else
+						return isValid( candidate );
+				};
+
+			auto& value = std::get<fieldIndex( )>( values );
+			if constexpr( std::is_same_v<std::decay_t<decltype( value )>, int> ) {
+				int number = 0;
+				parsed = parseInt( text, number ) && accept( number );
+				if( parsed )
+					value = number;
+			}
+			else {
+				parsed = accept( text );
+				if( parsed )
+					value.assign( text );
+			}
+		} );
+	return parsed;
+}
+
+void ItemSchema::reset( Values& values ) noexcept
+{
+	std::apply( []( auto&... value )
+		{
+			auto clear = []( auto& field )
+				{
+					if constexpr( std::is_same_v<std::decay_t<decltype( field )>, std::string> )
+						field.clear( );
+					else
+						field = { };
+				};
+			( clear( value ), ... );
+		}, values );
+}
+
+Item ItemSchema::makeItem( const Values& values, const Item::allocator_type& allocator )
+{
+	return std::apply( [&allocator]( const auto&... value ) { return Item( value..., allocator ); }, values );
+}
+
+void ItemSchema::encode( const Item& item, std::string& bytes )
+{
+	// Field count, then each field: strings as length and bytes, integers zigzag-encoded
+	bytes.push_back( static_cast< char >( FIELD_COUNT ) );
+	forEachField( [&item, &bytes]( const auto& field )
+		{
+			auto value = ( item.*field.get )( );
+			if constexpr( std::is_same_v<decltype( value ), int> ) {
+				auto wide = static_cast< std::int64_t >( value );
+				putVarint( bytes, ( static_cast< std::uint64_t >( wide ) << 1 ) ^ static_cast< std::uint64_t >( wide >> 63 ) );
+			}
+			else {
+				putVarint( bytes, value.size( ) );
+				bytes.append( value );
+			}
+		} );
+}
+
+std::optional<Item> ItemSchema::decode( std::string_view bytes )
+{
+	if( bytes.empty( ) || static_cast< unsigned char >( bytes.front( ) ) != FIELD_COUNT )
+		return std::nullopt;
+	bytes.remove_prefix( 1 );
+
+	// Text is borrowed from bytes until the item copies it
+	Views values;
+	bool valid = true;
+	forEachIndex( [&bytes, &values, &valid]( auto index )
+		{
+			std::uint64_t raw = 0;
+			if( !valid || !getVarint( bytes, raw ) ) {
+				valid = false;
+				return;
+			}
+
+			auto& value = std::get<index( )>( values );
+			if constexpr( std::is_same_v<std::decay_t<decltype( value )>, int> ) {
+				// Anything encode did not write from an int is corrupt rather than wrapped
+				auto wide = static_cast< std::int64_t >( raw >> 1 ) ^ -static_cast< std::int64_t >( raw & 1 );
+				if( wide < std::numeric_limits<int>::min( ) || wide > std::numeric_limits<int>::max( ) )
+					valid = false;
+				else
+					value = static_cast< int >( wide );
+			}
+			else if( raw > bytes.size( ) )
+				valid = false;
+			else {
+				value = bytes.substr( 0, raw );
+				bytes.remove_prefix( raw );
+			}
+		} );
+
+	if( !valid || !bytes.empty( ) )
+		return std::nullopt;
+	return std::apply( []( const auto&... value ) { return Item( value... ); }, values );
+}
+
+std::size_t ItemSchema::hash( const Item& item ) noexcept
+{
+	// FNV-1a over the fields; string lengths keep ("ab", "c") and ("a", "bc") apart
+	std::uint64_t state = 0xcbf29ce484222325ull;
+	auto mix = [&state]( std::uint64_t value )
+		{
+			for( int i = 0; i < 8; ++i, value >>= 8 ) {
+				state ^= value & 0xff;
+				state *= 0x100000001b3ull;
+			}
+		};
+
+	forEachField( [&item, &state, &mix]( const auto& field )
+		{
+			auto value = ( item.*field.get )( );
+			if constexpr( std::is_same_v<decltype( value ), int> )
+				mix( static_cast< std::uint32_t >( value ) );
+			else {
+				mix( value.size( ) );
+				for( unsigned char c : value ) {
+					state ^= c;
+					state *= 0x100000001b3ull;
+				}
+			}
+		} );
+	return static_cast< std::size_t >( state );
+}
+
+std::size_t ItemSchema::textBytes( const Item& item ) noexcept
+{
+	std::size_t bytes = 0;
+	forEachField( [&item, &bytes]( const auto& field )
+		{
+			if constexpr( std::is_same_v<typename std::decay_t<decltype( field )>::value_type, std::string_view> )
+				bytes += ( item.*field.get )( ).size( );
+		} );
+	return bytes;
+}
+
+template<typename Function>
+void ItemSchema::forEachColumn( Function&& function, std::uint8_t flags )
+{
+	std::size_t column = 0;
+	forEachField( [&function, flags, &column]( const auto& field )
+		{
+			if( flags == 0 || ( field.flags & flags ) != 0 )
+				function( column++, std::string_view( field.label ) );
+		} );
+}
+
+template<typename Function>
+void ItemSchema::formatColumns( const Item& item, Function&& function, std::uint8_t flags )
+{
+	std::size_t column = 0;
+	forEachField( [&item, &function, flags, &column]( const auto& field )
+		{
+			if( flags != 0 && ( field.flags & flags ) == 0 )
+				return;
+
+			auto value = ( item.*field.get )( );
+			if constexpr( std::is_same_v<decltype( value ), int> ) {
+				char text[ 16 ];
+				auto [end, ec] = std::to_chars( text, text + sizeof( text ), value );
+				function( column++, std::string_view( text, end - text ) );
+			}
+			else
+				function( column++, value );
+		} );
+}
+
+bool ItemSchema::parseInt( std::string_view text, int& value ) noexcept
+{
+	const char* first = text.data( );
+	const char* last = first + text.size( );
+	if( first != last && *first == '+' )
+		++first;
+
+	auto [ptr, ec] = std::from_chars( first, last, value );
+	return ec == std::errc( ) && ptr == last && first != last;
+}
+
+void ItemSchema::putVarint( std::string& bytes, std::uint64_t value )
+{
+	while( value >= 0x80 ) {
+		bytes.push_back( static_cast< char >( value | 0x80 ) );
+		value >>= 7;
+	}
+	bytes.push_back( static_cast< char >( value ) );
+}
+
+bool ItemSchema::getVarint( std::string_view& bytes, std::uint64_t& value ) noexcept
+{
+	value = 0;
+	for( int shift = 0; shift < 64 && !bytes.empty( ); shift += 7 ) {
+		auto byte = static_cast< unsigned char >( bytes.front( ) );
+		bytes.remove_prefix( 1 );
+		value |= static_cast< std::uint64_t >( byte & 0x7f ) << shift;
+		if( ( byte & 0x80 ) == 0 )
+			return true;
+	}
+	return false;
+}
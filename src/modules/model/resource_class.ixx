@@ -0,0 +1,38 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.resource_class;
+
+import <string>;
+
+/**
+ * @brief Concurrency budget and admission priority shared by all items of one type
+ */
+export struct ResourceClass
+{
+	// Item type this class applies to
+	std::string type;
+
+	// Maximum number of concurrently running items, 0 for unlimited
+	int concurrency = 0;
+
+	// Higher priorities are admitted first when slots free up
+	int priority = 0;
+
+	bool operator==( const ResourceClass& other ) const = default;
+};
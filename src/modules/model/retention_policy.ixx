@@ -0,0 +1,38 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.retention_policy;
+
+import <cstddef>;
+
+/**
+ * @brief Limits on completed timers kept in the active list before they are archived
+ */
+export struct RetentionPolicy
+{
+	// Newest completed timers kept in the active list
+	std::size_t keepCompleted = 100;
+
+	// Completed timers older than this many seconds are archived, 0 for no age limit
+	int maxAgeSeconds = 0;
+
+	// Archived records kept in memory; older ones are dropped
+	std::size_t archiveSize = 1000;
+
+	bool operator==( const RetentionPolicy& other ) const = default;
+};
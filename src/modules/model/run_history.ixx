@@ -0,0 +1,532 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.run_history;
+
+import model.file_lock;
+import model.item;
+export import model.run_statistics;
+import <bit>;
+import <cstdint>;
+import <filesystem>;
+import <fstream>;
+import <iterator>;
+import <string>;
+import <string_view>;
+import <system_error>;
+import <unordered_map>;
+import <vector>;
+
+/**
+ * @brief How a timer run ended
+ */
+export enum class RunOutcome : std::uint8_t
+{
+	Completed,
+	Aborted
+};
+
+/**
+ * @brief A single finished timer run
+ */
+export struct RunRecord
+{
+	std::uint64_t itemKey = 0;
+	std::int64_t startTime = 0; // Milliseconds since epoch
+	std::int64_t duration = 0; // Milliseconds
+	RunOutcome outcome = RunOutcome::Completed;
+};
+
+/**
+ * @brief Append-only history of timer runs with per-item statistics
+ *
+ * Runs are appended to the history file in blocks that store each field as
+ * its own column, with start times delta-encoded. Aggregated statistics are
+ * kept in memory and persisted to a snapshot file next to the history,
+ * together with the history length they cover, so opening only replays
+ * blocks written after the last snapshot. Several processes may share the
+ * files: appends and snapshots happen under a file lock, and each append
+ * first takes in the blocks others wrote.
+ */
+export class RunHistory
+{
+public:
+	// Runs buffered in memory before a block is appended
+	static constexpr std::size_t BLOCK_SIZE = 64;
+
+	// History bytes appended before the snapshot is refreshed
+	static constexpr std::uint64_t SNAPSHOT_INTERVAL = 64 * 1024;
+
+	// Constructor - loads the snapshot and replays newer history
+	explicit RunHistory( std::filesystem::path filePath );
+
+	// Destructor - flushes pending runs and saves the snapshot
+	~RunHistory( );
+
+	RunHistory( const RunHistory& ) = delete;
+	RunHistory& operator=( const RunHistory& ) = delete;
+
+	// Get the key runs of an item are recorded under
+	[[nodiscard]] static std::uint64_t keyOf( const Item& item ) noexcept;
+
+	// Record a finished run
+	void record( const RunRecord& run );
+
+	// Get statistics of completed runs, nullptr if none were recorded
+	[[nodiscard]] const RunStatistics* getStatistics( std::uint64_t itemKey ) const;
+
+	// Append buffered runs to the history file
+	bool flush( );
+
+	// Persist aggregated statistics covering the history written so far
+	bool saveSnapshot( );
+
+	// Get number of runs replayed from disk when opening
+	[[nodiscard]] std::size_t getReplayedCount( ) const noexcept;
+
+private:
+	[[nodiscard]] std::filesystem::path snapshotPath( ) const;
+	bool loadSnapshot( );
+	bool writeSnapshot( );
+
+	// Apply blocks appended after historyBytes_; returns the number of runs read
+	std::size_t replay( );
+	void apply( const RunRecord& run );
+
+	std::filesystem::path filePath_;
+	std::vector<RunRecord> pending_;
+	std::unordered_map<std::uint64_t, RunStatistics> statistics_;
+	std::uint64_t historyBytes_ = 0;
+	std::uint64_t snapshotBytes_ = 0;
+	std::size_t replayedCount_ = 0;
+};
+
+// Implementation
+namespace
+{
+	constexpr std::uint32_t BLOCK_MAGIC = 0x424B5254; // "TRKB"
+	constexpr std::uint32_t SNAPSHOT_MAGIC = 0x534B5254; // "TRKS"
+	constexpr std::uint32_t SNAPSHOT_VERSION = 1;
+	constexpr std::size_t BLOCK_HEADER_SIZE = 12;
+
+	// Encoded run sizes: key, start delta and duration varints, outcome
+	constexpr std::size_t MIN_RUN_SIZE = 8 + 1 + 1 + 1;
+	constexpr std::size_t MAX_RUN_SIZE = 8 + 10 + 10 + 1;
+
+	// Blocks hold one flush of runs; anything far larger is a corrupt header
+	constexpr std::uint32_t MAX_BLOCK_RUNS = 1024 * 1024;
+
+	// Little-endian binary writer
+	class Writer
+	{
+	public:
+		void putFixed32( std::uint32_t value )
+		{
+			for( int i = 0; i < 4; ++i )
+				bytes_.push_back( static_cast< char >( value >> ( 8 * i ) ) );
+		}
+
+		void putFixed64( std::uint64_t value )
+		{
+			for( int i = 0; i < 8; ++i )
+				bytes_.push_back( static_cast< char >( value >> ( 8 * i ) ) );
+		}
+
+		void putDouble( double value )
+		{
+			putFixed64( std::bit_cast< std::uint64_t >( value ) );
+		}
+
+		void putVarint( std::uint64_t value )
+		{
+			while( value >= 0x80 ) {
+				bytes_.push_back( static_cast< char >( value | 0x80 ) );
+				value >>= 7;
+			}
+			bytes_.push_back( static_cast< char >( value ) );
+		}
+
+		void putSignedVarint( std::int64_t value )
+		{
+			putVarint( ( static_cast< std::uint64_t >( value ) << 1 ) ^ static_cast< std::uint64_t >( value >> 63 ) );
+		}
+
+		void putByte( std::uint8_t value )
+		{
+			bytes_.push_back( static_cast< char >( value ) );
+		}
+
+		[[nodiscard]] std::string& getBytes( ) noexcept
+		{
+			return bytes_;
+		}
+
+	private:
+		std::string bytes_;
+	};
+
+	// Little-endian binary reader; reading past the end sets the failed flag
+	class Reader
+	{
+	public:
+		explicit Reader( std::string_view bytes )
+			: bytes_( bytes )
+		{
+		}
+
+		std::uint32_t getFixed32( )
+		{
+			return static_cast< std::uint32_t >( getFixed( 4 ) );
+		}
+
+		std::uint64_t getFixed64( )
+		{
+			return getFixed( 8 );
+		}
+
+		double getDouble( )
+		{
+			return std::bit_cast< double >( getFixed64( ) );
+		}
+
+		std::uint64_t getVarint( )
+		{
+			std::uint64_t value = 0;
+			for( int shift = 0; shift < 64; shift += 7 ) {
+				if( offset_ >= bytes_.size( ) )
+					break;
+				auto byte = static_cast< std::uint8_t >( bytes_[ offset_++ ] );
+				value |= static_cast< std::uint64_t >( byte & 0x7F ) << shift;
+				if( !( byte & 0x80 ) )
+					return value;
+			}
+			failed_ = true;
+			return 0;
+		}
+
+		std::int64_t getSignedVarint( )
+		{
+			auto value = getVarint( );
+			return static_cast< std::int64_t >( value >> 1 ) ^ -static_cast< std::int64_t >( value & 1 );
+		}
+
+		std::uint8_t getByte( )
+		{
+			return static_cast< std::uint8_t >( getFixed( 1 ) );
+		}
+
+		[[nodiscard]] bool hasFailed( ) const noexcept
+		{
+			return failed_;
+		}
+
+	private:
+		std::uint64_t getFixed( int size )
+		{
+			if( bytes_.size( ) - offset_ < static_cast< std::size_t >( size ) ) {
+				failed_ = true;
+				offset_ = bytes_.size( );
+				return 0;
+			}
+
+			std::uint64_t value = 0;
+			for( int i = 0; i < size; ++i )
+				value |= static_cast< std::uint64_t >( static_cast< std::uint8_t >( bytes_[ offset_++ ] ) ) << ( 8 * i );
+			return value;
+		}
+
+		std::string_view bytes_;
+		std::size_t offset_ = 0;
+		bool failed_ = false;
+	};
+
+	void putQuantile( Writer& writer, const QuantileEstimator& estimator )
+	{
+		writer.putFixed64( estimator.getCount( ) );
+		for( auto height : estimator.getHeights( ) )
+			writer.putDouble( height );
+		for( auto position : estimator.getPositions( ) )
+			writer.putDouble( position );
+	}
+
+	QuantileEstimator getQuantile( Reader& reader, double quantile )
+	{
+		auto count = reader.getFixed64( );
+		QuantileEstimator::Markers heights;
+		QuantileEstimator::Markers positions;
+		for( auto& height : heights )
+			height = reader.getDouble( );
+		for( auto& position : positions )
+			position = reader.getDouble( );
+		return QuantileEstimator( quantile, count, heights, positions );
+	}
+}
+
+RunHistory::RunHistory( std::filesystem::path filePath )
+	: filePath_( std::move( filePath ) )
+{
+	if( !loadSnapshot( ) ) {
+		statistics_.clear( );
+		historyBytes_ = 0;
+	}
+	snapshotBytes_ = historyBytes_;
+	replayedCount_ = replay( );
+}
+
+RunHistory::~RunHistory( )
+{
+	flush( );
+	if( historyBytes_ != snapshotBytes_ )
+		saveSnapshot( );
+}
+
+std::uint64_t RunHistory::keyOf( const Item& item ) noexcept
+{
+	// FNV-1a of the item name
+	std::uint64_t hash = 0xcbf29ce484222325ull;
+	for( unsigned char c : item.getName( ) ) {
+		hash ^= c;
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+void RunHistory::record( const RunRecord& run )
+{
+	apply( run );
+	pending_.push_back( run );
+	if( pending_.size( ) >= BLOCK_SIZE )
+		flush( );
+}
+
+const RunStatistics* RunHistory::getStatistics( std::uint64_t itemKey ) const
+{
+	auto found = statistics_.find( itemKey );
+	return found != statistics_.end( ) ? &found->second : nullptr;
+}
+
+bool RunHistory::flush( )
+{
+	if( pending_.empty( ) )
+		return true;
+
+	// Columns: item keys, start time deltas, durations, outcomes
+	Writer payload;
+	for( const auto& run : pending_ )
+		payload.putFixed64( run.itemKey );
+
+	std::int64_t previousStart = 0;
+	for( const auto& run : pending_ ) {
+		payload.putSignedVarint( run.startTime - previousStart );
+		previousStart = run.startTime;
+	}
+
+	for( const auto& run : pending_ )
+		payload.putVarint( static_cast< std::uint64_t >( run.duration > 0 ? run.duration : 0 ) );
+
+	for( const auto& run : pending_ )
+		payload.putByte( static_cast< std::uint8_t >( run.outcome ) );
+
+	Writer block;
+	block.putFixed32( BLOCK_MAGIC );
+	block.putFixed32( static_cast< std::uint32_t >( pending_.size( ) ) );
+	block.putFixed32( static_cast< std::uint32_t >( payload.getBytes( ).size( ) ) );
+	block.getBytes( ) += payload.getBytes( );
+
+	std::error_code ec;
+	if( filePath_.has_parent_path( ) )
+		std::filesystem::create_directories( filePath_.parent_path( ), ec );
+
+	// Other processes append to the same file; under the lock, take in the blocks they
+	// wrote since, so only a partial block left by a crashed writer remains to be dropped
+	FileLock lock( filePath_ );
+	if( !lock.isLocked( ) )
+		return false;
+
+	replay( );
+	auto fileSize = std::filesystem::file_size( filePath_, ec );
+	if( !ec && fileSize != historyBytes_ )
+		std::filesystem::resize_file( filePath_, historyBytes_, ec );
+
+	std::ofstream fout( filePath_, std::ios::binary | std::ios::app );
+	fout.write( block.getBytes( ).data( ), static_cast< std::streamsize >( block.getBytes( ).size( ) ) );
+	fout.close( );
+	if( !fout )
+		return false;
+
+	historyBytes_ += block.getBytes( ).size( );
+	pending_.clear( );
+
+	if( historyBytes_ - snapshotBytes_ >= SNAPSHOT_INTERVAL )
+		writeSnapshot( );
+	return true;
+}
+
+bool RunHistory::saveSnapshot( )
+{
+	// Processes sharing the history also share the snapshot and its temporary file
+	FileLock lock( filePath_ );
+	return lock.isLocked( ) && writeSnapshot( );
+}
+
+bool RunHistory::writeSnapshot( )
+{
+	Writer writer;
+	writer.putFixed32( SNAPSHOT_MAGIC );
+	writer.putFixed32( SNAPSHOT_VERSION );
+	writer.putFixed64( historyBytes_ );
+	writer.putFixed64( statistics_.size( ) );
+	for( const auto& [key, statistics] : statistics_ ) {
+		writer.putFixed64( key );
+		writer.putFixed64( statistics.getCount( ) );
+		writer.putDouble( statistics.getAverage( ) );
+		putQuantile( writer, statistics.getMedian( ) );
+		putQuantile( writer, statistics.getP90( ) );
+	}
+
+	auto tempPath = snapshotPath( );
+	tempPath += ".tmp";
+	{
+		std::ofstream fout( tempPath, std::ios::binary | std::ios::trunc );
+		fout.write( writer.getBytes( ).data( ), static_cast< std::streamsize >( writer.getBytes( ).size( ) ) );
+		fout.close( );
+		if( !fout )
+			return false;
+	}
+
+	std::error_code ec;
+	std::filesystem::rename( tempPath, snapshotPath( ), ec );
+	if( ec )
+		return false;
+
+	snapshotBytes_ = historyBytes_;
+	return true;
+}
+
+std::size_t RunHistory::getReplayedCount( ) const noexcept
+{
+	return replayedCount_;
+}
+
+std::filesystem::path RunHistory::snapshotPath( ) const
+{
+	auto path = filePath_;
+	path += ".stats";
+	return path;
+}
+
+bool RunHistory::loadSnapshot( )
+{
+	std::ifstream fin( snapshotPath( ), std::ios::binary );
+	if( !fin )
+		return false;
+
+	std::string bytes( ( std::istreambuf_iterator<char>( fin ) ), std::istreambuf_iterator<char>( ) );
+	Reader reader( bytes );
+	if( reader.getFixed32( ) != SNAPSHOT_MAGIC || reader.getFixed32( ) != SNAPSHOT_VERSION )
+		return false;
+
+	// A snapshot covering more than the history describes a different file
+	historyBytes_ = reader.getFixed64( );
+	std::error_code ec;
+	auto fileSize = std::filesystem::file_size( filePath_, ec );
+	if( ec || historyBytes_ > fileSize )
+		return false;
+
+	auto entryCount = reader.getFixed64( );
+	for( std::uint64_t i = 0; i < entryCount && !reader.hasFailed( ); ++i ) {
+		auto key = reader.getFixed64( );
+		auto count = reader.getFixed64( );
+		auto average = reader.getDouble( );
+		auto median = getQuantile( reader, 0.5 );
+		auto p90 = getQuantile( reader, 0.9 );
+		statistics_.insert_or_assign( key, RunStatistics( count, average, median, p90 ) );
+	}
+
+	return !reader.hasFailed( );
+}
+
+std::size_t RunHistory::replay( )
+{
+	std::ifstream fin( filePath_, std::ios::binary );
+	if( !fin )
+		return 0;
+
+	std::error_code ec;
+	auto fileSize = std::filesystem::file_size( filePath_, ec );
+	if( ec || historyBytes_ > fileSize )
+		return 0;
+
+	fin.seekg( static_cast< std::streamoff >( historyBytes_ ) );
+
+	std::size_t replayedCount = 0;
+	std::string header( BLOCK_HEADER_SIZE, '\0' );
+	std::string payload;
+	while( fin.read( header.data( ), BLOCK_HEADER_SIZE ) ) {
+		Reader headerReader( header );
+		auto magic = headerReader.getFixed32( );
+		auto count = headerReader.getFixed32( );
+		auto payloadSize = headerReader.getFixed32( );
+		if( magic != BLOCK_MAGIC )
+			break;
+
+		// Reject sizes that cannot describe count runs before allocating for them
+		auto remaining = fileSize - historyBytes_ - BLOCK_HEADER_SIZE;
+		if( count > MAX_BLOCK_RUNS || payloadSize > remaining ||
+			payloadSize < count * MIN_RUN_SIZE || payloadSize > count * MAX_RUN_SIZE )
+			break;
+
+		payload.resize( payloadSize );
+		if( !fin.read( payload.data( ), payloadSize ) )
+			break; // Partially written block
+
+		Reader reader( payload );
+		std::vector<RunRecord> runs( count );
+		for( auto& run : runs )
+			run.itemKey = reader.getFixed64( );
+
+		std::int64_t previousStart = 0;
+		for( auto& run : runs ) {
+			run.startTime = previousStart + reader.getSignedVarint( );
+			previousStart = run.startTime;
+		}
+
+		for( auto& run : runs )
+			run.duration = static_cast< std::int64_t >( reader.getVarint( ) );
+
+		for( auto& run : runs )
+			run.outcome = static_cast< RunOutcome >( reader.getByte( ) );
+
+		if( reader.hasFailed( ) )
+			break;
+
+		for( const auto& run : runs )
+			apply( run );
+
+		replayedCount += runs.size( );
+		historyBytes_ += BLOCK_HEADER_SIZE + payloadSize;
+	}
+	return replayedCount;
+}
+
+void RunHistory::apply( const RunRecord& run )
+{
+	// Only completed runs say how long an item really takes
+	if( run.outcome == RunOutcome::Completed )
+		statistics_[ run.itemKey ].add( static_cast< double >( run.duration ) / 1000.0 );
+}
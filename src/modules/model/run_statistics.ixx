@@ -0,0 +1,258 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.run_statistics;
+
+import <algorithm>;
+import <array>;
+import <cmath>;
+import <cstdint>;
+import <limits>;
+
+/**
+ * @brief Streaming quantile estimator using the P-square algorithm
+ *
+ * Keeps five markers regardless of how many observations were added
+ * (Jain & Chlamtac, 1985).
+ */
+export class QuantileEstimator
+{
+public:
+	using Markers = std::array<double, 5>;
+
+	// Constructor
+	explicit QuantileEstimator( double quantile );
+
+	// Restore a previously saved state
+	QuantileEstimator( double quantile, std::uint64_t count, const Markers& heights, const Markers& positions );
+
+	// Add an observation
+	void add( double value );
+
+	// Get the current estimate, NaN if nothing was observed
+	[[nodiscard]] double getEstimate( ) const;
+
+	// Getters for persisting the state
+	[[nodiscard]] double getQuantile( ) const noexcept;
+	[[nodiscard]] std::uint64_t getCount( ) const noexcept;
+	[[nodiscard]] const Markers& getHeights( ) const noexcept;
+	[[nodiscard]] const Markers& getPositions( ) const noexcept;
+
+private:
+	[[nodiscard]] double desiredPosition( int marker ) const noexcept;
+	[[nodiscard]] double parabolic( int marker, double direction ) const noexcept;
+	[[nodiscard]] double linear( int marker, int direction ) const noexcept;
+
+	double quantile_;
+	std::uint64_t count_ = 0;
+	Markers heights_{ };
+	Markers positions_{ 1, 2, 3, 4, 5 };
+};
+
+/**
+ * @brief Per-item run-time statistics: exponentially weighted mean, median and p90
+ */
+export class RunStatistics
+{
+public:
+	// Weight of the newest observation in the moving average
+	static constexpr double SMOOTHING = 0.2;
+
+	// Constructor
+	RunStatistics( );
+
+	// Restore a previously saved state
+	RunStatistics( std::uint64_t count, double average, QuantileEstimator median, QuantileEstimator p90 );
+
+	// Add a run duration in seconds
+	void add( double seconds );
+
+	// Getters
+	[[nodiscard]] std::uint64_t getCount( ) const noexcept;
+	[[nodiscard]] double getAverage( ) const noexcept;
+	[[nodiscard]] const QuantileEstimator& getMedian( ) const noexcept;
+	[[nodiscard]] const QuantileEstimator& getP90( ) const noexcept;
+
+private:
+	std::uint64_t count_ = 0;
+	double average_ = 0.0;
+	QuantileEstimator median_;
+	QuantileEstimator p90_;
+};
+
+// Implementation
+QuantileEstimator::QuantileEstimator( double quantile )
+	: quantile_( quantile )
+{
+}
+
+QuantileEstimator::QuantileEstimator( double quantile, std::uint64_t count, const Markers& heights, const Markers& positions )
+	: quantile_( quantile ),
+	count_( count ),
+	heights_( heights ),
+	positions_( positions )
+{
+}
+
+void QuantileEstimator::add( double value )
+{
+	// Collect the first five observations as the initial markers
+	if( count_ < 5 ) {
+		heights_[ count_++ ] = value;
+		if( count_ == 5 )
+			std::sort( heights_.begin( ), heights_.end( ) );
+		return;
+	}
+
+	// Find the cell containing the value, extending the extremes if needed
+	int cell;
+	if( value < heights_[ 0 ] ) {
+		heights_[ 0 ] = value;
+		cell = 0;
+	}
+	else if( value >= heights_[ 4 ] ) {
+		heights_[ 4 ] = value;
+		cell = 3;
+	}
+	else {
+		cell = 0;
+		while( value >= heights_[ cell + 1 ] )
+			++cell;
+	}
+
+	for( int i = cell + 1; i < 5; ++i )
+		positions_[ i ] += 1.0;
+	++count_;
+
+	// Move the middle markers towards their desired positions
+	for( int i = 1; i < 4; ++i ) {
+		double offset = desiredPosition( i ) - positions_[ i ];
+		if( ( offset >= 1.0 && positions_[ i + 1 ] - positions_[ i ] > 1.0 ) ||
+			( offset <= -1.0 && positions_[ i - 1 ] - positions_[ i ] < -1.0 ) ) {
+			int direction = offset > 0 ? 1 : -1;
+			double height = parabolic( i, direction );
+			if( heights_[ i - 1 ] < height && height < heights_[ i + 1 ] )
+				heights_[ i ] = height;
+			else
+				heights_[ i ] = linear( i, direction );
+			positions_[ i ] += direction;
+		}
+	}
+}
+
+double QuantileEstimator::getEstimate( ) const
+{
+	if( count_ == 0 )
+		return std::numeric_limits<double>::quiet_NaN( );
+
+	if( count_ < 5 ) {
+		// Exact quantile of the few observations seen so far
+		Markers sorted = heights_;
+		std::sort( sorted.begin( ), sorted.begin( ) + count_ );
+		auto index = static_cast< std::size_t >( std::lround( quantile_ * static_cast< double >( count_ - 1 ) ) );
+		return sorted[ index ];
+	}
+
+	return heights_[ 2 ];
+}
+
+double QuantileEstimator::getQuantile( ) const noexcept
+{
+	return quantile_;
+}
+
+std::uint64_t QuantileEstimator::getCount( ) const noexcept
+{
+	return count_;
+}
+
+const QuantileEstimator::Markers& QuantileEstimator::getHeights( ) const noexcept
+{
+	return heights_;
+}
+
+const QuantileEstimator::Markers& QuantileEstimator::getPositions( ) const noexcept
+{
+	return positions_;
+}
+
+double QuantileEstimator::desiredPosition( int marker ) const noexcept
+{
+	// Desired positions advance linearly with the number of observations
+	const std::array<double, 5> increments{ 0.0, quantile_ / 2.0, quantile_, ( 1.0 + quantile_ ) / 2.0, 1.0 };
+	return 1.0 + static_cast< double >( count_ - 1 ) * increments[ marker ];
+}
+
+double QuantileEstimator::parabolic( int marker, double direction ) const noexcept
+{
+	double previous = positions_[ marker - 1 ];
+	double current = positions_[ marker ];
+	double next = positions_[ marker + 1 ];
+
+	return heights_[ marker ] + direction / ( next - previous ) *
+		( ( current - previous + direction ) * ( heights_[ marker + 1 ] - heights_[ marker ] ) / ( next - current ) +
+			( next - current - direction ) * ( heights_[ marker ] - heights_[ marker - 1 ] ) / ( current - previous ) );
+}
+
+double QuantileEstimator::linear( int marker, int direction ) const noexcept
+{
+	return heights_[ marker ] + direction * ( heights_[ marker + direction ] - heights_[ marker ] ) /
+		( positions_[ marker + direction ] - positions_[ marker ] );
+}
+
+RunStatistics::RunStatistics( )
+	: median_( 0.5 ),
+	p90_( 0.9 )
+{
+}
+
+RunStatistics::RunStatistics( std::uint64_t count, double average, QuantileEstimator median, QuantileEstimator p90 )
+	: count_( count ),
+	average_( average ),
+	median_( median ),
+	p90_( p90 )
+{
+}
+
+void RunStatistics::add( double seconds )
+{
+	average_ = count_ == 0 ? seconds : average_ + SMOOTHING * ( seconds - average_ );
+	++count_;
+	median_.add( seconds );
+	p90_.add( seconds );
+}
+
+std::uint64_t RunStatistics::getCount( ) const noexcept
+{
+	return count_;
+}
+
+double RunStatistics::getAverage( ) const noexcept
+{
+	return average_;
+}
+
+const QuantileEstimator& RunStatistics::getMedian( ) const noexcept
+{
+	return median_;
+}
+
+const QuantileEstimator& RunStatistics::getP90( ) const noexcept
+{
+	return p90_;
+}
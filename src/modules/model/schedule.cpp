@@ -0,0 +1,290 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+import model.schedule;
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <ctime>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+	using namespace std::chrono_literals;
+
+	constexpr std::array<std::string_view, 7> DAY_NAMES{ "sun", "mon", "tue", "wed", "thu", "fri", "sat" };
+	constexpr std::uint8_t ALL_DAYS = 0x7F;
+	constexpr std::uint8_t WEEKDAYS = 0x3E;
+	constexpr std::uint8_t WEEKENDS = 0x41;
+
+	std::string toLower( std::string_view text )
+	{
+		std::string result( text );
+		std::transform( result.begin( ), result.end( ), result.begin( ),
+			[]( unsigned char c ) { return static_cast< char >( std::tolower( c ) ); } );
+		return result;
+	}
+
+	// Split on whitespace and commas
+	std::vector<std::string_view> tokenize( std::string_view text )
+	{
+		std::vector<std::string_view> tokens;
+		std::size_t pos = 0;
+		while( pos < text.size( ) ) {
+			auto start = text.find_first_not_of( " \t,", pos );
+			if( start == std::string_view::npos )
+				break;
+			auto end = text.find_first_of( " \t,", start );
+			if( end == std::string_view::npos )
+				end = text.size( );
+			tokens.push_back( text.substr( start, end - start ) );
+			pos = end;
+		}
+		return tokens;
+	}
+
+	std::optional<int> parseNumber( std::string_view text )
+	{
+		int value = 0;
+		auto [ptr, ec] = std::from_chars( text.data( ), text.data( ) + text.size( ), value );
+		if( ec != std::errc( ) || ptr != text.data( ) + text.size( ) || text.empty( ) )
+			return std::nullopt;
+		return value;
+	}
+
+	std::optional<int> dayIndex( std::string_view name )
+	{
+		auto found = std::find( DAY_NAMES.begin( ), DAY_NAMES.end( ), name );
+		if( found == DAY_NAMES.end( ) )
+			return std::nullopt;
+		return static_cast< int >( found - DAY_NAMES.begin( ) );
+	}
+
+	// Parse "90s", "1h30m" or "2d" into milliseconds
+	std::optional<std::chrono::milliseconds> parseDuration( std::string_view text )
+	{
+		std::chrono::milliseconds total{ 0 };
+		while( !text.empty( ) ) {
+			auto unitPos = text.find_first_not_of( "0123456789" );
+			if( unitPos == 0 || unitPos == std::string_view::npos )
+				return std::nullopt;
+
+			auto value = parseNumber( text.substr( 0, unitPos ) );
+			if( !value )
+				return std::nullopt;
+
+			switch( text[ unitPos ] ) {
+				case 's': total += std::chrono::seconds( *value ); break;
+				case 'm': total += std::chrono::minutes( *value ); break;
+				case 'h': total += std::chrono::hours( *value ); break;
+				case 'd': total += std::chrono::days( *value ); break;
+				default: return std::nullopt;
+			}
+			text.remove_prefix( unitPos + 1 );
+		}
+		return total;
+	}
+
+	std::tm toLocal( std::time_t time ) noexcept
+	{
+		std::tm local{ };
+#ifdef _WIN32
+		::localtime_s( &local, &time );
+#else
+		::localtime_r( &time, &local );
+#endif
+		return local;
+	}
+
+	// Instant at which the clocks show local under the given daylight saving flag, if they ever do
+	std::optional<Schedule::TimePoint> fromLocal( std::tm local, int isDst ) noexcept
+	{
+		int hour = local.tm_hour;
+		int minute = local.tm_min;
+		local.tm_isdst = isDst;
+		auto time = std::mktime( &local );
+		if( time == -1 || local.tm_hour != hour || local.tm_min != minute )
+			return std::nullopt;
+		return Schedule::Clock::from_time_t( time );
+	}
+}
+
+std::optional<Schedule> Schedule::parse( std::string_view expression )
+{
+	auto text = toLower( expression );
+	auto tokens = tokenize( text );
+	if( tokens.empty( ) )
+		return std::nullopt;
+
+	Schedule schedule;
+	if( tokens[ 0 ] == "every" ) {
+		if( tokens.size( ) != 2 )
+			return std::nullopt;
+		auto interval = parseDuration( tokens[ 1 ] );
+		if( !interval || interval->count( ) <= 0 )
+			return std::nullopt;
+
+		schedule.kind_ = Kind::Interval;
+		schedule.interval_ = *interval;
+		return schedule;
+	}
+
+	schedule.kind_ = Kind::Calendar;
+	if( !schedule.parseCalendar( text ) )
+		return std::nullopt;
+	return schedule;
+}
+
+bool Schedule::parseCalendar( std::string_view expression )
+{
+	for( auto token : tokenize( expression ) ) {
+		auto colon = token.find( ':' );
+		if( colon == std::string_view::npos ) {
+			// Day specification
+			if( token == "daily" )
+				days_ |= ALL_DAYS;
+			else if( token == "weekdays" )
+				days_ |= WEEKDAYS;
+			else if( token == "weekends" )
+				days_ |= WEEKENDS;
+			else if( auto dash = token.find( '-' ); dash != std::string_view::npos ) {
+				auto first = dayIndex( token.substr( 0, dash ) );
+				auto last = dayIndex( token.substr( dash + 1 ) );
+				if( !first || !last )
+					return false;
+				for( int day = *first; ; day = ( day + 1 ) % 7 ) {
+					days_ |= static_cast< std::uint8_t >( 1u << day );
+					if( day == *last )
+						break;
+				}
+			}
+			else if( auto day = dayIndex( token ) )
+				days_ |= static_cast< std::uint8_t >( 1u << *day );
+			else
+				return false;
+			continue;
+		}
+
+		// Time of day, with * for every hour
+		auto hourText = token.substr( 0, colon );
+		auto minute = parseNumber( token.substr( colon + 1 ) );
+		if( !minute || *minute < 0 || *minute > 59 || token.size( ) - colon != 3 )
+			return false;
+
+		int firstHour = 0;
+		int lastHour = 23;
+		if( hourText != "*" ) {
+			auto hour = parseNumber( hourText );
+			if( !hour || *hour < 0 || *hour > 23 )
+				return false;
+			firstHour = lastHour = *hour;
+		}
+		for( int hour = firstHour; hour <= lastHour; ++hour ) {
+			int minuteOfDay = hour * 60 + *minute;
+			minutes_[ minuteOfDay / 64 ] |= std::uint64_t( 1 ) << ( minuteOfDay % 64 );
+		}
+	}
+
+	if( days_ == 0 )
+		days_ = ALL_DAYS;
+	return std::any_of( minutes_.begin( ), minutes_.end( ), []( auto word ) { return word != 0; } );
+}
+
+Schedule::Kind Schedule::getKind( ) const noexcept
+{
+	return kind_;
+}
+
+std::chrono::milliseconds Schedule::getInterval( ) const noexcept
+{
+	return interval_;
+}
+
+Schedule::TimePoint Schedule::nextAfter( TimePoint after ) const noexcept
+{
+	if( kind_ == Kind::Interval )
+		return after + interval_;
+
+	// Occurrences fall on whole minutes, so start at the minute following after
+	auto local = toLocal( Clock::to_time_t( std::chrono::floor<std::chrono::minutes>( after ) + 1min ) );
+	int fromMinute = local.tm_hour * 60 + local.tm_min;
+
+	// A day without a later time moves on to midnight of the following days
+	for( int offset = 0; offset <= 7; ++offset ) {
+		int weekday = ( local.tm_wday + offset ) % 7;
+		if( !( days_ & ( 1u << weekday ) ) )
+			continue;
+
+		int minute = findMinute( offset == 0 ? fromMinute : 0 );
+		if( minute < 0 )
+			continue;
+
+		std::tm target = local;
+		target.tm_mday += offset;
+		target.tm_hour = minute / 60;
+		target.tm_min = minute % 60;
+		target.tm_sec = 0;
+
+		// Resolved with explicit flags, as mktime guesses differently depending on earlier calls:
+		// a time shown twice when clocks go back is taken at its first instant after the start,
+		// and a time skipped when clocks go forward is read as standard time, past the change
+		auto standard = fromLocal( target, 0 );
+		auto daylight = fromLocal( target, 1 );
+		std::optional<TimePoint> next;
+		for( const auto& candidate : { standard, daylight } )
+			if( candidate && *candidate > after && ( !next || *candidate < *next ) )
+				next = candidate;
+		if( !standard && !daylight ) {
+			target.tm_isdst = 0;
+			next = Clock::from_time_t( std::mktime( &target ) );
+		}
+
+		if( next && *next > after )
+			return *next;
+	}
+	return after + 24h;
+}
+
+Schedule::TimePoint Schedule::nextInSeries( TimePoint previous, TimePoint after ) const noexcept
+{
+	if( kind_ == Kind::Calendar )
+		return nextAfter( std::max( previous, after ) );
+
+	// Whole periods past previous, skipping any missed while the series was not updated
+	auto next = previous + interval_;
+	if( next <= after )
+		next += ( ( after - next ) / interval_ + 1 ) * interval_;
+	return std::chrono::time_point_cast< Clock::duration >( next );
+}
+
+int Schedule::findMinute( int from ) const noexcept
+{
+	for( int word = from / 64; word < MINUTE_WORDS; ++word ) {
+		auto bits = minutes_[ word ];
+		if( word == from / 64 )
+			bits &= ~std::uint64_t( 0 ) << ( from % 64 );
+		if( bits )
+			return word * 64 + std::countr_zero( bits );
+	}
+	return -1;
+}
@@ -0,0 +1,91 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.schedule;
+
+import <array>;
+import <chrono>;
+import <cstdint>;
+import <optional>;
+import <string>;
+import <string_view>;
+
+/**
+ * @brief Compiled recurrence of an item, either a fixed interval or calendar times
+ *
+ * Expressions are compiled once:
+ *   every 90s, every 1h30m          fixed interval (units s, m, h, d)
+ *   09:00, daily 12:00              every day at the given times
+ *   weekdays 09:00, weekends 10:30  working days or weekends
+ *   mon,thu 08:30 17:00, mon-fri *:15
+ *                                   listed days; *:MM repeats every hour
+ * Calendar times are local. Days are kept as a 7-bit mask and times as a
+ * 1440-bit minute-of-day set, so the next occurrence is found by scanning at
+ * most eight days of 23 words instead of iterating minute by minute.
+ */
+export class Schedule
+{
+public:
+	using Clock = std::chrono::system_clock;
+	using TimePoint = Clock::time_point;
+
+	enum class Kind : std::uint8_t
+	{
+		Interval,
+		Calendar
+	};
+
+	// Compile an expression, nullopt if it is not valid
+	[[nodiscard]] static std::optional<Schedule> parse( std::string_view expression );
+
+	// Get the kind of recurrence
+	[[nodiscard]] Kind getKind( ) const noexcept;
+
+	// Get the period of an interval schedule
+	[[nodiscard]] std::chrono::milliseconds getInterval( ) const noexcept;
+
+	// Get the first occurrence strictly after a time; interval schedules count from it
+	[[nodiscard]] TimePoint nextAfter( TimePoint after ) const noexcept;
+
+	// Get the first occurrence strictly after a time of a series that fired at previous;
+	// missed occurrences are skipped and interval series keep their phase
+	[[nodiscard]] TimePoint nextInSeries( TimePoint previous, TimePoint after ) const noexcept;
+
+	bool operator==( const Schedule& other ) const = default;
+
+private:
+	static constexpr int MINUTES_PER_DAY = 24 * 60;
+	static constexpr int MINUTE_WORDS = ( MINUTES_PER_DAY + 63 ) / 64;
+
+	Schedule( ) = default;
+
+	// Parse the calendar form into days_ and minutes_
+	[[nodiscard]] bool parseCalendar( std::string_view expression );
+
+	// Get the first set minute of the day at or after from, -1 if none
+	[[nodiscard]] int findMinute( int from ) const noexcept;
+
+	Kind kind_ = Kind::Interval;
+	std::chrono::milliseconds interval_{ 0 };
+
+	// Bit 0 is Sunday, matching std::tm
+	std::uint8_t days_ = 0;
+	std::array<std::uint64_t, MINUTE_WORDS> minutes_{ };
+};
+
+// Implementation is in a separate file since local time conversion is platform dependent
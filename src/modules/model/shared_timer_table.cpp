@@ -0,0 +1,390 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+import model.shared_timer_table;
+import model.utf8;
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	// Identifies the segment layout; bump when Slot or Payload change
+	constexpr std::uint64_t LAYOUT_MAGIC = 0x32'4C'42'54'4B'43'49'54; // "TICKTBL2"
+
+	// Readers give up on a slot whose writer keeps it busy, e.g. after a crash mid-write
+	constexpr int READ_ATTEMPTS = 64;
+
+	constexpr std::size_t NAME_SIZE = 64;
+	constexpr std::size_t TYPE_SIZE = 32;
+	constexpr std::size_t ACTION_SIZE = 128;
+
+	enum SlotState : std::uint32_t
+	{
+		FREE = 0,
+		CLAIMED = 1,
+		PUBLISHED = 2
+	};
+
+	// The owner word packs the slot state in bits 0-1, the generation in bits 2-31
+	// and the owner pid in bits 32-63, so claim, release and reap swap all three at once
+	constexpr std::uint32_t GENERATION_MASK = 0x3FFF'FFFF;
+
+	constexpr std::uint64_t packOwner( SlotState state, std::uint32_t generation, std::int32_t ownerPid )
+	{
+		return ( static_cast< std::uint64_t >( static_cast< std::uint32_t >( ownerPid ) ) << 32 ) |
+			( static_cast< std::uint64_t >( generation & GENERATION_MASK ) << 2 ) | state;
+	}
+
+	constexpr SlotState stateOf( std::uint64_t owner )
+	{
+		return static_cast< SlotState >( owner & 3 );
+	}
+
+	constexpr std::uint32_t generationOf( std::uint64_t owner )
+	{
+		return static_cast< std::uint32_t >( owner >> 2 ) & GENERATION_MASK;
+	}
+
+	constexpr std::int32_t ownerPidOf( std::uint64_t owner )
+	{
+		return static_cast< std::int32_t >( static_cast< std::uint32_t >( owner >> 32 ) );
+	}
+
+	// Payload flag bits
+	constexpr std::uint32_t RUNNING = 1;
+	constexpr std::uint32_t COMPLETED = 2;
+	constexpr std::uint32_t QUEUED = 4;
+
+	// Plain copy of a slot's data, moved in and out of the shared words
+	struct Payload
+	{
+		std::int64_t deadline;
+		std::int64_t remaining;
+		std::int64_t duration;
+		std::uint32_t flags;
+		std::uint32_t reserved;
+		char name[ NAME_SIZE ];
+		char type[ TYPE_SIZE ];
+		char action[ ACTION_SIZE ];
+	};
+
+	constexpr std::size_t PAYLOAD_WORDS = sizeof( Payload ) / sizeof( std::uint64_t );
+	static_assert( sizeof( Payload ) % sizeof( std::uint64_t ) == 0 );
+
+	// Payload words are individually atomic so overlapping reads are not data races;
+	// the sequence number tells readers whether the copy they took is consistent
+	struct alignas( 64 ) Slot
+	{
+		std::atomic<std::uint64_t> owner;
+		std::atomic<std::uint32_t> sequence;
+		std::atomic<std::uint32_t> reserved;
+		std::atomic<std::uint64_t> command;
+		std::atomic<std::uint64_t> payload[ PAYLOAD_WORDS ];
+	};
+
+	struct Segment
+	{
+		alignas( 64 ) std::atomic<std::uint64_t> magic;
+		Slot slots[ SharedTimerTable::CAPACITY ];
+	};
+
+	// The segment starts zero-filled, which must be a valid empty table
+	static_assert( std::atomic<std::uint64_t>::is_always_lock_free );
+	static_assert( std::atomic<std::uint32_t>::is_always_lock_free );
+	static_assert( std::is_trivially_copyable_v<Payload> );
+
+	Segment& segmentOf( void* mapping )
+	{
+		return *static_cast< Segment* >( mapping );
+	}
+
+	// Copy text into a fixed field without splitting a UTF-8 sequence
+	template<std::size_t Size>
+	void copyText( char ( &field )[ Size ], const std::string& text )
+	{
+		auto length = utf8Prefix( text, Size - 1 );
+		std::memcpy( field, text.data( ), length );
+		std::memset( field + length, 0, Size - length );
+	}
+
+	template<std::size_t Size>
+	std::string readText( const char ( &field )[ Size ] )
+	{
+		return std::string( field, strnlen( field, Size ) );
+	}
+
+	constexpr std::uint64_t packCommand( std::uint32_t generation, SharedTimerCommand command )
+	{
+		return ( static_cast< std::uint64_t >( generation ) << 32 ) | static_cast< std::uint32_t >( command );
+	}
+}
+
+#ifdef _WIN32
+
+std::unique_ptr<SharedTimerTable> SharedTimerTable::open( std::string )
+{
+	// Not supported: there is no POSIX shared memory
+	return nullptr;
+}
+
+bool SharedTimerTable::unlink( const std::string& )
+{
+	return false;
+}
+
+SharedTimerTable::~SharedTimerTable( ) = default;
+
+std::size_t SharedTimerTable::reapDeadOwners( )
+{
+	return 0;
+}
+
+#else
+
+std::unique_ptr<SharedTimerTable> SharedTimerTable::open( std::string name )
+{
+	int fd = ::shm_open( name.c_str( ), O_RDWR | O_CREAT | O_CLOEXEC, 0600 );
+	if( fd < 0 )
+		return nullptr;
+
+	// Sizing to the same length is idempotent, so racing creators are harmless
+	constexpr auto size = sizeof( Segment );
+	struct stat status{ };
+	if( ::fstat( fd, &status ) != 0 ||
+		( static_cast< std::size_t >( status.st_size ) != size && ( status.st_size != 0 || ::ftruncate( fd, size ) != 0 ) ) ) {
+		::close( fd );
+		return nullptr;
+	}
+
+	void* mapping = ::mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+	::close( fd );
+	if( mapping == MAP_FAILED )
+		return nullptr;
+
+	// The first process stamps the layout; later ones must find the same one
+	std::uint64_t expected = 0;
+	auto& magic = segmentOf( mapping ).magic;
+	if( !magic.compare_exchange_strong( expected, LAYOUT_MAGIC, std::memory_order_acq_rel ) && expected != LAYOUT_MAGIC ) {
+		::munmap( mapping, size );
+		return nullptr;
+	}
+
+	return std::unique_ptr<SharedTimerTable>( new SharedTimerTable( std::move( name ), mapping, size ) );
+}
+
+bool SharedTimerTable::unlink( const std::string& name )
+{
+	return ::shm_unlink( name.c_str( ) ) == 0;
+}
+
+SharedTimerTable::~SharedTimerTable( )
+{
+	for( auto slot : std::vector<std::uint32_t>( ownedSlots_ ) )
+		release( slot );
+	::munmap( mapping_, size_ );
+}
+
+std::size_t SharedTimerTable::reapDeadOwners( )
+{
+	std::size_t freed = 0;
+	for( auto& slot : segmentOf( mapping_ ).slots ) {
+		auto owner = slot.owner.load( std::memory_order_acquire );
+		auto ownerPid = ownerPidOf( owner );
+		if( stateOf( owner ) == FREE || ownerPid <= 0 || ownerPid == processId_ )
+			continue;
+
+		if( ::kill( ownerPid, 0 ) == 0 || errno != ESRCH )
+			continue;
+
+		// Only the reaper that wins the swap frees the slot, and only if nobody reaped
+		// and claimed it again since the owner word was read
+		if( slot.owner.compare_exchange_strong( owner, packOwner( FREE, generationOf( owner ), 0 ), std::memory_order_acq_rel ) )
+			++freed;
+	}
+	return freed;
+}
+
+#endif
+
+SharedTimerTable::SharedTimerTable( std::string name, void* mapping, std::size_t size )
+	: name_( std::move( name ) ),
+	mapping_( mapping ),
+	size_( size )
+{
+#ifndef _WIN32
+	processId_ = static_cast< std::int32_t >( ::getpid( ) );
+#endif
+}
+
+std::optional<std::uint32_t> SharedTimerTable::claim( )
+{
+	// Start probing at a per-process offset so concurrent claimers rarely collide
+	auto& slots = segmentOf( mapping_ ).slots;
+	auto start = static_cast< std::uint32_t >( processId_ ) % CAPACITY;
+	for( std::uint32_t i = 0; i < CAPACITY; ++i ) {
+		auto index = ( start + i ) % CAPACITY;
+		auto& slot = slots[ index ];
+		auto owner = slot.owner.load( std::memory_order_relaxed );
+		if( stateOf( owner ) != FREE )
+			continue;
+
+		// A new generation invalidates commands aimed at the previous owner
+		if( !slot.owner.compare_exchange_strong( owner, packOwner( CLAIMED, generationOf( owner ) + 1, processId_ ),
+			std::memory_order_acq_rel ) )
+			continue;
+
+		slot.command.store( 0, std::memory_order_relaxed );
+		ownedSlots_.push_back( index );
+		return index;
+	}
+
+	return std::nullopt;
+}
+
+void SharedTimerTable::publish( std::uint32_t slot, const SharedTimerState& state )
+{
+	Payload payload{ };
+	payload.deadline = state.deadline;
+	payload.remaining = state.remaining;
+	payload.duration = state.duration;
+	payload.flags = ( state.running ? RUNNING : 0 ) | ( state.completed ? COMPLETED : 0 ) | ( state.queued ? QUEUED : 0 );
+	copyText( payload.name, state.name );
+	copyText( payload.type, state.type );
+	copyText( payload.action, state.action );
+
+	std::uint64_t words[ PAYLOAD_WORDS ];
+	std::memcpy( words, &payload, sizeof( payload ) );
+
+	// Odd sequence while writing; the fences order the payload stores between the two bumps.
+	// A previous owner that died mid-write may have left it odd, so write from the next odd value
+	auto& target = segmentOf( mapping_ ).slots[ slot ];
+	auto sequence = target.sequence.load( std::memory_order_relaxed ) | 1;
+	target.sequence.store( sequence, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_release );
+	for( std::size_t i = 0; i < PAYLOAD_WORDS; ++i )
+		target.payload[ i ].store( words[ i ], std::memory_order_relaxed );
+	target.sequence.store( sequence + 1, std::memory_order_release );
+
+	// Only this process changes the owner word of a slot it owns while it lives
+	auto owner = target.owner.load( std::memory_order_relaxed );
+	if( stateOf( owner ) != PUBLISHED )
+		target.owner.store( packOwner( PUBLISHED, generationOf( owner ), ownerPidOf( owner ) ), std::memory_order_release );
+}
+
+void SharedTimerTable::release( std::uint32_t slot )
+{
+	auto owned = std::find( ownedSlots_.begin( ), ownedSlots_.end( ), slot );
+	if( owned == ownedSlots_.end( ) )
+		return;
+
+	ownedSlots_.erase( owned );
+	auto& target = segmentOf( mapping_ ).slots[ slot ];
+	auto owner = target.owner.load( std::memory_order_relaxed );
+	target.owner.store( packOwner( FREE, generationOf( owner ), 0 ), std::memory_order_release );
+}
+
+std::optional<SharedTimerEntry> SharedTimerTable::read( std::uint32_t slot ) const
+{
+	const auto& source = segmentOf( mapping_ ).slots[ slot ];
+	std::uint64_t words[ PAYLOAD_WORDS ];
+	for( int attempt = 0; attempt < READ_ATTEMPTS; ++attempt ) {
+		auto owner = source.owner.load( std::memory_order_acquire );
+		if( stateOf( owner ) != PUBLISHED )
+			return std::nullopt;
+
+		auto before = source.sequence.load( std::memory_order_acquire );
+		if( before & 1 )
+			continue;
+
+		for( std::size_t i = 0; i < PAYLOAD_WORDS; ++i )
+			words[ i ] = source.payload[ i ].load( std::memory_order_relaxed );
+
+		std::atomic_thread_fence( std::memory_order_acquire );
+		if( source.sequence.load( std::memory_order_relaxed ) != before ||
+			source.owner.load( std::memory_order_relaxed ) != owner )
+			continue;
+
+		Payload payload;
+		std::memcpy( &payload, words, sizeof( payload ) );
+
+		SharedTimerEntry entry;
+		entry.slot = slot;
+		entry.generation = generationOf( owner );
+		entry.ownerPid = ownerPidOf( owner );
+		entry.state.name = readText( payload.name );
+		entry.state.type = readText( payload.type );
+		entry.state.action = readText( payload.action );
+		entry.state.deadline = payload.deadline;
+		entry.state.remaining = payload.remaining;
+		entry.state.duration = payload.duration;
+		entry.state.running = ( payload.flags & RUNNING ) != 0;
+		entry.state.completed = ( payload.flags & COMPLETED ) != 0;
+		entry.state.queued = ( payload.flags & QUEUED ) != 0;
+		return entry;
+	}
+
+	return std::nullopt;
+}
+
+std::vector<SharedTimerEntry> SharedTimerTable::snapshot( ) const
+{
+	std::vector<SharedTimerEntry> entries;
+	for( std::uint32_t slot = 0; slot < CAPACITY; ++slot )
+		if( auto entry = read( slot ) )
+			entries.push_back( std::move( *entry ) );
+	return entries;
+}
+
+bool SharedTimerTable::postCommand( std::uint32_t slot, std::uint32_t generation, SharedTimerCommand command )
+{
+	auto& target = segmentOf( mapping_ ).slots[ slot ];
+	if( generationOf( target.owner.load( std::memory_order_acquire ) ) != generation )
+		return false;
+
+	std::uint64_t expected = 0;
+	return target.command.compare_exchange_strong( expected, packCommand( generation, command ), std::memory_order_acq_rel );
+}
+
+SharedTimerCommand SharedTimerTable::takeCommand( std::uint32_t slot )
+{
+	auto& target = segmentOf( mapping_ ).slots[ slot ];
+	auto word = target.command.exchange( 0, std::memory_order_acq_rel );
+
+	// Commands posted for an earlier owner of the slot are dropped
+	if( static_cast< std::uint32_t >( word >> 32 ) != generationOf( target.owner.load( std::memory_order_relaxed ) ) )
+		return SharedTimerCommand::None;
+	return static_cast< SharedTimerCommand >( static_cast< std::uint32_t >( word ) );
+}
+
+std::int32_t SharedTimerTable::getProcessId( ) const noexcept
+{
+	return processId_;
+}
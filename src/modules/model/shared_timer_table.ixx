@@ -0,0 +1,139 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.shared_timer_table;
+
+import <cstddef>;
+import <cstdint>;
+import <memory>;
+import <optional>;
+import <string>;
+import <string_view>;
+import <vector>;
+
+/**
+ * @brief Control request another process may post to a timer's owner
+ */
+export enum class SharedTimerCommand : std::uint32_t
+{
+	None = 0,
+	Start,
+	Stop,
+	Reset
+};
+
+/**
+ * @brief State of one timer as published to the shared table
+ *
+ * Times are milliseconds since the system clock epoch, which all processes
+ * on the host share. Text fields are truncated to the table's fixed sizes.
+ */
+export struct SharedTimerState
+{
+	std::string name;
+	std::string type;
+	std::string action;
+	std::int64_t deadline = 0;
+	std::int64_t remaining = 0;
+	std::int64_t duration = 0;
+	bool running = false;
+	bool completed = false;
+	bool queued = false;
+};
+
+/**
+ * @brief A consistent copy of a published slot
+ */
+export struct SharedTimerEntry
+{
+	std::uint32_t slot = 0;
+	std::uint32_t generation = 0;
+	std::int32_t ownerPid = 0;
+	SharedTimerState state;
+};
+
+/**
+ * @brief Fixed-layout table of active timers in a shared memory segment
+ *
+ * Every process on the host that opens the same segment sees all published
+ * timers. A slot's state, generation and owner pid share one word, so
+ * claiming and reaping are a single compare-and-swap each. Slots are written
+ * only by their owner under a sequence lock and read without locking, retrying when a
+ * write overlapped. Other processes control a timer by posting a command
+ * word, which the owner takes and applies. POSIX only; open() returns
+ * nullptr elsewhere.
+ */
+export class SharedTimerTable
+{
+public:
+	// Number of slots in the segment
+	static constexpr std::uint32_t CAPACITY = 256;
+
+	// Segment name used by default
+	static constexpr std::string_view DEFAULT_NAME = "/ticks-timers";
+
+	// Open the named segment, creating it if needed; nullptr if unavailable or incompatible
+	[[nodiscard]] static std::unique_ptr<SharedTimerTable> open( std::string name = std::string( DEFAULT_NAME ) );
+
+	// Remove the named segment; processes that mapped it keep their mapping
+	static bool unlink( const std::string& name = std::string( DEFAULT_NAME ) );
+
+	// Destructor - frees the slots owned by this instance and unmaps the segment
+	~SharedTimerTable( );
+
+	SharedTimerTable( const SharedTimerTable& ) = delete;
+	SharedTimerTable& operator=( const SharedTimerTable& ) = delete;
+
+	// Claim a free slot for this process, nullopt when the table is full
+	[[nodiscard]] std::optional<std::uint32_t> claim( );
+
+	// Publish the state of an owned slot
+	void publish( std::uint32_t slot, const SharedTimerState& state );
+
+	// Free an owned slot
+	void release( std::uint32_t slot );
+
+	// Read one published slot, nullopt if free or not readable consistently
+	[[nodiscard]] std::optional<SharedTimerEntry> read( std::uint32_t slot ) const;
+
+	// Read all published slots
+	[[nodiscard]] std::vector<SharedTimerEntry> snapshot( ) const;
+
+	// Post a command to the owner of a slot; fails if the slot was reused or a command is pending
+	bool postCommand( std::uint32_t slot, std::uint32_t generation, SharedTimerCommand command );
+
+	// Take the pending command of an owned slot
+	[[nodiscard]] SharedTimerCommand takeCommand( std::uint32_t slot );
+
+	// Free slots whose owning process no longer exists; returns the number freed
+	std::size_t reapDeadOwners( );
+
+	// Get this process id as stored in owned slots
+	[[nodiscard]] std::int32_t getProcessId( ) const noexcept;
+
+private:
+	SharedTimerTable( std::string name, void* mapping, std::size_t size );
+
+	std::string name_;
+	void* mapping_ = nullptr;
+	std::size_t size_ = 0;
+	std::int32_t processId_ = 0;
+	std::vector<std::uint32_t> ownedSlots_;
+};
+
+// Implementation will be added separately since it depends on platform headers
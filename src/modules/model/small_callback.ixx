@@ -0,0 +1,169 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.small_callback;
+
+import <cstddef>;
+import <new>;
+import <type_traits>;
+import <utility>;
+
+/**
+ * @brief Move-only void() callable that stores small functions inline
+ *
+ * Functions up to BUFFER_SIZE bytes that are nothrow-movable live in an inline
+ * buffer; larger ones fall back to a single heap allocation.
+ */
+export class SmallCallback
+{
+public:
+	static constexpr std::size_t BUFFER_SIZE = 4 * sizeof( void* );
+
+	// Constructors
+	SmallCallback( ) noexcept = default;
+	SmallCallback( std::nullptr_t ) noexcept;
+
+	template<typename Function>
+		requires ( !std::is_same_v<std::decay_t<Function>, SmallCallback> &&
+			std::is_invocable_r_v<void, std::decay_t<Function>&> )
+	SmallCallback( Function&& function );
+
+	// Move-only
+	SmallCallback( SmallCallback&& other ) noexcept;
+	SmallCallback& operator=( SmallCallback&& other ) noexcept;
+	SmallCallback( const SmallCallback& ) = delete;
+	SmallCallback& operator=( const SmallCallback& ) = delete;
+
+	// Destructor
+	~SmallCallback( );
+
+	// Invoke the stored function
+	void operator()( );
+
+	// Check if a function is stored
+	explicit operator bool( ) const noexcept;
+
+	// Check if a function type would be stored without allocating
+	template<typename Function>
+	static constexpr bool isStoredInline( ) noexcept
+	{
+		return sizeof( Function ) <= BUFFER_SIZE &&
+			alignof( Function ) <= alignof( std::max_align_t ) &&
+			std::is_nothrow_move_constructible_v<Function>;
+	}
+
+private:
+	enum class Operation
+	{
+		Move,
+		Destroy
+	};
+
+	using Invoker = void( * )( void* storage );
+	using Manager = void( * )( Operation operation, void* source, void* destination ) noexcept;
+
+	void reset( ) noexcept;
+
+	alignas( std::max_align_t ) unsigned char storage_[ BUFFER_SIZE ];
+	Invoker invoke_ = nullptr;
+	Manager manage_ = nullptr;
+};
+
+// Implementation
+SmallCallback::SmallCallback( std::nullptr_t ) noexcept
+{
+}
+
+template<typename Function>
+	requires ( !std::is_same_v<std::decay_t<Function>, SmallCallback> &&
+		std::is_invocable_r_v<void, std::decay_t<Function>&> )
+SmallCallback::SmallCallback( Function&& function )
+{
+	using Stored = std::decay_t<Function>;
+
+	if constexpr( isStoredInline<Stored>( ) ) {
+		::new( static_cast< void* >( storage_ ) ) Stored( std::forward<Function>( function ) );
+		invoke_ = []( void* storage ) { ( *static_cast< Stored* >( storage ) )( ); };
+		manage_ = []( Operation operation, void* source, void* destination ) noexcept
+		{
+			auto* stored = static_cast< Stored* >( source );
+			if( operation == Operation::Move )
+				::new( destination ) Stored( std::move( *stored ) );
+			stored->~Stored( );
+		};
+	}
+	else {
+		*reinterpret_cast< Stored** >( storage_ ) = new Stored( std::forward<Function>( function ) );
+		invoke_ = []( void* storage ) { ( **static_cast< Stored** >( storage ) )( ); };
+		manage_ = []( Operation operation, void* source, void* destination ) noexcept
+		{
+			auto** stored = static_cast< Stored** >( source );
+			if( operation == Operation::Move )
+				*static_cast< Stored** >( destination ) = *stored;
+			else
+				delete *stored;
+		};
+	}
+}
+
+SmallCallback::SmallCallback( SmallCallback&& other ) noexcept
+	: invoke_( other.invoke_ ),
+	manage_( other.manage_ )
+{
+	if( manage_ )
+		manage_( Operation::Move, other.storage_, storage_ );
+	other.invoke_ = nullptr;
+	other.manage_ = nullptr;
+}
+
+SmallCallback& SmallCallback::operator=( SmallCallback&& other ) noexcept
+{
+	if( this != &other ) {
+		reset( );
+		invoke_ = other.invoke_;
+		manage_ = other.manage_;
+		if( manage_ )
+			manage_( Operation::Move, other.storage_, storage_ );
+		other.invoke_ = nullptr;
+		other.manage_ = nullptr;
+	}
+	return *this;
+}
+
+SmallCallback::~SmallCallback( )
+{
+	reset( );
+}
+
+void SmallCallback::operator()( )
+{
+	invoke_( storage_ );
+}
+
+SmallCallback::operator bool( ) const noexcept
+{
+	return invoke_ != nullptr;
+}
+
+void SmallCallback::reset( ) noexcept
+{
+	if( manage_ )
+		manage_( Operation::Destroy, storage_, nullptr );
+	invoke_ = nullptr;
+	manage_ = nullptr;
+}
@@ -0,0 +1,207 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.task;
+
+import <coroutine>;
+import <exception>;
+import <utility>;
+
+/**
+ * @brief Coroutine that starts eagerly and can be awaited by another coroutine
+ *
+ * The frame is allocated once per coroutine; awaiting timers or events
+ * inside it does not allocate. Destroying an unfinished task destroys its
+ * coroutine, cancelling any wait it is suspended on. A detached task frees
+ * itself when it finishes; an exception escaping it terminates.
+ */
+export class Task
+{
+public:
+	struct promise_type;
+	using Handle = std::coroutine_handle<promise_type>;
+
+	/**
+	 * @brief Resumes the awaiting coroutine, or frees a detached frame, once the body finished
+	 */
+	struct FinalAwaiter
+	{
+		[[nodiscard]] bool await_ready( ) const noexcept
+		{
+			return false;
+		}
+
+		std::coroutine_handle<> await_suspend( Handle handle ) noexcept;
+
+		void await_resume( ) const noexcept
+		{
+		}
+	};
+
+	struct promise_type
+	{
+		Task get_return_object( ) noexcept
+		{
+			return Task( Handle::from_promise( *this ) );
+		}
+
+		std::suspend_never initial_suspend( ) const noexcept
+		{
+			return { };
+		}
+
+		FinalAwaiter final_suspend( ) const noexcept
+		{
+			return { };
+		}
+
+		void return_void( ) const noexcept
+		{
+		}
+
+		void unhandled_exception( ) noexcept
+		{
+			exception = std::current_exception( );
+		}
+
+		std::exception_ptr exception;
+		std::coroutine_handle<> continuation;
+		bool detached = false;
+	};
+
+	/**
+	 * @brief Suspends the awaiting coroutine until the task finished
+	 */
+	struct Awaiter
+	{
+		[[nodiscard]] bool await_ready( ) const noexcept
+		{
+			return !handle || handle.done( );
+		}
+
+		void await_suspend( std::coroutine_handle<> awaiting ) const noexcept
+		{
+			handle.promise( ).continuation = awaiting;
+		}
+
+		void await_resume( ) const
+		{
+			if( handle && handle.promise( ).exception )
+				std::rethrow_exception( handle.promise( ).exception );
+		}
+
+		Handle handle;
+	};
+
+	// Constructors
+	Task( ) noexcept = default;
+	Task( Task&& other ) noexcept;
+	Task& operator=( Task&& other ) noexcept;
+	Task( const Task& ) = delete;
+	Task& operator=( const Task& ) = delete;
+
+	// Destructor - destroys the coroutine, finished or not
+	~Task( );
+
+	// Check if the coroutine ran to its end
+	[[nodiscard]] bool isDone( ) const noexcept;
+
+	// Rethrow an exception that escaped the finished coroutine
+	void rethrowIfFailed( ) const;
+
+	// Let the coroutine finish on its own; the task becomes empty
+	void detach( ) noexcept;
+
+	// Await the task from another coroutine
+	[[nodiscard]] Awaiter operator co_await( ) const noexcept;
+
+private:
+	explicit Task( Handle handle ) noexcept;
+
+	Handle handle_;
+};
+
+// Implementation
+std::coroutine_handle<> Task::FinalAwaiter::await_suspend( Handle handle ) noexcept
+{
+	auto& promise = handle.promise( );
+	auto continuation = promise.continuation;
+	if( promise.detached ) {
+		if( promise.exception )
+			std::terminate( );
+		handle.destroy( );
+	}
+	return continuation ? continuation : std::noop_coroutine( );
+}
+
+Task::Task( Handle handle ) noexcept
+	: handle_( handle )
+{
+}
+
+Task::Task( Task&& other ) noexcept
+	: handle_( std::exchange( other.handle_, nullptr ) )
+{
+}
+
+Task& Task::operator=( Task&& other ) noexcept
+{
+	if( this != &other ) {
+		if( handle_ )
+			handle_.destroy( );
+		handle_ = std::exchange( other.handle_, nullptr );
+	}
+	return *this;
+}
+
+Task::~Task( )
+{
+	if( handle_ )
+		handle_.destroy( );
+}
+
+bool Task::isDone( ) const noexcept
+{
+	return handle_ && handle_.done( );
+}
+
+void Task::rethrowIfFailed( ) const
+{
+	if( isDone( ) && handle_.promise( ).exception )
+		std::rethrow_exception( handle_.promise( ).exception );
+}
+
+void Task::detach( ) noexcept
+{
+	if( !handle_ )
+		return;
+
+	if( handle_.done( ) ) {
+		handle_.destroy( );
+		handle_ = nullptr;
+		return;
+	}
+
+	handle_.promise( ).detached = true;
+	handle_ = nullptr;
+}
+
+Task::Awaiter Task::operator co_await( ) const noexcept
+{
+	return Awaiter{ handle_ };
+}
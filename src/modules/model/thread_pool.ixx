@@ -0,0 +1,127 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.thread_pool;
+
+import model.small_callback;
+import <algorithm>;
+import <condition_variable>;
+import <cstddef>;
+import <deque>;
+import <future>;
+import <mutex>;
+import <thread>;
+import <type_traits>;
+import <utility>;
+import <vector>;
+
+/**
+ * @brief Fixed set of worker threads running submitted tasks in FIFO order
+ *
+ * Tasks are queued as move-only callbacks, so the packaged task behind each
+ * future is stored without a further allocation.
+ */
+export class ThreadPool
+{
+public:
+	// Constructor - starts threadCount workers, one per core by default
+	explicit ThreadPool( std::size_t threadCount = std::thread::hardware_concurrency( ) );
+
+	// Destructor - finishes queued tasks before returning
+	~ThreadPool( );
+
+	ThreadPool( const ThreadPool& ) = delete;
+	ThreadPool& operator=( const ThreadPool& ) = delete;
+
+	// Queue a task; its result or exception is delivered through the future
+	template<typename Function>
+	[[nodiscard]] std::future<std::invoke_result_t<std::decay_t<Function>&>> submit( Function&& function );
+
+	// Get the number of worker threads
+	[[nodiscard]] std::size_t getThreadCount( ) const noexcept;
+
+private:
+	// Worker thread loop
+	void run( );
+
+	std::mutex mutex_;
+	std::condition_variable wakeUp_;
+	std::deque<SmallCallback> tasks_;
+	bool stopping_ = false;
+
+	// Started last so all state above is initialized
+	std::vector<std::thread> workers_;
+};
+
+// Implementation
+ThreadPool::ThreadPool( std::size_t threadCount )
+{
+	threadCount = std::max<std::size_t>( threadCount, 1 );
+	workers_.reserve( threadCount );
+	for( std::size_t i = 0; i < threadCount; ++i )
+		workers_.emplace_back( [this]( ) { run( ); } );
+}
+
+ThreadPool::~ThreadPool( )
+{
+	{
+		std::lock_guard lock( mutex_ );
+		stopping_ = true;
+	}
+	wakeUp_.notify_all( );
+	for( auto& worker : workers_ )
+		worker.join( );
+}
+
+template<typename Function>
+std::future<std::invoke_result_t<std::decay_t<Function>&>> ThreadPool::submit( Function&& function )
+{
+	using Result = std::invoke_result_t<std::decay_t<Function>&>;
+
+	std::packaged_task<Result( )> task( std::forward<Function>( function ) );
+	auto future = task.get_future( );
+	{
+		std::lock_guard lock( mutex_ );
+		tasks_.emplace_back( std::move( task ) );
+	}
+	wakeUp_.notify_one( );
+	return future;
+}
+
+std::size_t ThreadPool::getThreadCount( ) const noexcept
+{
+	return workers_.size( );
+}
+
+void ThreadPool::run( )
+{
+	std::unique_lock lock( mutex_ );
+	for( ;; ) {
+		wakeUp_.wait( lock, [this]( ) { return stopping_ || !tasks_.empty( ); } );
+		if( tasks_.empty( ) )
+			return; // Stopping and nothing left to run
+
+		auto task = std::move( tasks_.front( ) );
+		tasks_.pop_front( );
+		lock.unlock( );
+
+		task( );
+
+		lock.lock( );
+	}
+}
@@ -0,0 +1,111 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.timer_selector;
+
+import model.item;
+import <cstdint>;
+import <optional>;
+import <string>;
+import <string_view>;
+
+/**
+ * @brief Coarse state of a timer, as used to select timers in bulk
+ */
+export enum class TimerState : std::uint8_t
+{
+	Stopped,
+	Running,
+	Completed
+};
+
+/**
+ * @brief Immutable predicate selecting timers by type, state and name
+ *
+ * Criteria left unset match every timer. Type and state are answered by
+ * the store's secondary indexes; the name is checked only on the timers
+ * they leave.
+ */
+export class TimerSelector
+{
+public:
+	// Selector matching every timer
+	TimerSelector( ) = default;
+
+	// Pure functional setters that return new selectors
+	[[nodiscard]] TimerSelector withType( std::string_view type ) const;
+	[[nodiscard]] TimerSelector withState( TimerState state ) const;
+	[[nodiscard]] TimerSelector withNameContaining( std::string_view text ) const;
+
+	// Getters
+	[[nodiscard]] const std::optional<std::string>& getType( ) const noexcept;
+	[[nodiscard]] std::optional<TimerState> getState( ) const noexcept;
+	[[nodiscard]] const std::string& getNameText( ) const noexcept;
+
+	// Check a timer of an item in a state against every criterion
+	[[nodiscard]] bool matches( const Item& item, TimerState state ) const noexcept;
+
+private:
+	std::optional<std::string> type_;
+	std::optional<TimerState> state_;
+	std::string nameText_;
+};
+
+// Implementation
+TimerSelector TimerSelector::withType( std::string_view type ) const
+{
+	auto selector = *this;
+	selector.type_ = std::string( type );
+	return selector;
+}
+
+TimerSelector TimerSelector::withState( TimerState state ) const
+{
+	auto selector = *this;
+	selector.state_ = state;
+	return selector;
+}
+
+TimerSelector TimerSelector::withNameContaining( std::string_view text ) const
+{
+	auto selector = *this;
+	selector.nameText_ = std::string( text );
+	return selector;
+}
+
+const std::optional<std::string>& TimerSelector::getType( ) const noexcept
+{
+	return type_;
+}
+
+std::optional<TimerState> TimerSelector::getState( ) const noexcept
+{
+	return state_;
+}
+
+const std::string& TimerSelector::getNameText( ) const noexcept
+{
+	return nameText_;
+}
+
+bool TimerSelector::matches( const Item& item, TimerState state ) const noexcept
+{
+	return ( !type_ || item.getType( ) == *type_ ) &&
+		( !state_ || state == *state_ ) &&
+		item.getName( ).find( nameText_ ) != std::string_view::npos;
+}
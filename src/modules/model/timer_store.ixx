@@ -0,0 +1,1025 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.timer_store;
+
+export import model.item;
+export import model.small_callback;
+export import model.waiter_list;
+export import model.timer_selector;
+export import model.retention_policy;
+import model.schedule;
+import model.item_schema;
+import <algorithm>;
+import <array>;
+import <chrono>;
+import <coroutine>;
+import <cstddef>;
+import <cstdint>;
+import <deque>;
+import <functional>;
+import <iomanip>;
+import <limits>;
+import <optional>;
+import <sstream>;
+import <string>;
+import <unordered_map>;
+import <vector>;
+
+/**
+ * @brief Store of active timers laid out as struct-of-arrays
+ *
+ * Deadlines, remaining times and state bits live in separate contiguous
+ * arrays so expiry scans and per-tick reads touch only the data they need.
+ * Timers reference interned items by handle instead of owning copies.
+ * Timers are addressed by stable ids; removal swaps the last timer into the
+ * freed slot, so it is O(1).
+ *
+ * Items with a schedule repeat: when due they are re-armed in place for the
+ * next occurrence instead of completing, and their callbacks and awaiters
+ * fire on every occurrence. Schedules are compiled once per interned item,
+ * so re-arming does not allocate. A series counts as a single run, ending
+ * when it is reset or removed.
+ *
+ * Secondary indexes list the timers of each item type and of each state,
+ * so bulk operations over a TimerSelector cost in proportion to the timers
+ * the smaller index leaves rather than to the whole store.
+ *
+ * Completions are queued in the order they happen, so evictCompleted drops
+ * the oldest completed timers beyond a RetentionPolicy in amortized O(1)
+ * each; entries of timers reset or removed since are skipped lazily.
+ *
+ * Besides callbacks, coroutines can co_await completion( id ). Awaiters are
+ * linked into a per-timer list without allocating and are resumed from the
+ * call that completes or removes the timer. The store must not be moved
+ * while coroutines wait on it.
+ */
+export class TimerStore
+{
+public:
+	using Clock = std::chrono::system_clock;
+	using TimePoint = Clock::time_point;
+	using TimerId = std::uint32_t;
+	using ItemHandle = std::uint32_t;
+	using Callback = SmallCallback;
+
+	/**
+	 * @brief Describes a run that ended, either by completing or by being abandoned
+	 */
+	struct RunEnd
+	{
+		TimerId id;
+		TimePoint startedAt;
+		TimePoint endedAt;
+		bool completed;
+	};
+	using RunListener = std::function<void( const RunEnd& )>;
+
+	/**
+	 * @brief Describes a completed timer about to be evicted by retention
+	 */
+	struct Eviction
+	{
+		TimerId id;
+		const Item& item;
+		TimePoint startedAt;
+		TimePoint completedAt;
+	};
+	using EvictionListener = std::function<void( const Eviction& )>;
+
+	/**
+	 * @brief Suspends the awaiting coroutine until a timer completes or is removed
+	 */
+	class CompletionAwaiter : public Waiter
+	{
+	public:
+		CompletionAwaiter( TimerStore& store, TimerId id ) noexcept;
+
+		[[nodiscard]] bool await_ready( ) noexcept;
+		void await_suspend( std::coroutine_handle<> awaiting ) noexcept;
+
+		// Returns true if the timer completed, false if it was removed first
+		[[nodiscard]] bool await_resume( ) const noexcept;
+
+	private:
+		TimerStore& store_;
+		TimerId id_;
+	};
+
+	// Set listener notified whenever a started run completes, or is reset or removed before completing
+	void setRunListener( RunListener listener );
+
+	// Add a stopped timer counting down the item's timeout, or following its schedule
+	TimerId add( const Item& item, Callback onComplete = nullptr );
+
+	// Remove a timer
+	void remove( TimerId id, TimePoint now = Clock::now( ) );
+
+	// Check if a timer exists
+	[[nodiscard]] bool contains( TimerId id ) const noexcept;
+
+	// Start a timer
+	void start( TimerId id, TimePoint now = Clock::now( ) );
+
+	// Stop a timer, keeping its remaining time
+	void stop( TimerId id, TimePoint now = Clock::now( ) );
+
+	// Reset a timer to its full duration
+	void reset( TimerId id, TimePoint now = Clock::now( ) );
+
+	// Start, stop, reset or remove every timer a selector matches; returns the number selected
+	std::size_t startAll( const TimerSelector& selector, TimePoint now = Clock::now( ) );
+	std::size_t stopAll( const TimerSelector& selector, TimePoint now = Clock::now( ) );
+	std::size_t resetAll( const TimerSelector& selector, TimePoint now = Clock::now( ) );
+	std::size_t removeAll( const TimerSelector& selector, TimePoint now = Clock::now( ) );
+
+	// Remove the oldest completed timers beyond the policy's count or age, telling onEvict
+	// about each before it goes; returns the number removed
+	std::size_t evictCompleted( const RetentionPolicy& policy, TimePoint now = Clock::now( ),
+		const EvictionListener& onEvict = nullptr );
+
+	// Get ids of the timers a selector matches, in no particular order
+	[[nodiscard]] std::vector<TimerId> select( const TimerSelector& selector ) const;
+
+	// Get the item types of the timers in the store
+	[[nodiscard]] std::vector<std::string> getTypes( ) const;
+
+	// Complete or re-arm every due timer, invoke its callback and resume its awaiters; returns the number fired
+	std::size_t update( TimePoint now = Clock::now( ) );
+
+	// Await completion, or the next occurrence, of a timer; completes at once if it already completed or does not exist
+	[[nodiscard]] CompletionAwaiter completion( TimerId id ) noexcept;
+
+	// Get the item a timer counts down for
+	[[nodiscard]] const Item& getItem( TimerId id ) const;
+
+	// Get the handle of the interned item
+	[[nodiscard]] ItemHandle getItemHandle( TimerId id ) const;
+
+	// Get remaining time in whole seconds, rounded up
+	[[nodiscard]] int getRemainingSeconds( TimerId id, TimePoint now = Clock::now( ) ) const;
+
+	// Get remaining time as string (MM:SS)
+	[[nodiscard]] std::string getRemainingTimeString( TimerId id, TimePoint now = Clock::now( ) ) const;
+
+	// Get estimated time of completion
+	[[nodiscard]] TimePoint getETA( TimerId id, TimePoint now = Clock::now( ) ) const;
+
+	// Get the earliest deadline of a running timer, nullopt if none is running
+	[[nodiscard]] std::optional<TimePoint> getNextExpiry( ) const;
+
+	// Get the earliest time a running timer expires or its remaining whole seconds change;
+	// changes up to window later are folded into the same wakeup
+	[[nodiscard]] std::optional<TimePoint> getNextDisplayChange( TimePoint now = Clock::now( ),
+		std::chrono::milliseconds window = std::chrono::milliseconds( 0 ) ) const;
+
+	// Get when the current run was first started, nullopt if it was not started since the last reset
+	[[nodiscard]] std::optional<TimePoint> getStartTime( TimerId id ) const;
+
+	// Get the length of the current run or occurrence; a stopped calendar series reports its next one
+	[[nodiscard]] std::chrono::milliseconds getPeriod( TimerId id, TimePoint now = Clock::now( ) ) const;
+
+	// Check if timer is running
+	[[nodiscard]] bool isRunning( TimerId id ) const;
+
+	// Check if timer is completed
+	[[nodiscard]] bool isCompleted( TimerId id ) const;
+
+	// Check if timer repeats on a schedule
+	[[nodiscard]] bool isRecurring( TimerId id ) const;
+
+	// Get the coarse state of a timer
+	[[nodiscard]] TimerState getState( TimerId id ) const;
+
+	// Get number of timers
+	[[nodiscard]] std::size_t size( ) const noexcept;
+
+	// Check if there are no timers
+	[[nodiscard]] bool empty( ) const noexcept;
+
+	// Get ids of all timers in the order they were added
+	[[nodiscard]] std::vector<TimerId> getIds( ) const;
+
+	// Bytes of per-timer array storage, excluding the shared item pool
+	[[nodiscard]] static constexpr std::size_t bytesPerTimer( ) noexcept;
+
+	// Bytes currently reserved by the store, including the item pool
+	[[nodiscard]] std::size_t memoryUsage( ) const noexcept;
+
+private:
+	using Millis = std::int64_t;
+
+	enum StateBits : std::uint8_t
+	{
+		RUNNING = 1 << 0,
+		COMPLETED = 1 << 1,
+		RECURRING = 1 << 2
+	};
+
+	static constexpr std::uint32_t NO_INDEX = UINT32_MAX;
+	static constexpr Millis NOT_STARTED = INT64_MIN;
+
+	[[nodiscard]] static Millis toMillis( TimePoint timePoint ) noexcept;
+	[[nodiscard]] std::size_t indexOf( TimerId id ) const;
+	[[nodiscard]] Millis remainingAt( std::size_t index, Millis now ) const noexcept;
+	void complete( std::size_t index, Millis completedAt );
+
+	// Replace the state bits of a timer, moving it between state index entries
+	void setState( std::size_t index, std::uint8_t bits );
+	[[nodiscard]] static TimerState stateOf( std::uint8_t bits ) noexcept;
+
+	// Add or remove an id from an index entry, tracking its position there
+	static void link( std::vector<TimerId>& entry, std::vector<std::uint32_t>& positions, TimerId id );
+	static void unlink( std::vector<TimerId>& entry, std::vector<std::uint32_t>& positions, TimerId id ) noexcept;
+	void invokeCallback( TimerId id );
+	void endRun( std::size_t index, Millis endedAt, bool completed );
+
+	// Move the deadline of a recurring timer past now to its next occurrence
+	void rearm( std::size_t index, Millis now ) noexcept;
+
+	// Get the compiled schedule of a recurring timer
+	[[nodiscard]] const Schedule& scheduleOf( std::size_t index ) const noexcept;
+
+	ItemHandle internItem( const Item& item );
+	[[nodiscard]] std::uint32_t typeIndexOf( std::string_view type );
+	void releaseItem( ItemHandle handle ) noexcept;
+
+	// Hot data, indexed densely
+	std::vector<Millis> deadlines_;
+	std::vector<Millis> remaining_;
+	std::vector<std::uint8_t> states_;
+
+	// Cold data, indexed densely; a running calendar series keeps its current occurrence's length as duration
+	std::vector<Millis> durations_;
+	std::vector<Millis> startTimes_;
+	std::vector<ItemHandle> items_;
+	std::vector<Callback> callbacks_;
+	std::vector<TimerId> ids_;
+	std::vector<std::uint64_t> sequences_;
+
+	// Id to dense index mapping
+	std::vector<std::uint32_t> slots_;
+	std::vector<TimerId> freeIds_;
+	std::uint64_t nextSequence_ = 0;
+
+	RunListener runListener_;
+
+	// Scratch space for expiry scans
+	std::vector<std::uint8_t> dueMask_;
+	std::vector<TimerId> dueIds_;
+
+	// Secondary indexes: timer ids per item type and per state
+	std::unordered_map<std::string, std::uint32_t> typeIndices_;
+	std::vector<std::vector<TimerId>> typeEntries_;
+	std::array<std::vector<TimerId>, 3> stateEntries_;
+
+	// Index entry of each timer's type and its positions in the entries, indexed by id
+	std::vector<std::uint32_t> typeOf_;
+	std::vector<std::uint32_t> typePositions_;
+	std::vector<std::uint32_t> statePositions_;
+
+	/**
+	 * @brief A completion in the order it happened; stale once the timer changed since
+	 */
+	struct CompletionEntry
+	{
+		TimerId id;
+		std::uint32_t serial;
+		Millis completedAt;
+	};
+
+	// Check the timer of an entry is still in the completion the entry recorded
+	[[nodiscard]] bool isCurrent( const CompletionEntry& entry ) const noexcept;
+
+	// Completions, oldest first, and the number of completions of each id
+	std::deque<CompletionEntry> completions_;
+	std::vector<std::uint32_t> completionSerials_;
+
+	// Coroutines awaiting each timer, indexed by id so nodes never see their list move
+	std::deque<WaiterList> waiters_;
+
+	// Awaiters of completed or removed timers, resumed once the store is consistent
+	WaiterList ready_;
+
+	// Interned items with reference counts and their compiled schedules
+	std::vector<Item> itemPool_;
+	std::vector<std::optional<Schedule>> schedulePool_;
+	std::vector<std::uint32_t> itemTypes_;
+	std::vector<std::uint32_t> itemRefCounts_;
+	std::vector<ItemHandle> freeItems_;
+
+	// Live interned items by schema hash; colliding items share a bucket
+	std::unordered_multimap<std::size_t, ItemHandle> itemIndex_;
+};
+
+// Implementation
+void TimerStore::setRunListener( RunListener listener )
+{
+	runListener_ = std::move( listener );
+}
+
+TimerStore::TimerId TimerStore::add( const Item& item, Callback onComplete )
+{
+	TimerId id;
+	if( !freeIds_.empty( ) ) {
+		id = freeIds_.back( );
+		freeIds_.pop_back( );
+	}
+	else {
+		id = static_cast< TimerId >( slots_.size( ) );
+		slots_.push_back( NO_INDEX );
+		typeOf_.push_back( 0 );
+		typePositions_.push_back( 0 );
+		statePositions_.push_back( 0 );
+		completionSerials_.push_back( 0 );
+		waiters_.emplace_back( );
+	}
+
+	// Interval schedules count down their period; calendar ones compute deadlines when started
+	auto handle = internItem( item );
+	const auto& schedule = schedulePool_[ handle ];
+	Millis duration = static_cast< Millis >( item.getTimeout( ) ) * 1000;
+	if( schedule )
+		duration = schedule->getKind( ) == Schedule::Kind::Interval ? schedule->getInterval( ).count( ) : 0;
+
+	slots_[ id ] = static_cast< std::uint32_t >( ids_.size( ) );
+	deadlines_.push_back( 0 );
+	remaining_.push_back( duration );
+	states_.push_back( schedule ? RECURRING : 0 );
+	durations_.push_back( duration );
+	startTimes_.push_back( NOT_STARTED );
+	items_.push_back( handle );
+	callbacks_.push_back( std::move( onComplete ) );
+	ids_.push_back( id );
+	sequences_.push_back( nextSequence_++ );
+
+	typeOf_[ id ] = itemTypes_[ handle ];
+	link( typeEntries_[ typeOf_[ id ] ], typePositions_, id );
+	link( stateEntries_[ static_cast< std::size_t >( TimerState::Stopped ) ], statePositions_, id );
+
+	return id;
+}
+
+void TimerStore::remove( TimerId id, TimePoint now )
+{
+	auto index = indexOf( id );
+	auto last = ids_.size( ) - 1;
+
+	if( !( states_[ index ] & COMPLETED ) )
+		endRun( index, toMillis( now ), false );
+	ready_.takeAll( waiters_[ id ], true );
+
+	unlink( typeEntries_[ typeOf_[ id ] ], typePositions_, id );
+	unlink( stateEntries_[ static_cast< std::size_t >( stateOf( states_[ index ] ) ) ], statePositions_, id );
+	releaseItem( items_[ index ] );
+
+	// Move the last timer into the freed slot
+	if( index != last ) {
+		deadlines_[ index ] = deadlines_[ last ];
+		remaining_[ index ] = remaining_[ last ];
+		states_[ index ] = states_[ last ];
+		durations_[ index ] = durations_[ last ];
+		startTimes_[ index ] = startTimes_[ last ];
+		items_[ index ] = items_[ last ];
+		callbacks_[ index ] = std::move( callbacks_[ last ] );
+		ids_[ index ] = ids_[ last ];
+		sequences_[ index ] = sequences_[ last ];
+		slots_[ ids_[ index ] ] = static_cast< std::uint32_t >( index );
+	}
+
+	deadlines_.pop_back( );
+	remaining_.pop_back( );
+	states_.pop_back( );
+	durations_.pop_back( );
+	startTimes_.pop_back( );
+	items_.pop_back( );
+	callbacks_.pop_back( );
+	ids_.pop_back( );
+	sequences_.pop_back( );
+
+	slots_[ id ] = NO_INDEX;
+	freeIds_.push_back( id );
+	ready_.resumeAll( );
+}
+
+bool TimerStore::contains( TimerId id ) const noexcept
+{
+	return id < slots_.size( ) && slots_[ id ] != NO_INDEX;
+}
+
+void TimerStore::start( TimerId id, TimePoint now )
+{
+	auto index = indexOf( id );
+	if( states_[ index ] & ( RUNNING | COMPLETED ) )
+		return;
+
+	setState( index, states_[ index ] | RUNNING );
+	if( ( states_[ index ] & RECURRING ) && scheduleOf( index ).getKind( ) == Schedule::Kind::Calendar ) {
+		deadlines_[ index ] = toMillis( scheduleOf( index ).nextAfter( now ) );
+		durations_[ index ] = deadlines_[ index ] - toMillis( now );
+	}
+	else
+		deadlines_[ index ] = toMillis( now ) + remaining_[ index ];
+	if( startTimes_[ index ] == NOT_STARTED )
+		startTimes_[ index ] = toMillis( now );
+}
+
+void TimerStore::stop( TimerId id, TimePoint now )
+{
+	auto index = indexOf( id );
+	if( !( states_[ index ] & RUNNING ) )
+		return;
+
+	setState( index, states_[ index ] & ~RUNNING );
+	remaining_[ index ] = deadlines_[ index ] - toMillis( now );
+	if( remaining_[ index ] <= 0 && ( states_[ index ] & RECURRING ) ) {
+		// A due occurrence still fires; the series then pauses with a full period
+		remaining_[ index ] = durations_[ index ];
+		ready_.takeAll( waiters_[ id ], false );
+		invokeCallback( id );
+		ready_.resumeAll( );
+	}
+	else if( remaining_[ index ] <= 0 ) {
+		endRun( index, deadlines_[ index ], true );
+		complete( index, deadlines_[ index ] );
+		ready_.takeAll( waiters_[ id ], false );
+		invokeCallback( id );
+		ready_.resumeAll( );
+	}
+}
+
+void TimerStore::reset( TimerId id, TimePoint now )
+{
+	auto index = indexOf( id );
+	if( !( states_[ index ] & COMPLETED ) )
+		endRun( index, toMillis( now ), false );
+
+	setState( index, states_[ index ] & RECURRING );
+	remaining_[ index ] = durations_[ index ];
+	startTimes_[ index ] = NOT_STARTED;
+}
+
+std::size_t TimerStore::startAll( const TimerSelector& selector, TimePoint now )
+{
+	auto ids = select( selector );
+	for( auto id : ids )
+		start( id, now );
+	return ids.size( );
+}
+
+std::size_t TimerStore::stopAll( const TimerSelector& selector, TimePoint now )
+{
+	// Callbacks of timers completing on stop may remove others from the selection
+	auto ids = select( selector );
+	for( auto id : ids ) {
+		if( contains( id ) )
+			stop( id, now );
+	}
+	return ids.size( );
+}
+
+std::size_t TimerStore::resetAll( const TimerSelector& selector, TimePoint now )
+{
+	auto ids = select( selector );
+	for( auto id : ids )
+		reset( id, now );
+	return ids.size( );
+}
+
+std::size_t TimerStore::removeAll( const TimerSelector& selector, TimePoint now )
+{
+	auto ids = select( selector );
+	for( auto id : ids ) {
+		if( contains( id ) )
+			remove( id, now );
+	}
+	return ids.size( );
+}
+
+std::size_t TimerStore::evictCompleted( const RetentionPolicy& policy, TimePoint now, const EvictionListener& onEvict )
+{
+	constexpr auto COMPLETED_STATE = static_cast< std::size_t >( TimerState::Completed );
+	auto cutoff = policy.maxAgeSeconds > 0 ? toMillis( now ) - policy.maxAgeSeconds * 1000ll : std::numeric_limits<Millis>::min( );
+
+	std::size_t evicted = 0;
+	while( !completions_.empty( ) ) {
+		auto entry = completions_.front( );
+		if( !isCurrent( entry ) ) {
+			completions_.pop_front( );
+			continue;
+		}
+
+		// The oldest completion is within both limits, so every later one is too
+		if( stateEntries_[ COMPLETED_STATE ].size( ) <= policy.keepCompleted && entry.completedAt >= cutoff )
+			break;
+
+		completions_.pop_front( );
+		if( onEvict ) {
+			auto index = indexOf( entry.id );
+			onEvict( Eviction{
+				entry.id,
+				itemPool_[ items_[ index ] ],
+				TimePoint( std::chrono::milliseconds( startTimes_[ index ] ) ),
+				TimePoint( std::chrono::milliseconds( entry.completedAt ) ) } );
+		}
+		if( contains( entry.id ) )
+			remove( entry.id, now );
+		++evicted;
+	}
+
+	// Stale entries behind a kept completion are dropped once they outnumber the live ones
+	if( completions_.size( ) > 2 * stateEntries_[ COMPLETED_STATE ].size( ) + 64 )
+		std::erase_if( completions_, [this]( const CompletionEntry& entry ) { return !isCurrent( entry ); } );
+
+	return evicted;
+}
+
+std::vector<TimerStore::TimerId> TimerStore::select( const TimerSelector& selector ) const
+{
+	// Scan the smallest candidate list the indexes offer, then check every criterion
+	const std::vector<TimerId>* candidates = &ids_;
+	if( auto state = selector.getState( ) )
+		candidates = &stateEntries_[ static_cast< std::size_t >( *state ) ];
+	if( const auto& type = selector.getType( ) ) {
+		auto found = typeIndices_.find( *type );
+		if( found == typeIndices_.end( ) )
+			return { };
+		if( typeEntries_[ found->second ].size( ) < candidates->size( ) )
+			candidates = &typeEntries_[ found->second ];
+	}
+
+	std::vector<TimerId> selected;
+	for( auto id : *candidates ) {
+		auto index = slots_[ id ];
+		if( selector.matches( itemPool_[ items_[ index ] ], stateOf( states_[ index ] ) ) )
+			selected.push_back( id );
+	}
+	return selected;
+}
+
+std::vector<std::string> TimerStore::getTypes( ) const
+{
+	std::vector<std::string> types;
+	for( const auto& [type, entry] : typeIndices_ ) {
+		if( !typeEntries_[ entry ].empty( ) )
+			types.push_back( type );
+	}
+	std::sort( types.begin( ), types.end( ) );
+	return types;
+}
+
+std::size_t TimerStore::update( TimePoint now )
+{
+	auto nowMillis = toMillis( now );
+	auto count = ids_.size( );
+
+	// Branch-free pass over the hot arrays so the compiler can vectorize it
+	dueMask_.resize( count );
+	const Millis* deadlines = deadlines_.data( );
+	const std::uint8_t* states = states_.data( );
+	std::uint8_t* due = dueMask_.data( );
+	for( std::size_t i = 0; i < count; ++i )
+		due[ i ] = static_cast< std::uint8_t >( ( states[ i ] & RUNNING ) != 0 ) &
+			static_cast< std::uint8_t >( deadlines[ i ] <= nowMillis );
+
+	dueIds_.clear( );
+	for( std::size_t i = 0; i < count; ++i ) {
+		if( due[ i ] && ( states_[ i ] & RECURRING ) ) {
+			rearm( i, nowMillis );
+			ready_.takeAll( waiters_[ ids_[ i ] ], false );
+			dueIds_.push_back( ids_[ i ] );
+		}
+		else if( due[ i ] ) {
+			endRun( i, deadlines_[ i ], true );
+			complete( i, deadlines_[ i ] );
+			ready_.takeAll( waiters_[ ids_[ i ] ], false );
+			dueIds_.push_back( ids_[ i ] );
+		}
+	}
+
+	// Callbacks and awaiters run last since they may modify the store; the
+	// scratch buffer is borrowed so a nested update cannot change the list
+	std::vector<TimerId> completed;
+	completed.swap( dueIds_ );
+	for( auto id : completed )
+		invokeCallback( id );
+	ready_.resumeAll( );
+
+	auto fired = completed.size( );
+	if( completed.capacity( ) > dueIds_.capacity( ) )
+		dueIds_.swap( completed );
+	return fired;
+}
+
+TimerStore::CompletionAwaiter TimerStore::completion( TimerId id ) noexcept
+{
+	return CompletionAwaiter( *this, id );
+}
+
+const Item& TimerStore::getItem( TimerId id ) const
+{
+	return itemPool_[ items_[ indexOf( id ) ] ];
+}
+
+TimerStore::ItemHandle TimerStore::getItemHandle( TimerId id ) const
+{
+	return items_[ indexOf( id ) ];
+}
+
+int TimerStore::getRemainingSeconds( TimerId id, TimePoint now ) const
+{
+	auto remaining = remainingAt( indexOf( id ), toMillis( now ) );
+	return static_cast< int >( ( remaining + 999 ) / 1000 );
+}
+
+std::string TimerStore::getRemainingTimeString( TimerId id, TimePoint now ) const
+{
+	auto seconds = getRemainingSeconds( id, now );
+	auto minutes = seconds / 60;
+	seconds %= 60;
+
+	std::stringstream ss;
+	ss << std::setfill( '0' ) << std::setw( 2 ) << minutes << ":"
+		<< std::setfill( '0' ) << std::setw( 2 ) << seconds;
+	return ss.str( );
+}
+
+TimerStore::TimePoint TimerStore::getETA( TimerId id, TimePoint now ) const
+{
+	auto index = indexOf( id );
+	if( states_[ index ] & RUNNING )
+		return TimePoint( std::chrono::milliseconds( deadlines_[ index ] ) );
+
+	return now + std::chrono::milliseconds( remainingAt( index, toMillis( now ) ) );
+}
+
+std::optional<TimerStore::TimePoint> TimerStore::getNextExpiry( ) const
+{
+	// Branch-free minimum over the hot arrays; idle slots contribute the maximum
+	constexpr Millis NONE = std::numeric_limits<Millis>::max( );
+	Millis next = NONE;
+	auto count = ids_.size( );
+	for( std::size_t i = 0; i < count; ++i )
+		next = std::min( next, ( states_[ i ] & RUNNING ) ? deadlines_[ i ] : NONE );
+
+	if( next == NONE )
+		return std::nullopt;
+	return TimePoint( std::chrono::milliseconds( next ) );
+}
+
+std::optional<TimerStore::TimePoint> TimerStore::getNextDisplayChange( TimePoint now, std::chrono::milliseconds window ) const
+{
+	constexpr Millis NONE = std::numeric_limits<Millis>::max( );
+	auto nowMillis = toMillis( now );
+	auto count = ids_.size( );
+
+	// Rounded-up seconds change whenever the remaining time crosses a whole second
+	auto changeAt = [this, nowMillis]( std::size_t i )
+		{
+			auto remaining = deadlines_[ i ] - nowMillis;
+			return remaining > 0 ? nowMillis + ( remaining - 1 ) % 1000 + 1 : nowMillis;
+		};
+
+	Millis next = NONE;
+	for( std::size_t i = 0; i < count; ++i )
+		next = std::min( next, ( states_[ i ] & RUNNING ) ? changeAt( i ) : NONE );
+
+	if( next == NONE )
+		return std::nullopt;
+
+	// Wake once for every change inside the window instead of once per change,
+	// but never later than an expiry so completions are not delayed
+	Millis latest = next;
+	if( window.count( ) > 0 ) {
+		Millis expiry = NONE;
+		for( std::size_t i = 0; i < count; ++i ) {
+			auto change = ( states_[ i ] & RUNNING ) ? changeAt( i ) : NONE;
+			if( change <= next + window.count( ) )
+				latest = std::max( latest, change );
+			expiry = std::min( expiry, ( states_[ i ] & RUNNING ) ? deadlines_[ i ] : NONE );
+		}
+		latest = std::min( latest, expiry );
+	}
+
+	return TimePoint( std::chrono::milliseconds( latest ) );
+}
+
+std::optional<TimerStore::TimePoint> TimerStore::getStartTime( TimerId id ) const
+{
+	auto startTime = startTimes_[ indexOf( id ) ];
+	if( startTime == NOT_STARTED )
+		return std::nullopt;
+
+	return TimePoint( std::chrono::milliseconds( startTime ) );
+}
+
+std::chrono::milliseconds TimerStore::getPeriod( TimerId id, TimePoint now ) const
+{
+	auto index = indexOf( id );
+	bool calendar = ( states_[ index ] & RECURRING ) && scheduleOf( index ).getKind( ) == Schedule::Kind::Calendar;
+	if( calendar && !( states_[ index ] & RUNNING ) )
+		return std::chrono::milliseconds( remainingAt( index, toMillis( now ) ) );
+
+	return std::chrono::milliseconds( durations_[ index ] );
+}
+
+bool TimerStore::isRunning( TimerId id ) const
+{
+	return ( states_[ indexOf( id ) ] & RUNNING ) != 0;
+}
+
+bool TimerStore::isCompleted( TimerId id ) const
+{
+	return ( states_[ indexOf( id ) ] & COMPLETED ) != 0;
+}
+
+bool TimerStore::isRecurring( TimerId id ) const
+{
+	return ( states_[ indexOf( id ) ] & RECURRING ) != 0;
+}
+
+TimerState TimerStore::getState( TimerId id ) const
+{
+	return stateOf( states_[ indexOf( id ) ] );
+}
+
+std::size_t TimerStore::size( ) const noexcept
+{
+	return ids_.size( );
+}
+
+bool TimerStore::empty( ) const noexcept
+{
+	return ids_.empty( );
+}
+
+std::vector<TimerStore::TimerId> TimerStore::getIds( ) const
+{
+	std::vector<std::size_t> order( ids_.size( ) );
+	for( std::size_t i = 0; i < order.size( ); ++i )
+		order[ i ] = i;
+
+	std::sort( order.begin( ), order.end( ),
+		[this]( std::size_t lhs, std::size_t rhs ) { return sequences_[ lhs ] < sequences_[ rhs ]; } );
+
+	std::vector<TimerId> ids;
+	ids.reserve( order.size( ) );
+	for( auto index : order )
+		ids.push_back( ids_[ index ] );
+	return ids;
+}
+
+constexpr std::size_t TimerStore::bytesPerTimer( ) noexcept
+{
+	return sizeof( Millis ) * 4 + sizeof( std::uint8_t ) + sizeof( ItemHandle ) + sizeof( Callback ) +
+		sizeof( TimerId ) + sizeof( std::uint64_t ) + sizeof( std::uint32_t ) + sizeof( std::uint8_t ) +
+		sizeof( WaiterList ) + sizeof( std::uint32_t ) * 3 + sizeof( TimerId ) * 2;
+}
+
+std::size_t TimerStore::memoryUsage( ) const noexcept
+{
+	std::size_t bytes = deadlines_.capacity( ) * sizeof( Millis ) +
+		remaining_.capacity( ) * sizeof( Millis ) +
+		states_.capacity( ) * sizeof( std::uint8_t ) +
+		durations_.capacity( ) * sizeof( Millis ) +
+		startTimes_.capacity( ) * sizeof( Millis ) +
+		items_.capacity( ) * sizeof( ItemHandle ) +
+		callbacks_.capacity( ) * sizeof( Callback ) +
+		ids_.capacity( ) * sizeof( TimerId ) +
+		sequences_.capacity( ) * sizeof( std::uint64_t ) +
+		slots_.capacity( ) * sizeof( std::uint32_t ) +
+		freeIds_.capacity( ) * sizeof( TimerId ) +
+		dueMask_.capacity( ) * sizeof( std::uint8_t ) +
+		dueIds_.capacity( ) * sizeof( TimerId ) +
+		itemPool_.capacity( ) * sizeof( Item ) +
+		schedulePool_.capacity( ) * sizeof( std::optional<Schedule> ) +
+		itemRefCounts_.capacity( ) * sizeof( std::uint32_t ) +
+		freeItems_.capacity( ) * sizeof( ItemHandle ) +
+		itemIndex_.size( ) * ( sizeof( std::size_t ) + sizeof( ItemHandle ) + sizeof( void* ) ) +
+		itemIndex_.bucket_count( ) * sizeof( void* ) +
+		waiters_.size( ) * sizeof( WaiterList ) +
+		itemTypes_.capacity( ) * sizeof( std::uint32_t ) +
+		( typeOf_.capacity( ) + typePositions_.capacity( ) + statePositions_.capacity( ) ) * sizeof( std::uint32_t );
+
+	bytes += completionSerials_.capacity( ) * sizeof( std::uint32_t ) + completions_.size( ) * sizeof( CompletionEntry );
+	for( const auto& entry : typeEntries_ )
+		bytes += entry.capacity( ) * sizeof( TimerId );
+	for( const auto& entry : stateEntries_ )
+		bytes += entry.capacity( ) * sizeof( TimerId );
+
+	for( const auto& item : itemPool_ )
+		bytes += ItemSchema::textBytes( item );
+
+	return bytes;
+}
+
+TimerStore::Millis TimerStore::toMillis( TimePoint timePoint ) noexcept
+{
+	return std::chrono::duration_cast< std::chrono::milliseconds >( timePoint.time_since_epoch( ) ).count( );
+}
+
+std::size_t TimerStore::indexOf( TimerId id ) const
+{
+	return slots_.at( id );
+}
+
+TimerStore::Millis TimerStore::remainingAt( std::size_t index, Millis now ) const noexcept
+{
+	if( states_[ index ] & RUNNING )
+		return std::max<Millis>( deadlines_[ index ] - now, 0 );
+
+	// A stopped calendar series is due at its next occurrence whenever it is started
+	if( ( states_[ index ] & RECURRING ) && scheduleOf( index ).getKind( ) == Schedule::Kind::Calendar ) {
+		auto next = scheduleOf( index ).nextAfter( TimePoint( std::chrono::milliseconds( now ) ) );
+		return toMillis( next ) - now;
+	}
+
+	return std::max<Millis>( remaining_[ index ], 0 );
+}
+
+void TimerStore::complete( std::size_t index, Millis completedAt )
+{
+	setState( index, COMPLETED );
+	auto id = ids_[ index ];
+	completions_.push_back( CompletionEntry{ id, ++completionSerials_[ id ], completedAt } );
+	remaining_[ index ] = 0;
+}
+
+bool TimerStore::isCurrent( const CompletionEntry& entry ) const noexcept
+{
+	return contains( entry.id ) && completionSerials_[ entry.id ] == entry.serial &&
+		( states_[ slots_[ entry.id ] ] & COMPLETED ) != 0;
+}
+
+void TimerStore::setState( std::size_t index, std::uint8_t bits )
+{
+	auto from = stateOf( states_[ index ] );
+	auto to = stateOf( bits );
+	states_[ index ] = bits;
+	if( from != to ) {
+		unlink( stateEntries_[ static_cast< std::size_t >( from ) ], statePositions_, ids_[ index ] );
+		link( stateEntries_[ static_cast< std::size_t >( to ) ], statePositions_, ids_[ index ] );
+	}
+}
+
+TimerState TimerStore::stateOf( std::uint8_t bits ) noexcept
+{
+	if( bits & COMPLETED )
+		return TimerState::Completed;
+	return ( bits & RUNNING ) ? TimerState::Running : TimerState::Stopped;
+}
+
+void TimerStore::link( std::vector<TimerId>& entry, std::vector<std::uint32_t>& positions, TimerId id )
+{
+	positions[ id ] = static_cast< std::uint32_t >( entry.size( ) );
+	entry.push_back( id );
+}
+
+void TimerStore::unlink( std::vector<TimerId>& entry, std::vector<std::uint32_t>& positions, TimerId id ) noexcept
+{
+	// Move the last id into the freed position
+	auto position = positions[ id ];
+	auto moved = entry.back( );
+	entry[ position ] = moved;
+	positions[ moved ] = position;
+	entry.pop_back( );
+}
+
+void TimerStore::invokeCallback( TimerId id )
+{
+	if( !contains( id ) || !callbacks_[ indexOf( id ) ] )
+		return;
+
+	// Invoke a moved-out copy; the callback may add or remove timers
+	auto callback = std::move( callbacks_[ indexOf( id ) ] );
+	callback( );
+
+	if( contains( id ) && !callbacks_[ indexOf( id ) ] )
+		callbacks_[ indexOf( id ) ] = std::move( callback );
+}
+
+void TimerStore::endRun( std::size_t index, Millis endedAt, bool completed )
+{
+	if( !runListener_ || startTimes_[ index ] == NOT_STARTED )
+		return;
+
+	runListener_( RunEnd{
+		ids_[ index ],
+		TimePoint( std::chrono::milliseconds( startTimes_[ index ] ) ),
+		TimePoint( std::chrono::milliseconds( endedAt ) ),
+		completed } );
+}
+
+void TimerStore::rearm( std::size_t index, Millis now ) noexcept
+{
+	auto previous = TimePoint( std::chrono::milliseconds( deadlines_[ index ] ) );
+	auto next = scheduleOf( index ).nextInSeries( previous, TimePoint( std::chrono::milliseconds( now ) ) );
+	deadlines_[ index ] = toMillis( next );
+	if( scheduleOf( index ).getKind( ) == Schedule::Kind::Calendar )
+		durations_[ index ] = deadlines_[ index ] - now;
+}
+
+const Schedule& TimerStore::scheduleOf( std::size_t index ) const noexcept
+{
+	return *schedulePool_[ items_[ index ] ];
+}
+
+TimerStore::ItemHandle TimerStore::internItem( const Item& item )
+{
+	auto hash = ItemSchema::hash( item );
+	auto [first, last] = itemIndex_.equal_range( hash );
+	for( auto entry = first; entry != last; ++entry ) {
+		if( itemPool_[ entry->second ] == item ) {
+			++itemRefCounts_[ entry->second ];
+			return entry->second;
+		}
+	}
+
+	ItemHandle handle;
+	if( !freeItems_.empty( ) ) {
+		handle = freeItems_.back( );
+		freeItems_.pop_back( );
+		itemPool_[ handle ] = item;
+		schedulePool_[ handle ] = Schedule::parse( item.getSchedule( ) );
+		itemTypes_[ handle ] = typeIndexOf( item.getType( ) );
+		itemRefCounts_[ handle ] = 1;
+	}
+	else {
+		// An item without a valid schedule runs once
+		itemPool_.push_back( item );
+		schedulePool_.push_back( Schedule::parse( item.getSchedule( ) ) );
+		itemTypes_.push_back( typeIndexOf( item.getType( ) ) );
+		itemRefCounts_.push_back( 1 );
+		handle = static_cast< ItemHandle >( itemPool_.size( ) - 1 );
+	}
+
+	itemIndex_.emplace( hash, handle );
+	return handle;
+}
+
+void TimerStore::releaseItem( ItemHandle handle ) noexcept
+{
+	if( --itemRefCounts_[ handle ] == 0 ) {
+		auto [first, last] = itemIndex_.equal_range( ItemSchema::hash( itemPool_[ handle ] ) );
+		for( auto entry = first; entry != last; ++entry ) {
+			if( entry->second == handle ) {
+				itemIndex_.erase( entry );
+				break;
+			}
+		}
+
+		itemPool_[ handle ] = Item( );
+		schedulePool_[ handle ].reset( );
+		freeItems_.push_back( handle );
+	}
+}
+
+std::uint32_t TimerStore::typeIndexOf( std::string_view type )
+{
+	// Types are few and entries are kept once created
+	auto [found, inserted] = typeIndices_.try_emplace( std::string( type ), static_cast< std::uint32_t >( typeEntries_.size( ) ) );
+	if( inserted )
+		typeEntries_.emplace_back( );
+	return found->second;
+}
+
+TimerStore::CompletionAwaiter::CompletionAwaiter( TimerStore& store, TimerId id ) noexcept
+	: store_( store ),
+	id_( id )
+{
+}
+
+bool TimerStore::CompletionAwaiter::await_ready( ) noexcept
+{
+	if( !store_.contains( id_ ) ) {
+		cancelled = true;
+		return true;
+	}
+	return store_.isCompleted( id_ );
+}
+
+void TimerStore::CompletionAwaiter::await_suspend( std::coroutine_handle<> awaiting ) noexcept
+{
+	handle = awaiting;
+	store_.waiters_[ id_ ].pushBack( *this );
+}
+
+bool TimerStore::CompletionAwaiter::await_resume( ) const noexcept
+{
+	return !cancelled;
+}
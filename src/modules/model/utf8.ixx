@@ -0,0 +1,38 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.utf8;
+
+import <cstddef>;
+import <string_view>;
+
+// Get the length of the longest prefix of text within maxBytes that does not split a UTF-8 sequence
+export [[nodiscard]] std::size_t utf8Prefix( std::string_view text, std::size_t maxBytes ) noexcept;
+
+// Implementation
+std::size_t utf8Prefix( std::string_view text, std::size_t maxBytes ) noexcept
+{
+	if( text.size( ) <= maxBytes )
+		return text.size( );
+
+	// Back off over continuation bytes to the lead byte of the sequence that does not fit
+	auto length = maxBytes;
+	while( length > 0 && ( static_cast< unsigned char >( text[ length ] ) & 0xC0 ) == 0x80 )
+		--length;
+	return length;
+}
@@ -0,0 +1,159 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module model.waiter_list;
+
+import <coroutine>;
+
+export class WaiterList;
+
+/**
+ * @brief Intrusive node for a suspended coroutine waiting on some event
+ *
+ * Lives inside the awaiter, so waiting never allocates. A node unlinks
+ * itself when destroyed, which happens when its coroutine is destroyed.
+ */
+export struct Waiter
+{
+	Waiter( ) = default;
+	Waiter( const Waiter& ) = delete;
+	Waiter& operator=( const Waiter& ) = delete;
+
+	// Destructor - unlinks the node from its list
+	~Waiter( );
+
+	std::coroutine_handle<> handle;
+	bool cancelled = false;
+
+	// Links, maintained by WaiterList
+	Waiter* prev = nullptr;
+	Waiter* next = nullptr;
+	WaiterList* list = nullptr;
+};
+
+/**
+ * @brief FIFO list of waiters linked through their own nodes
+ *
+ * Nodes point back at the list, so a list must not move while it holds any.
+ * Destroying a list orphans its nodes; they are then never resumed.
+ */
+export class WaiterList
+{
+public:
+	WaiterList( ) = default;
+	WaiterList( const WaiterList& ) = delete;
+	WaiterList& operator=( const WaiterList& ) = delete;
+
+	// Destructor - orphans remaining nodes
+	~WaiterList( );
+
+	// Append a node that is not in any list
+	void pushBack( Waiter& waiter ) noexcept;
+
+	// Unlink a node from this list
+	void remove( Waiter& waiter ) noexcept;
+
+	// Unlink and return the first node, nullptr if empty
+	Waiter* popFront( ) noexcept;
+
+	// Move every node of other to the end of this list, marking it cancelled or not
+	void takeAll( WaiterList& other, bool cancelled ) noexcept;
+
+	// Resume nodes in order until the list is empty; each is unlinked before its resumption
+	void resumeAll( );
+
+	// Check if no node is linked
+	[[nodiscard]] bool empty( ) const noexcept;
+
+private:
+	Waiter* head_ = nullptr;
+	Waiter* tail_ = nullptr;
+};
+
+// Implementation
+Waiter::~Waiter( )
+{
+	if( list )
+		list->remove( *this );
+}
+
+WaiterList::~WaiterList( )
+{
+	for( auto* waiter = head_; waiter; ) {
+		auto* next = waiter->next;
+		waiter->prev = waiter->next = nullptr;
+		waiter->list = nullptr;
+		waiter = next;
+	}
+}
+
+void WaiterList::pushBack( Waiter& waiter ) noexcept
+{
+	waiter.prev = tail_;
+	waiter.next = nullptr;
+	waiter.list = this;
+	if( tail_ )
+		tail_->next = &waiter;
+	else
+		head_ = &waiter;
+	tail_ = &waiter;
+}
+
+void WaiterList::remove( Waiter& waiter ) noexcept
+{
+	if( waiter.prev )
+		waiter.prev->next = waiter.next;
+	else
+		head_ = waiter.next;
+
+	if( waiter.next )
+		waiter.next->prev = waiter.prev;
+	else
+		tail_ = waiter.prev;
+
+	waiter.prev = waiter.next = nullptr;
+	waiter.list = nullptr;
+}
+
+Waiter* WaiterList::popFront( ) noexcept
+{
+	auto* waiter = head_;
+	if( waiter )
+		remove( *waiter );
+	return waiter;
+}
+
+void WaiterList::takeAll( WaiterList& other, bool cancelled ) noexcept
+{
+	while( auto* waiter = other.popFront( ) ) {
+		waiter->cancelled = cancelled;
+		pushBack( *waiter );
+	}
+}
+
+void WaiterList::resumeAll( )
+{
+	// A resumed coroutine may destroy or add waiters, so pop one at a time
+	while( auto* waiter = popFront( ) )
+		waiter->handle.resume( );
+}
+
+bool WaiterList::empty( ) const noexcept
+{
+	return head_ == nullptr;
+}
@@ -0,0 +1,102 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+import view.archive_dialog;
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+	// Format milliseconds since epoch as local date and time
+	wxString formatMillis( std::int64_t millis )
+	{
+		std::time_t time = static_cast< std::time_t >( millis / 1000 );
+		std::stringstream ss;
+		ss << std::put_time( std::localtime( &time ), "%Y-%m-%d %H:%M:%S" );
+		return ss.str( );
+	}
+}
+
+ArchiveDialog::ArchiveDialog( wxWindow* parent, const CompletionArchive& archive )
+	: archive_( archive )
+{
+	dialog_ = new wxDialog( parent, wxID_ANY, "Archived Timers", wxDefaultPosition, wxSize( 640, 400 ),
+		wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER );
+
+	createControls( );
+
+	// Center the dialog
+	dialog_->CenterOnParent( );
+}
+
+void ArchiveDialog::showDialog( )
+{
+	updateList( );
+	dialog_->ShowModal( );
+}
+
+void ArchiveDialog::createControls( )
+{
+	auto* mainSizer = new wxBoxSizer( wxVERTICAL );
+
+	// Create a list control
+	listCtrl_ = new wxListCtrl( dialog_, wxID_ANY, wxDefaultPosition, wxDefaultSize,
+		wxLC_REPORT | wxLC_SINGLE_SEL );
+	listCtrl_->AppendColumn( "Name" );
+	listCtrl_->AppendColumn( "Started" );
+	listCtrl_->AppendColumn( "Completed" );
+	listCtrl_->AppendColumn( "Duration" );
+	mainSizer->Add( listCtrl_, 1, wxEXPAND | wxALL, 10 );
+
+	auto* buttonSizer = new wxBoxSizer( wxHORIZONTAL );
+	summaryText_ = new wxStaticText( dialog_, wxID_ANY, wxEmptyString );
+	buttonSizer->Add( summaryText_, 0, wxALIGN_CENTER_VERTICAL );
+	buttonSizer->AddStretchSpacer( );
+	buttonSizer->Add( new wxButton( dialog_, wxID_CANCEL, "Close" ), 0 );
+	mainSizer->Add( buttonSizer, 0, wxEXPAND | wxBOTTOM | wxLEFT | wxRIGHT, 10 );
+
+	dialog_->SetSizer( mainSizer );
+}
+
+void ArchiveDialog::updateList( )
+{
+	listCtrl_->DeleteAllItems( );
+
+	// Newest first
+	auto count = archive_.size( );
+	for( std::size_t i = 0; i < count; ++i ) {
+		const auto& run = archive_[ count - 1 - i ];
+		auto seconds = static_cast< long >( ( run.completedAt - run.startedAt ) / 1000 );
+
+		long index = listCtrl_->InsertItem( static_cast< long >( i ), wxString::FromUTF8( run.getName( ).data( ), run.getName( ).size( ) ) );
+		listCtrl_->SetItem( index, 1, formatMillis( run.startedAt ) );
+		listCtrl_->SetItem( index, 2, formatMillis( run.completedAt ) );
+		listCtrl_->SetItem( index, 3, wxString::Format( "%02ld:%02ld", seconds / 60, seconds % 60 ) );
+	}
+
+	for( int i = 0; i < 4; ++i )
+		listCtrl_->SetColumnWidth( i, wxLIST_AUTOSIZE_USEHEADER );
+
+	summaryText_->SetLabel( wxString::Format( "Showing the last %zu of %llu archived timers", count,
+		static_cast< unsigned long long >( archive_.getTotalCount( ) ) ) );
+}
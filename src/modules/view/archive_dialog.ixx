@@ -0,0 +1,52 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module view.archive_dialog;
+
+import model.completion_archive;
+
+import <wx/wx.h>;
+import <wx/dialog.h>;
+import <wx/listctrl.h>;
+
+/**
+ * @brief Dialog listing completed timers that retention moved out of the active list
+ */
+export class ArchiveDialog
+{
+public:
+	// Constructor
+	ArchiveDialog( wxWindow* parent, const CompletionArchive& archive );
+
+	// Show the dialog modally
+	void showDialog( );
+
+private:
+	void createControls( );
+	void updateList( );
+
+	// UI Controls
+	wxDialog* dialog_ = nullptr;
+	wxListCtrl* listCtrl_ = nullptr;
+	wxStaticText* summaryText_ = nullptr;
+
+	// Data
+	const CompletionArchive& archive_;
+};
+
+// Implementation will be in separate file due to wxWidgets dependencies
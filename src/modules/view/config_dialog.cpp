@@ -17,6 +17,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 import view.config_dialog;
+import model.schedule;
 
 #include <wx/wx.h>
 #include <wx/spinctrl.h>
@@ -44,22 +45,22 @@ void ConfigDialog::createControls( )
 {
 	// Create a flexible grid sizer for form layout
 	auto* mainSizer = new wxBoxSizer( wxVERTICAL );
-	auto* formSizer = new wxFlexGridSizer( 4, 2, 10, 10 );
+	auto* formSizer = new wxFlexGridSizer( 5, 2, 10, 10 );
 	formSizer->AddGrowableCol( 1 );
 
 	// Name
 	formSizer->Add( new wxStaticText( dialog_, wxID_ANY, "Name:" ), 0 );
-	nameCtrl_ = new wxTextCtrl( dialog_, wxID_ANY, originalItem_.getName( ) );
+	nameCtrl_ = new wxTextCtrl( dialog_, wxID_ANY, std::string( originalItem_.getName( ) ) );
 	formSizer->Add( nameCtrl_, 1, wxEXPAND );
 
 	// Type
 	formSizer->Add( new wxStaticText( dialog_, wxID_ANY, "Type:" ), 0 );
-	typeCtrl_ = new wxTextCtrl( dialog_, wxID_ANY, originalItem_.getType( ) );
+	typeCtrl_ = new wxTextCtrl( dialog_, wxID_ANY, std::string( originalItem_.getType( ) ) );
 	formSizer->Add( typeCtrl_, 1, wxEXPAND );
 
 	// Action
 	formSizer->Add( new wxStaticText( dialog_, wxID_ANY, "Action:" ), 0 );
-	actionCtrl_ = new wxTextCtrl( dialog_, wxID_ANY, originalItem_.getAction( ) );
+	actionCtrl_ = new wxTextCtrl( dialog_, wxID_ANY, std::string( originalItem_.getAction( ) ) );
 	formSizer->Add( actionCtrl_, 1, wxEXPAND );
 
 	// Timeout
@@ -68,6 +69,12 @@ void ConfigDialog::createControls( )
 		wxSP_ARROW_KEYS, 1, 86400, originalItem_.getTimeout( ) );
 	formSizer->Add( timeoutCtrl_, 1, wxEXPAND );
 
+	// Schedule
+	formSizer->Add( new wxStaticText( dialog_, wxID_ANY, "Schedule:" ), 0 );
+	scheduleCtrl_ = new wxTextCtrl( dialog_, wxID_ANY, std::string( originalItem_.getSchedule( ) ) );
+	scheduleCtrl_->SetHint( "e.g. every 30m, weekdays 09:00" );
+	formSizer->Add( scheduleCtrl_, 1, wxEXPAND );
+
 	mainSizer->Add( formSizer, 1, wxEXPAND | wxALL, 10 );
 
 	// Button sizer
@@ -79,7 +86,19 @@ void ConfigDialog::createControls( )
 
 void ConfigDialog::bindEvents( )
 {
-	// The default OK/Cancel buttons are already bound
+	// Keep the dialog open until the schedule is valid; Cancel is handled by default
+	dialog_->Bind( wxEVT_BUTTON, [this]( wxCommandEvent& event )
+		{
+			auto schedule = scheduleCtrl_->GetValue( ).ToStdString( );
+			if( schedule.empty( ) || Schedule::parse( schedule ) ) {
+				event.Skip( );
+				return;
+			}
+			wxMessageBox( "Invalid schedule '" + schedule + "'.\n\n"
+				"Use an interval such as 'every 90s' or 'every 1h30m', or days and times such as "
+				"'09:00', 'weekdays 09:00 17:30' or 'mon,thu *:15'.",
+				"Configure Item", wxOK | wxICON_WARNING, dialog_ );
+		}, wxID_OK );
 }
 
 Item ConfigDialog::getModifiedItem( ) const
@@ -91,5 +110,6 @@ Item ConfigDialog::getModifiedItem( ) const
 		.withName( nameCtrl_->GetValue( ).ToStdString( ) )
 		.withType( typeCtrl_->GetValue( ).ToStdString( ) )
 		.withAction( actionCtrl_->GetValue( ).ToStdString( ) )
-		.withTimeout( timeoutCtrl_->GetValue( ) );
+		.withTimeout( timeoutCtrl_->GetValue( ) )
+		.withSchedule( scheduleCtrl_->GetValue( ).ToStdString( ) );
 }
@@ -50,6 +50,7 @@ private:
 	wxTextCtrl* typeCtrl_ = nullptr;
 	wxTextCtrl* actionCtrl_ = nullptr;
 	wxSpinCtrl* timeoutCtrl_ = nullptr;
+	wxTextCtrl* scheduleCtrl_ = nullptr;
 
 	// Original and modified item
 	Item originalItem_;
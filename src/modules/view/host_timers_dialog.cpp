@@ -0,0 +1,139 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+import view.host_timers_dialog;
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include <algorithm>
+#include <chrono>
+
+HostTimersDialog::HostTimersDialog( wxWindow* parent, SharedTimerTable& table )
+	: table_( table )
+{
+	dialog_ = new wxDialog( parent, wxID_ANY, "Host Timers", wxDefaultPosition, wxSize( 640, 400 ),
+		wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER );
+	timer_ = new wxTimer( dialog_, TIMER_ID );
+
+	createControls( );
+	bindEvents( );
+
+	// Center the dialog
+	dialog_->CenterOnParent( );
+}
+
+void HostTimersDialog::showDialog( )
+{
+	// Drop timers left behind by processes that exited without cleaning up
+	table_.reapDeadOwners( );
+	updateList( );
+
+	// Remaining times change every second while the dialog is shown
+	timer_->Start( 1000 );
+	dialog_->ShowModal( );
+	timer_->Stop( );
+}
+
+void HostTimersDialog::createControls( )
+{
+	auto* mainSizer = new wxBoxSizer( wxVERTICAL );
+
+	// Create a list control
+	listCtrl_ = new wxListCtrl( dialog_, wxID_ANY, wxDefaultPosition, wxDefaultSize,
+		wxLC_REPORT | wxLC_SINGLE_SEL );
+	listCtrl_->AppendColumn( "Process" );
+	listCtrl_->AppendColumn( "Name" );
+	listCtrl_->AppendColumn( "Type" );
+	listCtrl_->AppendColumn( "State" );
+	listCtrl_->AppendColumn( "Remaining" );
+	mainSizer->Add( listCtrl_, 1, wxEXPAND | wxALL, 10 );
+
+	// Command buttons
+	auto* buttonSizer = new wxBoxSizer( wxHORIZONTAL );
+	auto* startButton = new wxButton( dialog_, wxID_ANY, "Start" );
+	auto* stopButton = new wxButton( dialog_, wxID_ANY, "Stop" );
+	auto* resetButton = new wxButton( dialog_, wxID_ANY, "Reset" );
+	startButton->Bind( wxEVT_BUTTON, [this]( wxCommandEvent& ) { postCommand( SharedTimerCommand::Start ); } );
+	stopButton->Bind( wxEVT_BUTTON, [this]( wxCommandEvent& ) { postCommand( SharedTimerCommand::Stop ); } );
+	resetButton->Bind( wxEVT_BUTTON, [this]( wxCommandEvent& ) { postCommand( SharedTimerCommand::Reset ); } );
+	buttonSizer->Add( startButton, 0, wxRIGHT, 5 );
+	buttonSizer->Add( stopButton, 0, wxRIGHT, 5 );
+	buttonSizer->Add( resetButton, 0 );
+	buttonSizer->AddStretchSpacer( );
+	buttonSizer->Add( new wxButton( dialog_, wxID_CANCEL, "Close" ), 0 );
+	mainSizer->Add( buttonSizer, 0, wxEXPAND | wxBOTTOM | wxLEFT | wxRIGHT, 10 );
+
+	dialog_->SetSizer( mainSizer );
+}
+
+void HostTimersDialog::bindEvents( )
+{
+	dialog_->Bind( wxEVT_TIMER, &HostTimersDialog::onTimer, this, TIMER_ID );
+}
+
+void HostTimersDialog::updateList( )
+{
+	using std::chrono::duration_cast;
+	using std::chrono::milliseconds;
+
+	// Keep the selection on the same slot across refreshes
+	long selected = listCtrl_->GetNextItem( -1, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED );
+	long selectedSlot = selected >= 0 ? static_cast< long >( listCtrl_->GetItemData( selected ) ) : -1;
+
+	entries_ = table_.snapshot( );
+	listCtrl_->DeleteAllItems( );
+
+	auto now = duration_cast< milliseconds >( std::chrono::system_clock::now( ).time_since_epoch( ) ).count( );
+	for( size_t i = 0; i < entries_.size( ); ++i ) {
+		const auto& entry = entries_[ i ];
+		const auto& state = entry.state;
+
+		wxString stateText = state.completed ? "Completed" : state.running ? "Running" : state.queued ? "Queued" : "Paused";
+		auto remaining = state.running ? std::max< long long >( state.deadline - now, 0 ) : state.remaining;
+		auto seconds = static_cast< long >( ( remaining + 999 ) / 1000 );
+
+		long index = listCtrl_->InsertItem( i, wxString::Format( "%d", entry.ownerPid ) );
+		listCtrl_->SetItem( index, 1, wxString::FromUTF8( state.name ) );
+		listCtrl_->SetItem( index, 2, wxString::FromUTF8( state.type ) );
+		listCtrl_->SetItem( index, 3, stateText );
+		listCtrl_->SetItem( index, 4, wxString::Format( "%02ld:%02ld", seconds / 60, seconds % 60 ) );
+		listCtrl_->SetItemData( index, entry.slot );
+
+		if( static_cast< long >( entry.slot ) == selectedSlot )
+			listCtrl_->SetItemState( index, wxLIST_STATE_SELECTED, wxLIST_STATE_SELECTED );
+	}
+
+	for( int i = 0; i < 5; ++i )
+		listCtrl_->SetColumnWidth( i, wxLIST_AUTOSIZE_USEHEADER );
+}
+
+void HostTimersDialog::postCommand( SharedTimerCommand command )
+{
+	long selected = listCtrl_->GetNextItem( -1, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED );
+	if( selected < 0 || static_cast< size_t >( selected ) >= entries_.size( ) )
+		return;
+
+	const auto& entry = entries_[ selected ];
+	if( !table_.postCommand( entry.slot, entry.generation, command ) )
+		wxBell( ); // Timer is gone or a command is still pending
+}
+
+void HostTimersDialog::onTimer( wxTimerEvent& event )
+{
+	updateList( );
+}
@@ -0,0 +1,68 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+export module view.host_timers_dialog;
+
+import model.shared_timer_table;
+import <vector>;
+
+import <wx/wx.h>;
+import <wx/dialog.h>;
+import <wx/listctrl.h>;
+import <wx/timer.h>;
+
+/**
+ * @brief Dialog listing the timers of every Ticks process on this host
+ *
+ * Rows are read straight from the shared table; the buttons post commands
+ * that the owning process applies on its next poll.
+ */
+export class HostTimersDialog
+{
+public:
+	// Constructor
+	HostTimersDialog( wxWindow* parent, SharedTimerTable& table );
+
+	// Show the dialog modally
+	void showDialog( );
+
+private:
+	// Timer ID for refreshing the list while the dialog is shown
+	static constexpr int TIMER_ID = 1101;
+
+	void createControls( );
+	void bindEvents( );
+	void updateList( );
+
+	// Post a command for the selected timer
+	void postCommand( SharedTimerCommand command );
+
+	// Event handlers
+	void onTimer( wxTimerEvent& event );
+
+	// UI Controls
+	wxDialog* dialog_ = nullptr;
+	wxListCtrl* listCtrl_ = nullptr;
+	wxTimer* timer_ = nullptr;
+
+	// Data
+	SharedTimerTable& table_;
+	std::vector<SharedTimerEntry> entries_;
+};
+
+// Implementation will be in separate file due to wxWidgets dependencies
@@ -18,22 +18,25 @@
  */
 import view.left_panel;
 import model.item;
+import model.item_schema;
 
 #include <wx/wx.h>
 #include <wx/listctrl.h>
 #include <wx/dnd.h>
 #include <algorithm>
 #include <ranges>
+#include <string>
 
 wxDEFINE_EVENT( EVT_ITEM_DRAG_BEGIN, wxCommandEvent );
 
-// Custom data object for drag and drop
+// Custom data object for drag and drop, carrying the item in its binary form
 class ItemDataObject : public wxDataObject
 {
 public:
 	explicit ItemDataObject( const Item& item = Item( ) )
 		: item_( item )
 	{
+		ItemSchema::encode( item_, bytes_ );
 	}
 
 	[[nodiscard]] const Item& getItem( ) const
@@ -49,23 +52,22 @@ public:
 
 	size_t GetDataSize( const wxDataFormat& ) const override
 	{
-		// This is a simplified implementation - in a real app, you'd serialize the item
-		return sizeof( Item* );
+		return bytes_.size( );
 	}
 
 	bool GetDataHere( const wxDataFormat&, void* buf ) const override
 	{
-		// This is a simplified implementation - in a real app, you'd serialize the item
-		*static_cast< Item** >( buf ) = const_cast< Item* >( &item_ );
+		std::copy( bytes_.begin( ), bytes_.end( ), static_cast< char* >( buf ) );
 		return true;
 	}
 
 	bool SetData( const wxDataFormat&, size_t len, const void* buf ) override
 	{
-		// This is a simplified implementation - in a real app, you'd deserialize the item
-		if( len != sizeof( Item* ) )
+		auto item = ItemSchema::decode( std::string_view( static_cast< const char* >( buf ), len ) );
+		if( !item )
 			return false;
-		item_ = **static_cast< Item* const* >( buf );
+		item_ = std::move( *item );
+		bytes_.assign( static_cast< const char* >( buf ), len );
 		return true;
 	}
 #if 0
@@ -83,6 +85,7 @@ public:
 
 private:
 	Item item_;
+	std::string bytes_;
 };
 
 // Custom drop source for initiating drag
@@ -119,11 +122,11 @@ void LeftPanel::createControls( )
 	listCtrl_ = new wxListCtrl( panel_, wxID_ANY, wxDefaultPosition, wxDefaultSize,
 		wxLC_REPORT | wxLC_SINGLE_SEL );
 
-	// Add columns
-	listCtrl_->AppendColumn( "Name" );
-	listCtrl_->AppendColumn( "Type" );
-	listCtrl_->AppendColumn( "Action" );
-	listCtrl_->AppendColumn( "Timeout" );
+	// Add a column per item field
+	ItemSchema::forEachColumn( [this]( std::size_t, std::string_view label )
+		{
+			listCtrl_->AppendColumn( wxString( label.data( ), label.size( ) ) );
+		} );
 
 	// Add the list to the sizer
 	sizer->Add( listCtrl_, 1, wxEXPAND | wxALL, 5 );
@@ -141,7 +144,8 @@ void LeftPanel::bindEvents( )
 
 void LeftPanel::loadItems( const Config& config )
 {
-	items_ = config.getItems( );
+	const auto items = config.getItems( );
+	items_.assign( items.begin( ), items.end( ) );
 	updateList( );
 }
 
@@ -159,17 +163,18 @@ void LeftPanel::updateList( )
 	for( size_t i = 0; i < items_.size( ); ++i ) {
 		const auto& item = items_[ i ];
 
-		long index = listCtrl_->InsertItem( i, item.getName( ) );
-		listCtrl_->SetItem( index, 1, item.getType( ) );
-		listCtrl_->SetItem( index, 2, item.getAction( ) );
-		listCtrl_->SetItem( index, 3, wxString::Format( "%d", item.getTimeout( ) ) );
+		long index = listCtrl_->InsertItem( i, wxEmptyString );
+		ItemSchema::formatColumns( item, [this, index]( std::size_t column, std::string_view text )
+			{
+				listCtrl_->SetItem( index, static_cast< int >( column ), wxString( text.data( ), text.size( ) ) );
+			} );
 
 		// Store the item index for later retrieval
 		listCtrl_->SetItemData( index, i );
 	}
 
 	// Resize columns
-	for( int i = 0; i < 4; ++i )
+	for( int i = 0; i < static_cast< int >( ItemSchema::FIELD_COUNT ); ++i )
 		listCtrl_->SetColumnWidth( i, wxLIST_AUTOSIZE_USEHEADER );
 }
 
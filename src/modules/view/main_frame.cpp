@@ -17,22 +17,43 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 import view.main_frame;
+import view.host_timers_dialog;
+import view.archive_dialog;
 
 #include <wx/wx.h>
 #include <wx/splitter.h>
 #include <wx/filedlg.h>
+#include <wx/choicdlg.h>
 #include <wx/msgdlg.h>
+#include <wx/stdpaths.h>
 
 enum
 {
 	ID_OPEN_CONFIG = wxID_HIGHEST + 1,
-	ID_SAVE_CONFIG
+	ID_SAVE_CONFIG,
+	ID_HOST_TIMERS,
+	ID_ARCHIVED_TIMERS,
+	ID_START_SELECTED,
+	ID_STOP_SELECTED,
+	ID_RESET_SELECTED,
+	ID_REMOVE_SELECTED,
+	ID_STOP_RUNNING,
+	ID_RESET_COMPLETED,
+	ID_REMOVE_COMPLETED,
+	ID_STOP_TYPE
 };
 
 MainFrame::MainFrame( const wxString& title, const wxPoint& pos, const wxSize& size )
 {
 	frame_ = new wxFrame( nullptr, wxID_ANY, title, pos, size );
 
+	// Saves complete on the writer thread; hand the result back to the UI thread
+	configWriter_ = std::make_unique<ConfigWriter>(
+		[this]( const std::filesystem::path& filePath, bool saved )
+		{
+			frame_->CallAfter( [this, filePath, saved]( ) { onConfigSaved( filePath, saved ); } );
+		} );
+
 	createControls( );
 	bindEvents( );
 }
@@ -55,6 +76,26 @@ void MainFrame::createControls( )
 	fileMenu->Append( wxID_EXIT );
 	menuBar->Append( fileMenu, "&File" );
 
+	// View menu; host timers need the shared table
+	auto* viewMenu = new wxMenu;
+	viewMenu->Append( ID_HOST_TIMERS, "&Host Timers...\tCtrl+H" );
+	viewMenu->Enable( ID_HOST_TIMERS, false );
+	viewMenu->Append( ID_ARCHIVED_TIMERS, "&Archived Timers..." );
+	menuBar->Append( viewMenu, "&View" );
+
+	// Timers menu; selected rows first, then whole groups of timers
+	auto* timersMenu = new wxMenu;
+	timersMenu->Append( ID_START_SELECTED, "S&tart Selected\tCtrl+T" );
+	timersMenu->Append( ID_STOP_SELECTED, "Sto&p Selected\tCtrl+P" );
+	timersMenu->Append( ID_RESET_SELECTED, "&Reset Selected\tCtrl+R" );
+	timersMenu->Append( ID_REMOVE_SELECTED, "Re&move Selected" );
+	timersMenu->AppendSeparator( );
+	timersMenu->Append( ID_STOP_RUNNING, "Stop All &Running" );
+	timersMenu->Append( ID_RESET_COMPLETED, "Reset All &Completed" );
+	timersMenu->Append( ID_REMOVE_COMPLETED, "Remove All C&ompleted" );
+	timersMenu->Append( ID_STOP_TYPE, "Stop All of &Type..." );
+	menuBar->Append( timersMenu, "&Timers" );
+
 	// Help menu
 	auto* helpMenu = new wxMenu;
 	helpMenu->Append( wxID_ABOUT );
@@ -69,9 +110,13 @@ void MainFrame::createControls( )
 	// Create splitter window
 	splitter_ = new wxSplitterWindow( frame_, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxSP_3D | wxSP_LIVE_UPDATE );
 
+	// Open run history from the user data directory
+	auto dataDir = std::filesystem::path( wxStandardPaths::Get( ).GetUserDataDir( ).ToStdString( ) );
+	runHistory_ = std::make_unique<RunHistory>( dataDir / "run_history.bin" );
+
 	// Create panels
 	leftPanel_ = std::make_unique<LeftPanel>( splitter_ );
-	rightPanel_ = std::make_unique<RightPanel>( splitter_ );
+	rightPanel_ = std::make_unique<RightPanel>( splitter_, runHistory_.get( ) );
 
 	// Split the window
 	splitter_->SplitVertically( leftPanel_->getPanel( ), rightPanel_->getPanel( ) );
@@ -86,12 +131,34 @@ void MainFrame::bindEvents( )
 	frame_->Bind( wxEVT_MENU, &MainFrame::onExit, this, wxID_EXIT );
 	frame_->Bind( wxEVT_MENU, &MainFrame::onOpenConfig, this, ID_OPEN_CONFIG );
 	frame_->Bind( wxEVT_MENU, &MainFrame::onSaveConfig, this, ID_SAVE_CONFIG );
+	frame_->Bind( wxEVT_MENU, &MainFrame::onHostTimers, this, ID_HOST_TIMERS );
+	frame_->Bind( wxEVT_MENU, &MainFrame::onArchivedTimers, this, ID_ARCHIVED_TIMERS );
+	frame_->Bind( wxEVT_MENU, &MainFrame::onTimersMenu, this, ID_START_SELECTED, ID_STOP_TYPE );
+
+	// Bind frame events
+	frame_->Bind( wxEVT_CLOSE_WINDOW, &MainFrame::onClose, this );
+	frame_->Bind( wxEVT_ICONIZE, &MainFrame::onIconize, this );
 }
 
-void MainFrame::initialize( const Config& config )
+void MainFrame::initialize( const LoadedConfig& config )
 {
-	// Load items into left panel
-	leftPanel_->loadItems( config );
+	// Load root and fragment items into left panel
+	leftPanel_->loadItems( config.merged );
+
+	// Apply concurrency budgets to the active timers
+	rightPanel_->setResourceClasses( config.merged.getResourceClasses( ), config.merged.getMaxConcurrent( ) );
+	rightPanel_->setRetention( config.merged.getRetention( ) );
+
+	// Keep the root document for saving; fragment items stay in their own files
+	config_ = config.root;
+	configPath_ = config.rootPath;
+}
+
+void MainFrame::setSharedTable( std::unique_ptr<SharedTimerTable> sharedTable )
+{
+	sharedTable_ = std::move( sharedTable );
+	rightPanel_->setSharedTable( sharedTable_.get( ) );
+	frame_->GetMenuBar( )->Enable( ID_HOST_TIMERS, sharedTable_ != nullptr );
 }
 
 void MainFrame::onAbout( wxCommandEvent& event )
@@ -115,13 +182,11 @@ void MainFrame::onOpenConfig( wxCommandEvent& event )
 		return;
 	}
 
-	// Get the file path
-	configPath_ = openDialog.GetPath( ).ToStdString( );
-
 	// Load the configuration
-	auto config = Config::loadFromYaml( configPath_ );
+	auto config = loadConfig( openDialog.GetPath( ).ToStdString( ) );
 	if( !config ) {
-		wxMessageBox( "Failed to load configuration.", "Error", wxOK | wxICON_ERROR );
+		wxMessageBox( "Failed to load configuration:\n\n" + formatDiagnostics( configLoader_.getDiagnostics( ) ), "Error",
+			wxOK | wxICON_ERROR );
 		return;
 	}
 
@@ -132,6 +197,35 @@ void MainFrame::onOpenConfig( wxCommandEvent& event )
 	frame_->SetStatusText( "Configuration loaded from: " + openDialog.GetPath( ) );
 }
 
+std::optional<LoadedConfig> MainFrame::loadConfig( const std::filesystem::path& filePath )
+{
+	auto config = configLoader_.load( filePath );
+	const auto& diagnostics = configLoader_.getDiagnostics( );
+	if( !config || diagnostics.empty( ) )
+		return config;
+
+	wxMessageBox( wxString::Format( "The configuration was loaded with %zu problem(s):\n\n", diagnostics.size( ) ) +
+		formatDiagnostics( diagnostics ), "Configuration", wxOK | wxICON_WARNING );
+	return config;
+}
+
+wxString MainFrame::formatDiagnostics( const std::vector<ConfigDiagnostic>& diagnostics )
+{
+	// List the first few problems; the rest only by count
+	constexpr std::size_t MAX_LISTED = 10;
+	wxString message;
+	for( std::size_t i = 0; i < diagnostics.size( ) && i < MAX_LISTED; ++i ) {
+		const auto& diagnostic = diagnostics[ i ];
+		message += wxString( diagnostic.filePath.string( ) );
+		if( diagnostic.line > 0 )
+			message += wxString::Format( ":%d:%d", diagnostic.line, diagnostic.column );
+		message += ": " + wxString( diagnostic.message ) + "\n";
+	}
+	if( diagnostics.size( ) > MAX_LISTED )
+		message += wxString::Format( "... and %zu more\n", diagnostics.size( ) - MAX_LISTED );
+	return message;
+}
+
 void MainFrame::onSaveConfig( wxCommandEvent& event )
 {
 	// Show file dialog
@@ -145,15 +239,94 @@ void MainFrame::onSaveConfig( wxCommandEvent& event )
 	// Get the file path
 	auto savePath = saveDialog.GetPath( ).ToStdString( );
 
-	// Create configuration from left panel items
-	Config config( leftPanel_->getItems( ) );
+	// Hand an immutable snapshot of the root document, includes and all, to the background writer;
+	// includes are relative to the file, so they follow it to its new directory
+	auto snapshot = ConfigLoader::rebaseIncludes( config_, configPath_.parent_path( ), std::filesystem::path( savePath ).parent_path( ) );
+	configWriter_->requestSave( std::make_shared<const Config>( std::move( snapshot ) ), savePath );
+
+	// Update status
+	frame_->SetStatusText( "Saving configuration to: " + saveDialog.GetPath( ) );
+}
+
+void MainFrame::onClose( wxCloseEvent& event )
+{
+	// Make sure queued saves reach the disk before the frame goes away
+	configWriter_->flush( );
+	event.Skip( );
+}
+
+void MainFrame::onHostTimers( wxCommandEvent& event )
+{
+	if( !sharedTable_ )
+		return;
+
+	HostTimersDialog dialog( frame_, *sharedTable_ );
+	dialog.showDialog( );
+}
+
+void MainFrame::onArchivedTimers( wxCommandEvent& event )
+{
+	ArchiveDialog dialog( frame_, rightPanel_->getArchive( ) );
+	dialog.showDialog( );
+}
+
+void MainFrame::onTimersMenu( wxCommandEvent& event )
+{
+	using TimerAction = RightPanel::TimerAction;
+
+	switch( event.GetId( ) ) {
+		case ID_START_SELECTED:
+			rightPanel_->applyToSelection( TimerAction::Start );
+			break;
+		case ID_STOP_SELECTED:
+			rightPanel_->applyToSelection( TimerAction::Stop );
+			break;
+		case ID_RESET_SELECTED:
+			rightPanel_->applyToSelection( TimerAction::Reset );
+			break;
+		case ID_REMOVE_SELECTED:
+			rightPanel_->applyToSelection( TimerAction::Remove );
+			break;
+		case ID_STOP_RUNNING:
+			rightPanel_->applyToMatching( TimerAction::Stop, TimerSelector( ).withState( TimerState::Running ) );
+			break;
+		case ID_RESET_COMPLETED:
+			rightPanel_->applyToMatching( TimerAction::Reset, TimerSelector( ).withState( TimerState::Completed ) );
+			break;
+		case ID_REMOVE_COMPLETED:
+			rightPanel_->applyToMatching( TimerAction::Remove, TimerSelector( ).withState( TimerState::Completed ) );
+			break;
+		case ID_STOP_TYPE: {
+			auto types = rightPanel_->getTimerTypes( );
+			if( types.empty( ) )
+				break;
 
-	// Save the configuration
-	if( !config.saveToYaml( savePath ) ) {
+			wxArrayString choices;
+			for( const auto& type : types )
+				choices.Add( type );
+			auto choice = wxGetSingleChoiceIndex( "Stop every running timer of type:", "Stop All of Type", choices, frame_ );
+			if( choice >= 0 )
+				rightPanel_->applyToMatching( TimerAction::Stop,
+					TimerSelector( ).withType( types[ choice ] ).withState( TimerState::Running ) );
+			break;
+		}
+	}
+}
+
+void MainFrame::onIconize( wxIconizeEvent& event )
+{
+	// Throttle refreshes to completions while nothing is visible
+	rightPanel_->setMinimized( event.IsIconized( ) );
+	event.Skip( );
+}
+
+void MainFrame::onConfigSaved( const std::filesystem::path& filePath, bool saved )
+{
+	if( !saved ) {
 		wxMessageBox( "Failed to save configuration.", "Error", wxOK | wxICON_ERROR );
 		return;
 	}
 
 	// Update status
-	frame_->SetStatusText( "Configuration saved to: " + saveDialog.GetPath( ) );
+	frame_->SetStatusText( "Configuration saved to: " + wxString( filePath.string( ) ) );
 }
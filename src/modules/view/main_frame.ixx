@@ -19,11 +19,18 @@
 export module view.main_frame;
 
 import model.config;
+import model.config_loader;
+import model.config_writer;
+import model.run_history;
+import model.shared_timer_table;
+import model.thread_pool;
 import view.left_panel;
 import view.right_panel;
 
 import <memory>;
 import <filesystem>;
+import <optional>;
+import <vector>;
 
 import <wx/frame.h>;
 import <wx/string.h>;
@@ -42,8 +49,14 @@ public:
 	// Get the wxFrame
 	wxFrame* getFrame( ) const;
 
-	// Initialize with config
-	void initialize( const Config& config );
+	// Initialize with config; the panels show the merged items and saving writes the root
+	void initialize( const LoadedConfig& config );
+
+	// Load a configuration and its fragments, warning about problems that did not stop the load
+	[[nodiscard]] std::optional<LoadedConfig> loadConfig( const std::filesystem::path& filePath );
+
+	// Share active timers with other processes on this host through the table
+	void setSharedTable( std::unique_ptr<SharedTimerTable> sharedTable );
 
 private:
 	void createControls( );
@@ -54,15 +67,45 @@ private:
 	void onExit( wxCommandEvent& event );
 	void onOpenConfig( wxCommandEvent& event );
 	void onSaveConfig( wxCommandEvent& event );
+	void onClose( wxCloseEvent& event );
+	void onIconize( wxIconizeEvent& event );
+	void onHostTimers( wxCommandEvent& event );
+	void onArchivedTimers( wxCommandEvent& event );
+
+	// Apply a Timers menu action to the selected or matching timers
+	void onTimersMenu( wxCommandEvent& event );
+
+	// Called on the UI thread once a background save finished
+	void onConfigSaved( const std::filesystem::path& filePath, bool saved );
+
+	// Format diagnostics as file:line:column lines, listing the first few
+	[[nodiscard]] static wxString formatDiagnostics( const std::vector<ConfigDiagnostic>& diagnostics );
 
 	// UI Controls
 	wxFrame* frame_ = nullptr;
 	wxSplitterWindow* splitter_ = nullptr;
+
+	// History of finished runs, outlives the right panel that records into it
+	std::unique_ptr<RunHistory> runHistory_;
+
+	// Host-wide timer table, outlives the right panel that publishes into it
+	std::unique_ptr<SharedTimerTable> sharedTable_;
+
 	std::unique_ptr<LeftPanel> leftPanel_ = nullptr;
 	std::unique_ptr<RightPanel> rightPanel_ = nullptr;
 
+	// Loaded root configuration with its own items and includes, as saved back
+	Config config_;
+
 	// Config file path
 	std::filesystem::path configPath_ = "config/default_config.yaml";
+
+	// Background configuration writer
+	std::unique_ptr<ConfigWriter> configWriter_;
+
+	// Workers parsing configuration fragments, and the loader caching them across reloads
+	ThreadPool threadPool_;
+	ConfigLoader configLoader_{ threadPool_ };
 };
 
 // Implementation will be in separate file due to wxWidgets dependencies
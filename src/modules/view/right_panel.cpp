@@ -17,11 +17,14 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 import view.right_panel;
+import model.item_schema;
 
 #include <wx/wx.h>
 #include <wx/listctrl.h>
 #include <wx/dnd.h>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <iomanip>
 #include <sstream>
 
@@ -103,15 +106,24 @@ private:
 };
 
 
-RightPanel::RightPanel( wxWindow* parent ) {
+RightPanel::RightPanel( wxWindow* parent, RunHistory* runHistory )
+	: runHistory_( runHistory )
+{
 	panel_ = new wxPanel( parent, wxID_ANY );
 	timer_ = new wxTimer( panel_, TIMER_ID );
+	commandTimer_ = new wxTimer( panel_, COMMAND_TIMER_ID );
+
+	// Record every finished run and free its admission slot
+	timers_.setRunListener( [this]( const TimerStore::RunEnd& runEnd )
+		{
+			recordRun( runEnd );
+			scheduler_.release( runEnd.id );
+		} );
 
 	createControls( );
 	bindEvents( );
 
-	// Start the timer for updating active items
-	timer_->Start( 1000 ); // Update every second
+	// The timer is armed on demand by scheduleRefresh
 }
 
 wxPanel* RightPanel::getPanel( ) const
@@ -126,14 +138,17 @@ void RightPanel::createControls( )
 
 	// Create a list control
 	listCtrl_ = new wxListCtrl( panel_, wxID_ANY, wxDefaultPosition, wxDefaultSize,
-		wxLC_REPORT | wxLC_SINGLE_SEL );
+		wxLC_REPORT );
 
-	// Add columns
-	listCtrl_->AppendColumn( "Name" );
-	listCtrl_->AppendColumn( "Type" );
-	listCtrl_->AppendColumn( "Action" );
+	// Add the item field columns, then the timer columns
+	ItemSchema::forEachColumn( [this]( std::size_t, std::string_view label )
+		{
+			listCtrl_->AppendColumn( wxString( label.data( ), label.size( ) ) );
+		}, ItemSchema::TIMER_COLUMN );
+	listCtrl_->AppendColumn( "State" );
 	listCtrl_->AppendColumn( "Remaining" );
 	listCtrl_->AppendColumn( "ETA" );
+	listCtrl_->AppendColumn( "Predicted (p50 / p90)" );
 
 	// Set up drop target
 	auto onDrop = [this]( wxCoord x, wxCoord y, const Item& item )
@@ -165,6 +180,7 @@ void RightPanel::bindEvents( )
 {
 	// Bind timer event
 	panel_->Bind( wxEVT_TIMER, &RightPanel::onTimer, this, TIMER_ID );
+	panel_->Bind( wxEVT_TIMER, &RightPanel::onCommandTimer, this, COMMAND_TIMER_ID );
 
 	// Bind list events
 	listCtrl_->Bind( wxEVT_LIST_ITEM_ACTIVATED, &RightPanel::onItemActivated, this );
@@ -186,11 +202,11 @@ bool RightPanel::addItem( const Item& item )
 			wxBell( );
 			};
 
-		// Create an active item
-		activeItems_.emplace_back( modifiedItem, onComplete );
+		// Create an active timer
+		auto timerId = timers_.add( modifiedItem, onComplete );
 
-		// Start the timer
-		activeItems_.back( ).start( );
+		// Start the timer, or queue it when its type is over budget
+		submitTimer( timerId );
 
 		// Update the list
 		updateList( );
@@ -203,13 +219,43 @@ bool RightPanel::addItem( const Item& item )
 
 void RightPanel::updateTimers( )
 {
-	// Update all active items
-	for( auto& activeItem : activeItems_ ) {
-		activeItem.update( );
+	// Complete all due timers and start queued ones in the freed slots
+	if( timers_.update( ) > 0 )
+		startAdmitted( );
+	evictCompleted( );
+
+	// Nobody sees the list while minimized
+	if( minimized_ ) {
+		publishTimers( );
+		scheduleRefresh( );
 	}
+	else
+		updateList( );
+}
 
-	// Update the display
-	updateList( );
+void RightPanel::setMinimized( bool minimized )
+{
+	minimized_ = minimized;
+	updateCommandPolling( );
+	if( minimized_ )
+		scheduleRefresh( );
+	else
+		updateTimers( );
+}
+
+void RightPanel::scheduleRefresh( )
+{
+	// Minimized, only completions matter; visible, every change of a shown second
+	auto now = TimerStore::Clock::now( );
+	auto next = minimized_ ? timers_.getNextExpiry( ) : timers_.getNextDisplayChange( now, REFRESH_WINDOW );
+	if( !next ) {
+		timer_->Stop( );
+		return;
+	}
+
+	// Round up so the wakeup never lands just before the deadline
+	auto delay = std::chrono::ceil<std::chrono::milliseconds>( *next - now ).count( );
+	timer_->StartOnce( static_cast< int >( std::clamp<long long>( delay, 1, std::numeric_limits<int>::max( ) ) ) );
 }
 
 void RightPanel::updateList( )
@@ -217,24 +263,290 @@ void RightPanel::updateList( )
 	// Clear the list
 	listCtrl_->DeleteAllItems( );
 
-	// Add each active item
-	for( size_t i = 0; i < activeItems_.size( ); ++i ) {
-		const auto& activeItem = activeItems_[ i ];
-		const auto& item = activeItem.getItem( );
-
-		long index = listCtrl_->InsertItem( i, item.getName( ) );
-		listCtrl_->SetItem( index, 1, item.getType( ) );
-		listCtrl_->SetItem( index, 2, item.getAction( ) );
-		listCtrl_->SetItem( index, 3, activeItem.getRemainingTimeString( ) );
-		listCtrl_->SetItem( index, 4, formatTimePoint( activeItem.getETA( ) ) );
-
-		// Store the item index for later retrieval
-		listCtrl_->SetItemData( index, i );
+	// Add each active timer
+	auto now = TimerStore::Clock::now( );
+	auto timerIds = timers_.getIds( );
+	auto waits = scheduler_.estimateWaits( [this, now]( TimerStore::TimerId timerId )
+		{
+			return timers_.getRemainingSeconds( timerId, now );
+		} );
+	auto positions = scheduler_.getQueuePositions( );
+	for( size_t i = 0; i < timerIds.size( ); ++i ) {
+		auto timerId = timerIds[ i ];
+		const auto& item = timers_.getItem( timerId );
+
+		long index = listCtrl_->InsertItem( i, wxEmptyString );
+		ItemSchema::formatColumns( item, [this, index]( std::size_t column, std::string_view text )
+			{
+				listCtrl_->SetItem( index, static_cast< int >( column ), wxString( text.data( ), text.size( ) ) );
+			}, ItemSchema::TIMER_COLUMN );
+		listCtrl_->SetItem( index, STATE_COLUMN, formatState( timerId, positions, waits ) );
+		listCtrl_->SetItem( index, REMAINING_COLUMN, timers_.getRemainingTimeString( timerId, now ) );
+
+		// Queued timers finish only after waiting for a slot; paused and
+		// completed ones have no fixed ETA to show between refreshes
+		auto wait = waits.find( timerId );
+		auto eta = timers_.getETA( timerId, now );
+		if( wait != waits.end( ) )
+			listCtrl_->SetItem( index, ETA_COLUMN, formatTimePoint( eta + std::chrono::seconds( wait->second ) ) );
+		else if( timers_.isRunning( timerId ) )
+			listCtrl_->SetItem( index, ETA_COLUMN, formatTimePoint( eta ) );
+		else
+			listCtrl_->SetItem( index, ETA_COLUMN, "-" );
+		listCtrl_->SetItem( index, PREDICTION_COLUMN, formatPrediction( item ) );
+
+		// Store the timer id for later retrieval
+		listCtrl_->SetItemData( index, timerId );
 	}
 
 	// Resize columns
-	for( int i = 0; i < 5; ++i )
+	for( int i = 0; i < COLUMN_COUNT; ++i )
 		listCtrl_->SetColumnWidth( i, wxLIST_AUTOSIZE_USEHEADER );
+
+	// Every state change ends here, so share it and plan the next refresh from it
+	publishTimers( );
+	scheduleRefresh( );
+}
+
+void RightPanel::setResourceClasses( const std::vector<ResourceClass>& resourceClasses, int maxConcurrent )
+{
+	scheduler_.configure( resourceClasses, maxConcurrent );
+
+	// Raised budgets may let queued timers start right away
+	startAdmitted( );
+	updateList( );
+}
+
+void RightPanel::applyToSelection( TimerAction action )
+{
+	std::vector<TimerStore::TimerId> timerIds;
+	for( long index = listCtrl_->GetNextItem( -1, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED ); index != -1;
+		index = listCtrl_->GetNextItem( index, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED ) )
+		timerIds.push_back( static_cast< TimerStore::TimerId >( listCtrl_->GetItemData( index ) ) );
+
+	applyToTimers( action, timerIds );
+}
+
+void RightPanel::applyToMatching( TimerAction action, const TimerSelector& selector )
+{
+	applyToTimers( action, timers_.select( selector ) );
+}
+
+std::vector<std::string> RightPanel::getTimerTypes( ) const
+{
+	return timers_.getTypes( );
+}
+
+void RightPanel::setRetention( const RetentionPolicy& retention )
+{
+	retention_ = retention;
+	archive_.setCapacity( retention_.archiveSize );
+
+	// Tighter limits apply right away
+	evictCompleted( );
+	updateList( );
+}
+
+const CompletionArchive& RightPanel::getArchive( ) const noexcept
+{
+	return archive_;
+}
+
+void RightPanel::evictCompleted( )
+{
+	timers_.evictCompleted( retention_, TimerStore::Clock::now( ), [this]( const TimerStore::Eviction& eviction )
+		{
+			archive_.add( eviction.item, eviction.startedAt, eviction.completedAt );
+			releaseSharedSlot( eviction.id );
+		} );
+}
+
+void RightPanel::applyToTimers( TimerAction action, const std::vector<TimerStore::TimerId>& timerIds )
+{
+	for( auto timerId : timerIds ) {
+		// Completion callbacks may have removed timers picked earlier
+		if( !timers_.contains( timerId ) )
+			continue;
+
+		switch( action ) {
+			case TimerAction::Start:
+				startTimer( timerId );
+				break;
+			case TimerAction::Stop:
+				stopTimer( timerId );
+				break;
+			case TimerAction::Reset:
+				resetTimer( timerId );
+				break;
+			case TimerAction::Remove:
+				removeTimer( timerId );
+				break;
+		}
+	}
+
+	// Removed timers may free slots for queued ones; the whole batch shares one refresh
+	startAdmitted( );
+	updateList( );
+}
+
+void RightPanel::setSharedTable( SharedTimerTable* sharedTable )
+{
+	sharedTable_ = sharedTable;
+	publishTimers( );
+	updateCommandPolling( );
+}
+
+void RightPanel::updateCommandPolling( )
+{
+	// Other processes cannot wake this one, so commands to published timers are polled while visible
+	bool poll = sharedTable_ && !sharedSlots_.empty( ) && !minimized_;
+	if( poll && !commandTimer_->IsRunning( ) )
+		commandTimer_->Start( COMMAND_POLL_INTERVAL );
+	else if( !poll && commandTimer_->IsRunning( ) )
+		commandTimer_->Stop( );
+}
+
+void RightPanel::publishTimers( )
+{
+	if( !sharedTable_ )
+		return;
+
+	using std::chrono::duration_cast;
+	using std::chrono::milliseconds;
+
+	auto now = TimerStore::Clock::now( );
+	for( auto timerId : timers_.getIds( ) ) {
+		auto slot = sharedSlots_.find( timerId );
+		if( slot == sharedSlots_.end( ) ) {
+			auto claimed = sharedTable_->claim( );
+			if( !claimed )
+				continue; // Table full; the timer stays private
+			slot = sharedSlots_.emplace( timerId, *claimed ).first;
+		}
+
+		const auto& item = timers_.getItem( timerId );
+		auto eta = timers_.getETA( timerId, now );
+
+		SharedTimerState state;
+		state.name = item.getName( );
+		state.type = item.getType( );
+		state.action = item.getAction( );
+		state.deadline = duration_cast< milliseconds >( eta.time_since_epoch( ) ).count( );
+		state.remaining = duration_cast< milliseconds >( eta - now ).count( );
+		state.duration = timers_.getPeriod( timerId, now ).count( );
+		state.running = timers_.isRunning( timerId );
+		state.completed = timers_.isCompleted( timerId );
+		state.queued = scheduler_.isQueued( timerId );
+		sharedTable_->publish( slot->second, state );
+	}
+	updateCommandPolling( );
+}
+
+void RightPanel::submitTimer( TimerStore::TimerId timerId )
+{
+	// Scheduled items hold their slot for the next occurrence rather than the item's timeout
+	const auto& item = timers_.getItem( timerId );
+	auto period = std::chrono::ceil<std::chrono::seconds>( timers_.getPeriod( timerId ) );
+	scheduler_.submit( timerId, std::string( item.getType( ) ), static_cast< int >( period.count( ) ) );
+	startAdmitted( );
+}
+
+void RightPanel::startAdmitted( )
+{
+	for( auto timerId : scheduler_.admit( ) )
+		timers_.start( timerId );
+}
+
+void RightPanel::startTimer( TimerStore::TimerId timerId )
+{
+	// Queued timers wait for the scheduler
+	if( timers_.isRunning( timerId ) || scheduler_.isQueued( timerId ) )
+		return;
+
+	if( timers_.isCompleted( timerId ) ) {
+		timers_.reset( timerId );
+		submitTimer( timerId );
+	}
+	else if( timers_.getStartTime( timerId ) ) {
+		// A paused run keeps its admission slot
+		timers_.start( timerId );
+	}
+	else {
+		submitTimer( timerId );
+	}
+}
+
+void RightPanel::stopTimer( TimerStore::TimerId timerId )
+{
+	if( timers_.isRunning( timerId ) )
+		timers_.stop( timerId );
+}
+
+void RightPanel::resetTimer( TimerStore::TimerId timerId )
+{
+	if( !scheduler_.isQueued( timerId ) )
+		timers_.reset( timerId );
+}
+
+void RightPanel::removeTimer( TimerStore::TimerId timerId )
+{
+	// Running timers free their slot through the run listener, queued ones leave the queue here
+	timers_.remove( timerId );
+	scheduler_.release( timerId );
+	releaseSharedSlot( timerId );
+}
+
+void RightPanel::releaseSharedSlot( TimerStore::TimerId timerId )
+{
+	auto slot = sharedSlots_.find( timerId );
+	if( slot != sharedSlots_.end( ) ) {
+		sharedTable_->release( slot->second );
+		sharedSlots_.erase( slot );
+		updateCommandPolling( );
+	}
+}
+
+wxString RightPanel::formatState( TimerStore::TimerId timerId, const std::unordered_map<TimerStore::TimerId, std::size_t>& positions,
+	const std::unordered_map<TimerStore::TimerId, int>& waits ) const
+{
+	if( timers_.isCompleted( timerId ) )
+		return "Completed";
+	if( timers_.isRunning( timerId ) )
+		return timers_.isRecurring( timerId ) ? "Repeating" : "Running";
+
+	auto position = positions.find( timerId );
+	if( position == positions.end( ) )
+		return "Paused";
+
+	auto wait = waits.find( timerId );
+	if( wait == waits.end( ) )
+		return wxString::Format( "Queued #%zu", position->second );
+	return wxString::Format( "Queued #%zu (~", position->second ) + formatDuration( wait->second ) + ")";
+}
+
+void RightPanel::recordRun( const TimerStore::RunEnd& runEnd )
+{
+	if( !runHistory_ )
+		return;
+
+	using std::chrono::duration_cast;
+	using std::chrono::milliseconds;
+
+	runHistory_->record( RunRecord{
+		RunHistory::keyOf( timers_.getItem( runEnd.id ) ),
+		duration_cast< milliseconds >( runEnd.startedAt.time_since_epoch( ) ).count( ),
+		duration_cast< milliseconds >( runEnd.endedAt - runEnd.startedAt ).count( ),
+		runEnd.completed ? RunOutcome::Completed : RunOutcome::Aborted } );
+}
+
+wxString RightPanel::formatPrediction( const Item& item ) const
+{
+	const RunStatistics* statistics = runHistory_ ? runHistory_->getStatistics( RunHistory::keyOf( item ) ) : nullptr;
+	if( !statistics )
+		return "-";
+
+	return formatDuration( statistics->getMedian( ).getEstimate( ) ) + " / " +
+		formatDuration( statistics->getP90( ).getEstimate( ) );
 }
 
 void RightPanel::onDragEnter( wxDragResult& result )
@@ -261,26 +573,48 @@ void RightPanel::onTimer( wxTimerEvent& event )
 	updateTimers( );
 }
 
+void RightPanel::onCommandTimer( wxTimerEvent& event )
+{
+	bool changed = false;
+	for( const auto& [timerId, slot] : sharedSlots_ ) {
+		switch( sharedTable_->takeCommand( slot ) ) {
+			case SharedTimerCommand::Start:
+				startTimer( timerId );
+				changed = true;
+				break;
+			case SharedTimerCommand::Stop:
+				stopTimer( timerId );
+				changed = true;
+				break;
+			case SharedTimerCommand::Reset:
+				resetTimer( timerId );
+				changed = true;
+				break;
+			case SharedTimerCommand::None:
+				break;
+		}
+	}
+
+	// A reset frees its admission slot for a queued timer, as with local commands
+	if( changed ) {
+		startAdmitted( );
+		updateTimers( );
+	}
+}
+
 void RightPanel::onItemActivated( wxListEvent& event )
 {
 	// Get the selected item
 	long itemIndex = event.GetIndex( );
-	long dataIndex = listCtrl_->GetItemData( itemIndex );
+	auto timerId = static_cast< TimerStore::TimerId >( listCtrl_->GetItemData( itemIndex ) );
 
-	if( dataIndex >= 0 && dataIndex < static_cast< long >( activeItems_.size( ) ) ) {
-		// Toggle the timer
-		auto& activeItem = activeItems_[ dataIndex ];
-
-		if( activeItem.isRunning( ) ) {
-			activeItem.stop( );
-		}
-		else if( !activeItem.isCompleted( ) ) {
-			activeItem.start( );
-		}
-		else {
-			activeItem.reset( );
-			activeItem.start( );
-		}
+	if( timers_.contains( timerId ) ) {
+		// Toggle the timer; a run completing on stop frees its slot for a queued timer
+		if( timers_.isRunning( timerId ) )
+			stopTimer( timerId );
+		else
+			startTimer( timerId );
+		startAdmitted( );
 
 		// Update the display
 		updateList( );
@@ -298,3 +632,9 @@ wxString RightPanel::formatTimePoint( const std::chrono::system_clock::time_poin
 
 	return ss.str( );
 }
+
+wxString RightPanel::formatDuration( double seconds )
+{
+	auto totalSeconds = static_cast< long >( std::lround( seconds ) );
+	return wxString::Format( "%02ld:%02ld", totalSeconds / 60, totalSeconds % 60 );
+}
@@ -19,11 +19,20 @@
 export module view.right_panel;
 
 export import model.item;
-import model.active_item;
+import model.item_schema;
+import model.timer_store;
+export import model.timer_selector;
+export import model.completion_archive;
+import model.admission_scheduler;
+import model.shared_timer_table;
+import model.run_history;
 export import view.config_dialog;
 import <vector>;
 import <memory>;
+import <string>;
 import <chrono>;
+import <cstdint>;
+import <unordered_map>;
 
 import <wx/defs.h>;
 
@@ -41,8 +50,17 @@ import <wx/dnd.h>;
 export class RightPanel
 {
 public:
-	// Constructor
-	explicit RightPanel( wxWindow* parent );
+	// Operations applied to several timers at once
+	enum class TimerAction
+	{
+		Start,
+		Stop,
+		Reset,
+		Remove
+	};
+
+	// Constructor - runHistory, if given, records finished runs and provides ETA predictions
+	explicit RightPanel( wxWindow* parent, RunHistory* runHistory = nullptr );
 
 	// Get the wxPanel
 	wxPanel* getPanel( ) const;
@@ -53,31 +71,123 @@ public:
 	// Update all timers
 	void updateTimers( );
 
+	// While minimized only completions wake the panel; restoring catches up
+	void setMinimized( bool minimized );
+
+	// Publish active timers to a table shared with other processes and apply their commands
+	void setSharedTable( SharedTimerTable* sharedTable );
+
+	// Set per-type concurrency budgets; items beyond them wait in a queue
+	void setResourceClasses( const std::vector<ResourceClass>& resourceClasses, int maxConcurrent );
+
+	// Apply an action to the selected rows, or to every timer a selector matches, refreshing once
+	void applyToSelection( TimerAction action );
+	void applyToMatching( TimerAction action, const TimerSelector& selector );
+
+	// Get the item types of the active timers
+	[[nodiscard]] std::vector<std::string> getTimerTypes( ) const;
+
+	// Set how many completed timers stay listed before moving to the archive
+	void setRetention( const RetentionPolicy& retention );
+
+	// Get completed timers that left the list
+	[[nodiscard]] const CompletionArchive& getArchive( ) const noexcept;
+
 private:
 	// Timer ID for updating active items
 	static constexpr int TIMER_ID = 1001;
 
+	// Timer ID for polling commands posted through the shared table
+	static constexpr int COMMAND_TIMER_ID = 1002;
+	static constexpr int COMMAND_POLL_INTERVAL = 250; // milliseconds
+
+	// Item fields listed for timers come first, then the columns from STATE_COLUMN on
+	static constexpr int STATE_COLUMN = static_cast< int >( ItemSchema::countFields( ItemSchema::TIMER_COLUMN ) );
+	static constexpr int REMAINING_COLUMN = STATE_COLUMN + 1;
+	static constexpr int ETA_COLUMN = STATE_COLUMN + 2;
+	static constexpr int PREDICTION_COLUMN = STATE_COLUMN + 3;
+	static constexpr int COLUMN_COUNT = STATE_COLUMN + 4;
+
+	// Second changes this close together share one refresh
+	static constexpr std::chrono::milliseconds REFRESH_WINDOW{ 100 };
+
 	void createControls( );
 	void bindEvents( );
 	void updateList( );
 
+	// Arm the one-shot timer for the next meaningful deadline, or stop it when idle
+	void scheduleRefresh( );
+
+	// Queue a timer for admission and start whatever may run
+	void submitTimer( TimerStore::TimerId timerId );
+
+	// Start timers admitted by the scheduler
+	void startAdmitted( );
+
+	// Start, resume, or restart a timer through the scheduler
+	void startTimer( TimerStore::TimerId timerId );
+	void stopTimer( TimerStore::TimerId timerId );
+	void resetTimer( TimerStore::TimerId timerId );
+	void removeTimer( TimerStore::TimerId timerId );
+
+	// Archive completed timers beyond the retention policy
+	void evictCompleted( );
+
+	// Give back the shared table slot of a timer that is gone
+	void releaseSharedSlot( TimerStore::TimerId timerId );
+
+	// Apply an action to each timer, then start admitted ones and refresh the list
+	void applyToTimers( TimerAction action, const std::vector<TimerStore::TimerId>& timerIds );
+
+	// Write the state of every timer to the shared table
+	void publishTimers( );
+
+	// Poll for commands only while timers are published and the window is visible
+	void updateCommandPolling( );
+
+	// Format the state of a timer, including the queue position and expected wait of queued ones
+	[[nodiscard]] wxString formatState( TimerStore::TimerId timerId, const std::unordered_map<TimerStore::TimerId, std::size_t>& positions,
+		const std::unordered_map<TimerStore::TimerId, int>& waits ) const;
+
+	// Record a finished run in the history
+	void recordRun( const TimerStore::RunEnd& runEnd );
+
+	// Format predicted p50/p90 run time of an item
+	[[nodiscard]] wxString formatPrediction( const Item& item ) const;
+
 	// Event handlers
 	void onDragEnter( wxDragResult& result );
 	void onDragOver( wxCoord x, wxCoord y, wxDragResult& result );
 	void onDrop( wxCoord x, wxCoord y, const Item& item );
 	void onTimer( wxTimerEvent& event );
+	void onCommandTimer( wxTimerEvent& event );
 	void onItemActivated( wxListEvent& event );
 
 	// Format time point to string
 	static wxString formatTimePoint( const std::chrono::system_clock::time_point& timePoint );
 
+	// Format duration in seconds to string (MM:SS)
+	static wxString formatDuration( double seconds );
+
 	// UI controls
 	wxPanel* panel_ = nullptr;
 	wxListCtrl* listCtrl_ = nullptr;
 	wxTimer* timer_ = nullptr;
+	wxTimer* commandTimer_ = nullptr;
 
 	// Data
-	std::vector<ActiveItem> activeItems_;
+	TimerStore timers_;
+	AdmissionScheduler scheduler_;
+	RunHistory* runHistory_ = nullptr;
+	bool minimized_ = false;
+
+	// Completed timers are archived beyond the retention limits
+	RetentionPolicy retention_;
+	CompletionArchive archive_{ retention_.archiveSize };
+
+	// Shared table and the slots owned by each timer
+	SharedTimerTable* sharedTable_ = nullptr;
+	std::unordered_map<TimerStore::TimerId, std::uint32_t> sharedSlots_;
 };
 
 // Implementation will be in separate file due to wxWidgets dependencies
@@ -0,0 +1,149 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+module;
+
+#include <gtest/gtest.h>
+
+export module admission_scheduler_test;
+
+import model.admission_scheduler;
+import <unordered_map>;
+import <vector>;
+
+using Ids = std::vector<AdmissionScheduler::Id>;
+
+// Test that runs without a configured class are admitted immediately
+TEST( AdmissionSchedulerTest, UnlimitedByDefault )
+{
+	AdmissionScheduler scheduler;
+	scheduler.submit( 1, "Development", 60 );
+	scheduler.submit( 2, "Development", 60 );
+
+	EXPECT_EQ( ( Ids{ 1, 2 } ), scheduler.admit( ) );
+	EXPECT_EQ( 2, scheduler.getRunningCount( "Development" ) );
+	EXPECT_EQ( 0u, scheduler.getQueuedCount( ) );
+}
+
+// Test that runs beyond the budget queue until a slot frees up
+TEST( AdmissionSchedulerTest, QueuesBeyondBudget )
+{
+	AdmissionScheduler scheduler;
+	scheduler.configure( { ResourceClass{ "Maintenance", 1, 0 } } );
+
+	scheduler.submit( 1, "Maintenance", 60 );
+	scheduler.submit( 2, "Maintenance", 60 );
+	scheduler.submit( 3, "Maintenance", 60 );
+	EXPECT_EQ( ( Ids{ 1 } ), scheduler.admit( ) );
+	EXPECT_TRUE( scheduler.isAdmitted( 1 ) );
+	EXPECT_TRUE( scheduler.isQueued( 2 ) );
+	EXPECT_EQ( 1u, scheduler.getQueuePosition( 2 ) );
+	EXPECT_EQ( 2u, scheduler.getQueuePosition( 3 ) );
+	EXPECT_TRUE( scheduler.admit( ).empty( ) );
+
+	scheduler.release( 1 );
+	EXPECT_FALSE( scheduler.contains( 1 ) );
+	EXPECT_EQ( ( Ids{ 2 } ), scheduler.admit( ) );
+
+	// Releasing a queued run just drops it
+	scheduler.release( 3 );
+	scheduler.release( 2 );
+	EXPECT_TRUE( scheduler.admit( ).empty( ) );
+	EXPECT_EQ( 0, scheduler.getRunningCount( "Maintenance" ) );
+}
+
+// Test that the overall limit admits higher priorities first, then in submission order
+TEST( AdmissionSchedulerTest, AdmitsByPriorityThenFifo )
+{
+	AdmissionScheduler scheduler;
+	scheduler.configure( {
+		ResourceClass{ "Maintenance", 0, 10 },
+		ResourceClass{ "Development", 0, 5 } }, 1 );
+
+	scheduler.submit( 1, "Personal", 60 );
+	EXPECT_EQ( ( Ids{ 1 } ), scheduler.admit( ) );
+
+	scheduler.submit( 2, "Development", 60 );
+	scheduler.submit( 3, "Personal", 60 );
+	scheduler.submit( 4, "Maintenance", 60 );
+	scheduler.submit( 5, "Development", 60 );
+	EXPECT_EQ( 1u, scheduler.getQueuePosition( 4 ) );
+
+	// All positions at once agree with the single lookups
+	auto positions = scheduler.getQueuePositions( );
+	ASSERT_EQ( 4u, positions.size( ) );
+	for( AdmissionScheduler::Id id = 2; id <= 5; ++id )
+		EXPECT_EQ( scheduler.getQueuePosition( id ), positions.at( id ) );
+	EXPECT_FALSE( positions.contains( 1 ) );
+
+	Ids order;
+	for( AdmissionScheduler::Id running = 1; running != 0; ) {
+		scheduler.release( running );
+		auto admitted = scheduler.admit( );
+		running = admitted.empty( ) ? 0 : admitted.front( );
+		order.insert( order.end( ), admitted.begin( ), admitted.end( ) );
+	}
+	EXPECT_EQ( ( Ids{ 4, 2, 5, 3 } ), order );
+}
+
+// Test that a class over budget does not block other classes
+TEST( AdmissionSchedulerTest, BlockedClassDoesNotBlockOthers )
+{
+	AdmissionScheduler scheduler;
+	scheduler.configure( { ResourceClass{ "Maintenance", 1, 10 } } );
+
+	scheduler.submit( 1, "Maintenance", 60 );
+	scheduler.submit( 2, "Maintenance", 60 );
+	scheduler.submit( 3, "Quality", 60 );
+	EXPECT_EQ( ( Ids{ 1, 3 } ), scheduler.admit( ) );
+	EXPECT_TRUE( scheduler.isQueued( 2 ) );
+}
+
+// Test that raising a budget lets queued runs in
+TEST( AdmissionSchedulerTest, ReconfigureAdmitsQueued )
+{
+	AdmissionScheduler scheduler;
+	scheduler.configure( { ResourceClass{ "Maintenance", 1, 0 } } );
+	scheduler.submit( 1, "Maintenance", 60 );
+	scheduler.submit( 2, "Maintenance", 60 );
+	EXPECT_EQ( ( Ids{ 1 } ), scheduler.admit( ) );
+
+	scheduler.configure( { ResourceClass{ "Maintenance", 2, 0 } } );
+	EXPECT_EQ( ( Ids{ 2 } ), scheduler.admit( ) );
+}
+
+// Test wait estimates follow the slots freeing up
+TEST( AdmissionSchedulerTest, EstimatesWaits )
+{
+	AdmissionScheduler scheduler;
+	scheduler.configure( { ResourceClass{ "Maintenance", 2, 0 } } );
+	scheduler.submit( 1, "Maintenance", 600 );
+	scheduler.submit( 2, "Maintenance", 600 );
+	scheduler.submit( 3, "Maintenance", 300 );
+	scheduler.submit( 4, "Maintenance", 300 );
+	scheduler.submit( 5, "Maintenance", 300 );
+	EXPECT_EQ( ( Ids{ 1, 2 } ), scheduler.admit( ) );
+
+	std::unordered_map<AdmissionScheduler::Id, int> remaining{ { 1, 100 }, { 2, 400 } };
+	auto waits = scheduler.estimateWaits( [&remaining]( AdmissionScheduler::Id id ) { return remaining.at( id ); } );
+
+	ASSERT_EQ( 3u, waits.size( ) );
+	EXPECT_EQ( 100, waits.at( 3 ) );
+	EXPECT_EQ( 400, waits.at( 4 ) );
+	EXPECT_EQ( 400, waits.at( 5 ) );
+}
@@ -0,0 +1,276 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+module;
+
+#include <gtest/gtest.h>
+
+export module config_loader_test;
+
+import model.config;
+import model.config_loader;
+import model.item;
+import model.thread_pool;
+import <chrono>;
+import <filesystem>;
+import <fstream>;
+import <future>;
+import <stdexcept>;
+import <string>;
+import <vector>;
+
+// Test fixture for ConfigLoader tests
+class ConfigLoaderTest : public ::testing::Test
+{
+protected:
+	void SetUp( ) override
+	{
+		dir_ = std::filesystem::temp_directory_path( ) /
+			( "ticks_config_loader_test_" + std::to_string( ::testing::UnitTest::GetInstance( )->random_seed( ) ) );
+		std::filesystem::remove_all( dir_ );
+		std::filesystem::create_directories( dir_ / "teams" / "ops" );
+	}
+
+	void TearDown( ) override
+	{
+		std::filesystem::remove_all( dir_ );
+	}
+
+	void writeFile( const std::filesystem::path& relativePath, const std::string& content ) const
+	{
+		std::ofstream fout( dir_ / relativePath, std::ios::binary | std::ios::trunc );
+		fout << content;
+	}
+
+	// Names of the items in load order
+	[[nodiscard]] static std::vector<std::string> namesOf( const Config& config )
+	{
+		std::vector<std::string> names;
+		for( const auto& item : config.getItems( ) )
+			names.emplace_back( item.getName( ) );
+		return names;
+	}
+
+	std::filesystem::path dir_;
+	ThreadPool threadPool_{ 4 };
+};
+
+// Test the pool delivers results and exceptions through futures
+TEST( ThreadPoolTest, RunsTasks )
+{
+	ThreadPool threadPool( 3 );
+	EXPECT_EQ( 3u, threadPool.getThreadCount( ) );
+
+	std::vector<std::future<int>> results;
+	for( int i = 0; i < 100; ++i )
+		results.push_back( threadPool.submit( [i]( ) { return i * i; } ) );
+	for( int i = 0; i < 100; ++i )
+		EXPECT_EQ( i * i, results[ i ].get( ) );
+
+	auto failed = threadPool.submit( [ ]( ) -> int { throw std::runtime_error( "failed" ); } );
+	EXPECT_THROW( failed.get( ), std::runtime_error );
+}
+
+// Test wildcard matching of single path components
+TEST( ConfigLoaderPatternTest, MatchesWildcards )
+{
+	EXPECT_TRUE( ConfigLoader::matchesWildcard( "*.yaml", "build.yaml" ) );
+	EXPECT_TRUE( ConfigLoader::matchesWildcard( "*.yaml", ".yaml" ) );
+	EXPECT_TRUE( ConfigLoader::matchesWildcard( "team-?.y*ml", "team-a.yaml" ) );
+	EXPECT_TRUE( ConfigLoader::matchesWildcard( "a*b*c", "aXbYbZc" ) );
+	EXPECT_FALSE( ConfigLoader::matchesWildcard( "*.yaml", "build.yml" ) );
+	EXPECT_FALSE( ConfigLoader::matchesWildcard( "team-?.yaml", "team-ab.yaml" ) );
+	EXPECT_FALSE( ConfigLoader::matchesWildcard( "a*b*c", "aXbYbZ" ) );
+}
+
+// Test fragments merge in declared order, first definition of a name winning
+TEST_F( ConfigLoaderTest, MergesFragmentsInDeclaredOrder )
+{
+	writeFile( "root.yaml",
+		"include: [ \"teams/**/*.yaml\", extra.yaml, \"missing/*.yaml\" ]\n"
+		"max_concurrent: 2\n"
+		"items:\n"
+		"  - { name: Root, timeout: 1 }\n" );
+	writeFile( "teams/b.yaml", "items: [ { name: B, timeout: 1 }, { name: Root, type: Shadowed, timeout: 1 } ]\n" );
+	writeFile( "teams/a.yaml", "items: [ { name: A, timeout: 5 } ]\n" );
+	writeFile( "teams/ops/c.yaml", "include: [ \"../*.yaml\" ]\nitems: [ { name: C, timeout: 1 } ]\n" );
+	writeFile( "teams/notes.txt", "items: [ { name: Ignored } ]\n" );
+	writeFile( "extra.yaml", "items: [ { name: Extra, timeout: 1 } ]\n" );
+
+	ConfigLoader loader( threadPool_ );
+	auto config = loader.load( dir_ / "root.yaml" );
+	ASSERT_TRUE( config.has_value( ) );
+
+	EXPECT_EQ( ( std::vector<std::string>{ "Root", "A", "B", "C", "Extra" } ), namesOf( config->merged ) );
+	EXPECT_EQ( Item( "A", "", "", 5 ), config->merged.getItems( )[ 1 ] );
+	EXPECT_EQ( 2, config->merged.getMaxConcurrent( ) );
+	EXPECT_TRUE( config->merged.getIncludes( ).empty( ) );
+
+	// The root stays as written
+	EXPECT_EQ( ( std::vector<std::string>{ "Root" } ), namesOf( config->root ) );
+	EXPECT_EQ( 3u, config->root.getIncludes( ).size( ) );
+	EXPECT_EQ( 2, config->root.getMaxConcurrent( ) );
+
+	// Unmatched pattern, duplicate name and nested include
+	ASSERT_EQ( 3u, loader.getDiagnostics( ).size( ) );
+	EXPECT_EQ( dir_ / "root.yaml", loader.getDiagnostics( )[ 0 ].filePath );
+	EXPECT_EQ( dir_ / "teams" / "b.yaml", loader.getDiagnostics( )[ 1 ].filePath );
+	EXPECT_NE( std::string::npos, loader.getDiagnostics( )[ 1 ].message.find( "'Root'" ) );
+	EXPECT_EQ( dir_ / "teams" / "ops" / "c.yaml", loader.getDiagnostics( )[ 2 ].filePath );
+}
+
+// Test a broken fragment is skipped while a broken root fails the load
+TEST_F( ConfigLoaderTest, SkipsBrokenFragments )
+{
+	writeFile( "root.yaml", "include: \"teams/*.yaml\"\nitems: [ { name: Root, timeout: 1 } ]\n" );
+	writeFile( "teams/a.yaml", "items: [ { name: A, timeout: 1 } ]\n" );
+	writeFile( "teams/b.yaml", "items: [ { name: Unterminated\n" );
+
+	ConfigLoader loader( threadPool_ );
+	auto config = loader.load( dir_ / "root.yaml" );
+	ASSERT_TRUE( config.has_value( ) );
+	EXPECT_EQ( ( std::vector<std::string>{ "Root", "A" } ), namesOf( config->merged ) );
+	ASSERT_EQ( 1u, loader.getDiagnostics( ).size( ) );
+	EXPECT_EQ( dir_ / "teams" / "b.yaml", loader.getDiagnostics( )[ 0 ].filePath );
+	EXPECT_EQ( 0u, loader.getDiagnostics( )[ 0 ].message.find( "fragment skipped: " ) );
+	EXPECT_GT( loader.getDiagnostics( )[ 0 ].line, 0 );
+
+	// A failed load keeps the reason
+	writeFile( "root.yaml", "items: [ { name: Unterminated\n" );
+	EXPECT_FALSE( loader.load( dir_ / "root.yaml" ).has_value( ) );
+	ASSERT_EQ( 1u, loader.getDiagnostics( ).size( ) );
+	EXPECT_EQ( dir_ / "root.yaml", loader.getDiagnostics( )[ 0 ].filePath );
+	EXPECT_FALSE( loader.load( dir_ / "absent.yaml" ).has_value( ) );
+	EXPECT_EQ( 1u, loader.getDiagnostics( ).size( ) );
+}
+
+// Test saving the loaded root keeps its includes and leaves fragment items in their files
+TEST_F( ConfigLoaderTest, SavedRootKeepsIncludes )
+{
+	writeFile( "root.yaml",
+		"include: [ \"teams/*.yaml\" ]\n"
+		"max_concurrent: 3\n"
+		"items: [ { name: Root, timeout: 1 } ]\n" );
+	writeFile( "teams/a.yaml", "items: [ { name: A, timeout: 1 } ]\n" );
+
+	ConfigLoader loader( threadPool_ );
+	auto config = loader.load( dir_ / "root.yaml" );
+	ASSERT_TRUE( config.has_value( ) );
+	ASSERT_TRUE( config->root.saveToYaml( dir_ / "root.yaml" ) );
+
+	auto reloaded = loader.load( dir_ / "root.yaml" );
+	ASSERT_TRUE( reloaded.has_value( ) );
+	EXPECT_EQ( ( std::vector<std::string>{ "teams/*.yaml" } ), reloaded->root.getIncludes( ) );
+	EXPECT_EQ( ( std::vector<std::string>{ "Root" } ), namesOf( reloaded->root ) );
+	EXPECT_EQ( ( std::vector<std::string>{ "Root", "A" } ), namesOf( reloaded->merged ) );
+	EXPECT_EQ( 3, reloaded->merged.getMaxConcurrent( ) );
+	EXPECT_TRUE( loader.getDiagnostics( ).empty( ) );
+}
+
+// Test saving the root into another directory rewrites its relative includes to match the same fragments
+TEST_F( ConfigLoaderTest, SavedElsewhereRebasesIncludes )
+{
+	writeFile( "root.yaml",
+		"include: [ \"teams/*.yaml\", \"" + ( dir_ / "extra.yaml" ).generic_string( ) + "\" ]\n"
+		"items: [ { name: Root, timeout: 1 } ]\n" );
+	writeFile( "teams/a.yaml", "items: [ { name: A, timeout: 1 } ]\n" );
+	writeFile( "extra.yaml", "items: [ { name: Extra, timeout: 1 } ]\n" );
+	std::filesystem::create_directories( dir_ / "saved" / "deep" );
+
+	ConfigLoader loader( threadPool_ );
+	auto config = loader.load( dir_ / "root.yaml" );
+	ASSERT_TRUE( config.has_value( ) );
+	EXPECT_EQ( dir_ / "root.yaml", config->rootPath );
+
+	auto savePath = dir_ / "saved" / "deep" / "copy.yaml";
+	auto rebased = ConfigLoader::rebaseIncludes( config->root, config->rootPath.parent_path( ), savePath.parent_path( ) );
+	ASSERT_TRUE( rebased.saveToYaml( savePath ) );
+
+	auto reloaded = loader.load( savePath );
+	ASSERT_TRUE( reloaded.has_value( ) );
+	EXPECT_EQ( ( std::vector<std::string>{ "../../teams/*.yaml", ( dir_ / "extra.yaml" ).generic_string( ) } ),
+		reloaded->root.getIncludes( ) );
+	EXPECT_EQ( ( std::vector<std::string>{ "Root", "A", "Extra" } ), namesOf( reloaded->merged ) );
+	EXPECT_TRUE( loader.getDiagnostics( ).empty( ) );
+
+	// Saving back next to the original leaves the patterns as written
+	auto same = ConfigLoader::rebaseIncludes( config->root, dir_, dir_ / "." );
+	EXPECT_EQ( config->root.getIncludes( ), same.getIncludes( ) );
+}
+
+// Test reloading parses only fragments that changed
+TEST_F( ConfigLoaderTest, ReloadSkipsUnchangedFragments )
+{
+	writeFile( "root.yaml", "include: [ \"teams/*.yaml\" ]\n" );
+	writeFile( "teams/a.yaml", "items: [ { name: A } ]\n" );
+	writeFile( "teams/b.yaml", "items: [ { name: B } ]\n" );
+
+	ConfigLoader loader( threadPool_ );
+	ASSERT_TRUE( loader.load( dir_ / "root.yaml" ).has_value( ) );
+	EXPECT_EQ( 3u, loader.getParsedCount( ) );
+
+	ASSERT_TRUE( loader.load( dir_ / "root.yaml" ).has_value( ) );
+	EXPECT_EQ( 0u, loader.getParsedCount( ) );
+
+	// A changed size or modification time invalidates the cached fragment
+	writeFile( "teams/b.yaml", "items: [ { name: B2 } ]\n" );
+	std::filesystem::last_write_time( dir_ / "teams" / "b.yaml",
+		std::filesystem::last_write_time( dir_ / "teams" / "b.yaml" ) + std::chrono::seconds( 1 ) );
+
+	auto config = loader.load( dir_ / "root.yaml" );
+	ASSERT_TRUE( config.has_value( ) );
+	EXPECT_EQ( 1u, loader.getParsedCount( ) );
+	EXPECT_EQ( ( std::vector<std::string>{ "A", "B2" } ), namesOf( config->merged ) );
+}
+
+// Test each file is validated and its problems carry their positions
+TEST_F( ConfigLoaderTest, ReportsValidationProblems )
+{
+	writeFile( "root.yaml",
+		"include: [ \"teams/*.yaml\" ]\n"
+		"items:\n"
+		"  - { name: Root, timeout: 1 }\n"
+		"  - { name: Root, timeout: 2 }\n" );
+	writeFile( "teams/a.yaml",
+		"items:\n"
+		"  - name: A\n"
+		"    timout: 5\n"
+		"  - plain text\n"
+		"  - { name: Root, timeout: 1 }\n" );
+
+	ConfigLoader loader( threadPool_ );
+	auto config = loader.load( dir_ / "root.yaml" );
+	ASSERT_TRUE( config.has_value( ) );
+	EXPECT_EQ( ( std::vector<std::string>{ "Root", "A" } ), namesOf( config->merged ) );
+
+	// Repeated name in the root, then the fragment's skipped key and entry,
+	// its missing timeout and the name it shares with the root
+	const auto& diagnostics = loader.getDiagnostics( );
+	ASSERT_EQ( 5u, diagnostics.size( ) );
+	EXPECT_EQ( dir_ / "root.yaml", diagnostics[ 0 ].filePath );
+	EXPECT_EQ( 4, diagnostics[ 0 ].line );
+	EXPECT_NE( std::string::npos, diagnostics[ 0 ].message.find( "line 3" ) );
+	EXPECT_EQ( 3, diagnostics[ 1 ].line );
+	EXPECT_NE( std::string::npos, diagnostics[ 1 ].message.find( "'timout'" ) );
+	EXPECT_EQ( 4, diagnostics[ 2 ].line );
+	EXPECT_EQ( 2, diagnostics[ 3 ].line );
+	EXPECT_EQ( 5, diagnostics[ 3 ].column );
+	EXPECT_NE( std::string::npos, diagnostics[ 3 ].message.find( "no timeout" ) );
+	EXPECT_EQ( 0, diagnostics[ 4 ].line );
+	EXPECT_NE( std::string::npos, diagnostics[ 4 ].message.find( "first defined in" ) );
+}
@@ -0,0 +1,304 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+module;
+
+#include <gtest/gtest.h>
+
+export module config_test;
+
+import model.config;
+import model.config_source;
+import model.item;
+import <algorithm>;
+import <filesystem>;
+import <memory_resource>;
+import <fstream>;
+import <string>;
+import <vector>;
+
+// Test fixture for Config tests
+class ConfigTest : public ::testing::Test
+{
+protected:
+	void SetUp( ) override
+	{
+		filePath_ = std::filesystem::temp_directory_path( ) /
+			( "ticks_config_test_" + std::to_string( ::testing::UnitTest::GetInstance( )->random_seed( ) ) + ".yaml" );
+	}
+
+	void TearDown( ) override
+	{
+		std::filesystem::remove( filePath_ );
+	}
+
+	// Write raw YAML to the test file
+	void writeYaml( const std::string& yaml ) const
+	{
+		std::ofstream fout( filePath_ );
+		fout << yaml;
+	}
+
+	std::filesystem::path filePath_;
+};
+
+// Test loading a well-formed configuration
+TEST_F( ConfigTest, LoadItems )
+{
+	writeYaml(
+		"# Comment\n"
+		"items:\n"
+		"  - name: \"Build Project\"\n"
+		"    type: \"Development\"\n"
+		"    action: \"Run make && make install\"\n"
+		"    timeout: 300  # 5 minutes\n"
+		"  - name: Run Tests\n"
+		"    type: Quality\n"
+		"    action: pytest -xvs\n"
+		"    timeout: 120\n" );
+
+	auto config = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( config.has_value( ) );
+	ASSERT_EQ( 2u, config->getItems( ).size( ) );
+	EXPECT_EQ( Item( "Build Project", "Development", "Run make && make install", 300 ), config->getItems( )[ 0 ] );
+	EXPECT_EQ( Item( "Run Tests", "Quality", "pytest -xvs", 120 ), config->getItems( )[ 1 ] );
+}
+
+// Test that missing fields default and unknown content is skipped
+TEST_F( ConfigTest, LoadSkipsUnknownContent )
+{
+	writeYaml(
+		"version: 2\n"
+		"extra: { nested: [ 1, 2, { deep: true } ] }\n"
+		"items:\n"
+		"  - just a scalar\n"
+		"  - [ a, sequence ]\n"
+		"  - name: Partial\n"
+		"    notes: [ one, two ]\n"
+		"    meta: { owner: team }\n"
+		"    action: ~\n"
+		"  - { name: Flow, type: Inline, action: echo, timeout: 5 }\n"
+		"trailer: { items: [ { name: Ignored } ] }\n" );
+
+	auto config = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( config.has_value( ) );
+	ASSERT_EQ( 2u, config->getItems( ).size( ) );
+	EXPECT_EQ( Item( "Partial" ), config->getItems( )[ 0 ] );
+	EXPECT_EQ( Item( "Flow", "Inline", "echo", 5 ), config->getItems( )[ 1 ] );
+}
+
+// Test that root keys following the items sequence are still read as keys
+TEST_F( ConfigTest, LoadRootKeysAfterItems )
+{
+	writeYaml(
+		"items:\n"
+		"  - { name: First, timeout: 1 }\n"
+		"version: 2\n"
+		"max_concurrent: 3\n"
+		"items:\n"
+		"  - { name: Second, timeout: 2 }\n" );
+
+	// The repeated items key is reported and skipped; the first one wins
+	ConfigSource source;
+	auto config = Config::loadFromYaml( filePath_, nullptr, &source );
+	ASSERT_TRUE( config.has_value( ) );
+	ASSERT_EQ( 1u, config->getItems( ).size( ) );
+	EXPECT_EQ( Item( "First", "", "", 1 ), config->getItems( )[ 0 ] );
+	EXPECT_EQ( 3, config->getMaxConcurrent( ) );
+
+	ASSERT_EQ( 1u, source.warnings.size( ) );
+	EXPECT_EQ( 5, source.warnings[ 0 ].line );
+	EXPECT_NE( std::string::npos, source.warnings[ 0 ].message.find( "'items'" ) );
+}
+
+// Test that a file without an items section yields an empty config
+TEST_F( ConfigTest, LoadWithoutItems )
+{
+	writeYaml( "settings:\n  theme: dark\n" );
+
+	auto config = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( config.has_value( ) );
+	EXPECT_TRUE( config->getItems( ).empty( ) );
+}
+
+// Test that malformed values and missing files fail to load
+TEST_F( ConfigTest, LoadFailures )
+{
+	EXPECT_FALSE( Config::loadFromYaml( filePath_ ).has_value( ) );
+
+	writeYaml( "items:\n  - name: Broken\n    timeout: soon\n" );
+	EXPECT_FALSE( Config::loadFromYaml( filePath_ ).has_value( ) );
+
+	writeYaml( "items: [ { name: Unterminated\n" );
+	EXPECT_FALSE( Config::loadFromYaml( filePath_ ).has_value( ) );
+
+	writeYaml( "items:\n  - name: Standup\n    schedule: weekdays 25:00\n" );
+	EXPECT_FALSE( Config::loadFromYaml( filePath_ ).has_value( ) );
+}
+
+// Test that saved configurations load back unchanged
+TEST_F( ConfigTest, SaveRoundTrip )
+{
+	Config config( {
+		Item( "Build Project", "Development", "Run make && make install", 300 ),
+		Item( "Quoted: \"value\"", "Type # not a comment", "- leading dash", 0 ),
+		Item( "", "", "", -5 ),
+		Item( "Standup", "Meeting", "notify", 0, "weekdays 09:00" )
+	} );
+
+	ASSERT_TRUE( config.saveToYaml( filePath_ ) );
+
+	auto loaded = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( loaded.has_value( ) );
+	EXPECT_TRUE( std::ranges::equal( config.getItems( ), loaded->getItems( ) ) );
+}
+
+// Test that an empty configuration round-trips
+TEST_F( ConfigTest, SaveEmpty )
+{
+	ASSERT_TRUE( Config( ).saveToYaml( filePath_ ) );
+
+	auto loaded = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( loaded.has_value( ) );
+	EXPECT_TRUE( loaded->getItems( ).empty( ) );
+}
+
+// Test loading and saving concurrency budgets
+TEST_F( ConfigTest, ResourceClasses )
+{
+	writeYaml(
+		"items: []\n"
+		"max_concurrent: 3\n"
+		"resources:\n"
+		"  - type: Maintenance\n"
+		"    concurrency: 1\n"
+		"    priority: 10\n"
+		"  - { type: Development, priority: -2 }\n" );
+
+	auto config = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( config.has_value( ) );
+	EXPECT_EQ( 3, config->getMaxConcurrent( ) );
+	EXPECT_EQ( ( std::vector<ResourceClass>{ { "Maintenance", 1, 10 }, { "Development", 0, -2 } } ), config->getResourceClasses( ) );
+
+	// Budgets survive item edits and a save
+	auto edited = config->withAddedItem( Item( "Backup Database", "Maintenance" ) );
+	ASSERT_TRUE( edited.saveToYaml( filePath_ ) );
+	auto loaded = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( loaded.has_value( ) );
+	EXPECT_EQ( 1u, loaded->getItems( ).size( ) );
+	EXPECT_EQ( 3, loaded->getMaxConcurrent( ) );
+	EXPECT_EQ( config->getResourceClasses( ), loaded->getResourceClasses( ) );
+
+	writeYaml( "resources:\n  - type: Maintenance\n    concurrency: -1\n" );
+	EXPECT_FALSE( Config::loadFromYaml( filePath_ ).has_value( ) );
+}
+
+// Test retention limits are read from their section, default when absent and survive a save
+TEST_F( ConfigTest, Retention )
+{
+	writeYaml( "items: [ { name: A } ]\n" );
+	auto config = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( config.has_value( ) );
+	EXPECT_EQ( RetentionPolicy{ }, config->getRetention( ) );
+
+	writeYaml(
+		"retention:\n"
+		"  keep_completed: 20\n"
+		"  max_age: 3600\n"
+		"  unknown: { nested: 1 }\n"
+		"items: [ { name: A } ]\n" );
+	config = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( config.has_value( ) );
+	EXPECT_EQ( 20u, config->getRetention( ).keepCompleted );
+	EXPECT_EQ( 3600, config->getRetention( ).maxAgeSeconds );
+	EXPECT_EQ( RetentionPolicy{ }.archiveSize, config->getRetention( ).archiveSize );
+	EXPECT_EQ( 1u, config->getItems( ).size( ) );
+
+	ASSERT_TRUE( config->saveToYaml( filePath_ ) );
+	auto loaded = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( loaded.has_value( ) );
+	EXPECT_EQ( config->getRetention( ), loaded->getRetention( ) );
+
+	writeYaml( "retention: { max_age: -5 }\n" );
+	EXPECT_FALSE( Config::loadFromYaml( filePath_ ).has_value( ) );
+}
+
+// Test include patterns are read as a scalar or a list and survive a save
+TEST_F( ConfigTest, Includes )
+{
+	writeYaml( "include: \"teams/*.yaml\"\nitems: []\n" );
+	auto config = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( config.has_value( ) );
+	EXPECT_EQ( std::vector<std::string>{ "teams/*.yaml" }, config->getIncludes( ) );
+
+	writeYaml( "include: [ \"teams/*.yaml\", shared.yaml ]\nitems: [ { name: Root } ]\n" );
+	config = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( config.has_value( ) );
+	EXPECT_EQ( ( std::vector<std::string>{ "teams/*.yaml", "shared.yaml" } ), config->getIncludes( ) );
+	EXPECT_EQ( 1u, config->getItems( ).size( ) );
+
+	ASSERT_TRUE( config->withAddedItem( Item( "Added" ) ).saveToYaml( filePath_ ) );
+	auto loaded = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( loaded.has_value( ) );
+	EXPECT_EQ( config->getIncludes( ), loaded->getIncludes( ) );
+	EXPECT_EQ( 2u, loaded->getItems( ).size( ) );
+}
+
+// Test items of a version live in its arena, shared by copies and left by copied-out items
+TEST_F( ConfigTest, ItemsLiveInVersionArena )
+{
+	writeYaml(
+		"items:\n"
+		"  - { name: Build Project, type: Development, action: make, timeout: 300 }\n"
+		"  - { name: Run Tests, type: Quality, action: pytest, timeout: 120 }\n" );
+
+	auto config = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( config.has_value( ) );
+	auto* arena = config->getItems( )[ 0 ].get_allocator( ).resource( );
+	EXPECT_NE( std::pmr::get_default_resource( ), arena );
+	EXPECT_EQ( arena, config->getItems( )[ 1 ].get_allocator( ).resource( ) );
+
+	// Copies of the config share the version
+	Config copy = *config;
+	EXPECT_EQ( config->getItems( ).data( ), copy.getItems( ).data( ) );
+
+	// A new version gets its own arena and keeps the old one intact
+	auto edited = config->withAddedItem( Item( "Backup Database" ) );
+	EXPECT_NE( arena, edited.getItems( )[ 0 ].get_allocator( ).resource( ) );
+	EXPECT_EQ( 2u, config->getItems( ).size( ) );
+
+	// Items copied out do not borrow from the arena and outlive it
+	Item item = config->getItems( )[ 0 ];
+	config.reset( );
+	copy = Config( );
+	EXPECT_EQ( std::pmr::get_default_resource( ), item.get_allocator( ).resource( ) );
+	EXPECT_EQ( Item( "Build Project", "Development", "make", 300 ), item );
+}
+
+// Test a caller-provided memory resource replaces the arena
+TEST_F( ConfigTest, CallerMemoryResource )
+{
+	std::pmr::unsynchronized_pool_resource pool;
+	Config config( std::vector<Item>{ Item( "Build Project" ), Item( "Run Tests" ) }, &pool );
+	for( const auto& item : config.getItems( ) )
+		EXPECT_EQ( &pool, item.get_allocator( ).resource( ) );
+
+	auto edited = config.withRemovedItem( Item( "Build Project" ) );
+	ASSERT_EQ( 1u, edited.getItems( ).size( ) );
+	EXPECT_EQ( &pool, edited.getItems( )[ 0 ].get_allocator( ).resource( ) );
+}
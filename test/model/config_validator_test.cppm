@@ -0,0 +1,146 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+module;
+
+#include <gtest/gtest.h>
+
+export module config_validator_test;
+
+import model.config;
+import model.config_validator;
+import model.item;
+import model.thread_pool;
+import <filesystem>;
+import <fstream>;
+import <string>;
+import <vector>;
+
+// Test each kind of problem is found and reported at the item's position
+TEST( ConfigValidatorTest, FindsProblems )
+{
+	ThreadPool threadPool( 2 );
+	ConfigValidator validator( threadPool );
+
+	std::vector<Item> items{
+		Item( "Build", "Development", "make", 300 ),
+		Item( "", "Development", "make", 300 ),
+		Item( "Zero", "", "", 0 ),
+		Item( "Huge", "", "", ConfigValidator::MAX_TIMEOUT + 1 ),
+		Item( "Build", "", "", 60 ),
+		Item( "Stand-up", "", "", 0, "weekdays 09:30" ) };
+	std::vector<ItemSource> sources;
+	for( int i = 0; i < static_cast< int >( items.size( ) ); ++i )
+		sources.push_back( { i + 2, 3, ItemSource::NAME | ItemSource::TIMEOUT } );
+	sources[ 2 ].fields = ItemSource::NAME;
+	sources[ 5 ].fields = ItemSource::NAME | ItemSource::SCHEDULE;
+
+	auto diagnostics = validator.validate( items, sources, "items.yaml" );
+	ASSERT_EQ( 4u, diagnostics.size( ) );
+	EXPECT_EQ( "items.yaml", diagnostics[ 0 ].filePath );
+	EXPECT_EQ( 3, diagnostics[ 0 ].line );
+	EXPECT_EQ( 3, diagnostics[ 0 ].column );
+	EXPECT_EQ( "item has an empty name", diagnostics[ 0 ].message );
+	EXPECT_EQ( "item 'Zero' has no timeout", diagnostics[ 1 ].message );
+	EXPECT_EQ( 5, diagnostics[ 2 ].line );
+	EXPECT_NE( std::string::npos, diagnostics[ 2 ].message.find( "got 86401" ) );
+	EXPECT_EQ( 6, diagnostics[ 3 ].line );
+	EXPECT_EQ( "duplicate item 'Build' ignored, first defined at line 2", diagnostics[ 3 ].message );
+
+	// Without sources only values are checked and problems are not positioned
+	diagnostics = validator.validate( items, { }, "items.yaml" );
+	ASSERT_EQ( 4u, diagnostics.size( ) );
+	EXPECT_EQ( 0, diagnostics[ 0 ].line );
+	EXPECT_EQ( "item has no name", diagnostics[ 0 ].message );
+	EXPECT_NE( std::string::npos, diagnostics[ 1 ].message.find( "got 0" ) );
+	EXPECT_EQ( "duplicate item 'Build' ignored, first defined as item 1", diagnostics[ 3 ].message );
+}
+
+// Test a catalog checked in parallel reports the same problems, in item order
+TEST( ConfigValidatorTest, LargeCatalogInItemOrder )
+{
+	ThreadPool threadPool( 4 );
+	ConfigValidator validator( threadPool );
+
+	// Every 1000th item repeats a name from the start, every 1500th has no timeout
+	constexpr int ITEM_COUNT = 50000;
+	std::vector<Item> items;
+	std::vector<int> expectedLines;
+	for( int i = 0; i < ITEM_COUNT; ++i ) {
+		bool duplicate = i > 0 && i % 1000 == 0;
+		bool zero = i % 1500 == 1;
+		items.emplace_back( "Item " + std::to_string( duplicate ? i / 1000 : i ), "", "", zero ? 0 : 60 );
+		if( duplicate )
+			expectedLines.push_back( i + 1 );
+		if( zero )
+			expectedLines.push_back( i + 1 );
+	}
+
+	std::vector<ItemSource> sources;
+	for( int i = 0; i < ITEM_COUNT; ++i )
+		sources.push_back( { i + 1, 5, ItemSource::NAME | ItemSource::TIMEOUT } );
+
+	auto diagnostics = validator.validate( items, sources, "catalog.yaml" );
+	std::vector<int> lines;
+	for( const auto& diagnostic : diagnostics )
+		lines.push_back( diagnostic.line );
+	EXPECT_EQ( expectedLines, lines );
+	EXPECT_EQ( "duplicate item 'Item 1' ignored, first defined at line 2", diagnostics[ 1 ].message );
+}
+
+// Test loading with a source records item positions, skipped entries and the error
+TEST( ConfigSourceTest, RecordsPositions )
+{
+	auto filePath = std::filesystem::temp_directory_path( ) / "ticks_config_source_test.yaml";
+	{
+		std::ofstream fout( filePath, std::ios::binary | std::ios::trunc );
+		fout << "items:\n"
+			"  - name: A\n"
+			"    timeout: 5\n"
+			"  - [ nested ]\n"
+			"  - { name: B, colour: red }\n";
+	}
+
+	ConfigSource source;
+	auto config = Config::loadFromYaml( filePath, nullptr, &source );
+	ASSERT_TRUE( config.has_value( ) );
+	ASSERT_EQ( 2u, source.items.size( ) );
+	EXPECT_EQ( 2, source.items[ 0 ].line );
+	EXPECT_EQ( 5, source.items[ 0 ].column );
+	EXPECT_TRUE( source.items[ 0 ].has( ItemSource::TIMEOUT ) );
+	EXPECT_FALSE( source.items[ 0 ].has( ItemSource::TYPE ) );
+	EXPECT_EQ( 5, source.items[ 1 ].line );
+	EXPECT_EQ( ItemSource::NAME, source.items[ 1 ].fields );
+	ASSERT_EQ( 2u, source.warnings.size( ) );
+	EXPECT_EQ( 4, source.warnings[ 0 ].line );
+	EXPECT_EQ( 5, source.warnings[ 1 ].line );
+	EXPECT_NE( std::string::npos, source.warnings[ 1 ].message.find( "'colour'" ) );
+	EXPECT_FALSE( source.error.has_value( ) );
+
+	{
+		std::ofstream fout( filePath, std::ios::binary | std::ios::trunc );
+		fout << "items:\n  - { name: A, timeout: soon }\n";
+	}
+	source = ConfigSource{ };
+	EXPECT_FALSE( Config::loadFromYaml( filePath, nullptr, &source ).has_value( ) );
+	ASSERT_TRUE( source.error.has_value( ) );
+	EXPECT_EQ( 2, source.error->line );
+	EXPECT_NE( std::string::npos, source.error->message.find( "'soon'" ) );
+
+	std::filesystem::remove( filePath );
+}
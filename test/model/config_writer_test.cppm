@@ -0,0 +1,177 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+module;
+
+#include <gtest/gtest.h>
+
+export module config_writer_test;
+
+import model.config;
+import model.config_writer;
+import model.item;
+import <atomic>;
+import <filesystem>;
+import <future>;
+import <latch>;
+import <memory>;
+import <string>;
+import <thread>;
+import <vector>;
+
+// Test fixture for ConfigWriter tests
+class ConfigWriterTest : public ::testing::Test
+{
+protected:
+	void SetUp( ) override
+	{
+		filePath_ = std::filesystem::temp_directory_path( ) /
+			( "ticks_config_writer_test_" + std::to_string( ::testing::UnitTest::GetInstance( )->random_seed( ) ) + ".yaml" );
+		std::filesystem::remove( filePath_ );
+	}
+
+	void TearDown( ) override
+	{
+		std::filesystem::remove( filePath_ );
+	}
+
+	// Create a snapshot with the given number of items
+	static ConfigWriter::Snapshot createSnapshot( int itemCount )
+	{
+		std::vector<Item> items;
+		for( int i = 0; i < itemCount; ++i )
+			items.emplace_back( "Item " + std::to_string( i ), "Type", "Action", i + 1 );
+		return std::make_shared<const Config>( std::move( items ) );
+	}
+
+	// Count temporary siblings of the file left in its directory
+	[[nodiscard]] std::size_t countTempFiles( ) const
+	{
+		auto prefix = filePath_.filename( ).string( ) + ".";
+		std::size_t count = 0;
+		for( const auto& entry : std::filesystem::directory_iterator( filePath_.parent_path( ) ) ) {
+			auto name = entry.path( ).filename( ).string( );
+			if( name.starts_with( prefix ) && name.ends_with( ".tmp" ) )
+				++count;
+		}
+		return count;
+	}
+
+	std::filesystem::path filePath_;
+};
+
+// Test that a requested save is written once flushed
+TEST_F( ConfigWriterTest, SaveIsWrittenOnFlush )
+{
+	std::atomic<int> savedCount = 0;
+	ConfigWriter writer( [&savedCount]( const std::filesystem::path&, bool saved )
+		{
+			if( saved )
+				++savedCount;
+		} );
+
+	writer.requestSave( createSnapshot( 3 ), filePath_ );
+	writer.flush( );
+
+	EXPECT_EQ( 1, savedCount );
+
+	auto loaded = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( loaded.has_value( ) );
+	EXPECT_EQ( 3u, loaded->getItems( ).size( ) );
+
+	// No temporary file is left behind
+	EXPECT_EQ( 0u, countTempFiles( ) );
+}
+
+// Test that concurrent saves of one file never clobber each other's temporary file
+TEST_F( ConfigWriterTest, ConcurrentSavesOfOneFile )
+{
+	constexpr int SAVE_COUNT = 50;
+
+	std::atomic<int> failedCount = 0;
+	auto save = [this, &failedCount]( int itemCount )
+		{
+			auto snapshot = createSnapshot( itemCount );
+			for( int i = 0; i < SAVE_COUNT; ++i )
+				if( !snapshot->saveToYaml( filePath_ ) )
+					++failedCount;
+		};
+	std::thread first( save, 10 );
+	std::thread second( save, 20 );
+	first.join( );
+	second.join( );
+
+	EXPECT_EQ( 0, failedCount );
+	auto loaded = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( loaded.has_value( ) );
+	auto size = loaded->getItems( ).size( );
+	EXPECT_TRUE( size == 10u || size == 20u );
+	EXPECT_EQ( 0u, countTempFiles( ) );
+}
+
+// Test that saves requested during a write collapse and the latest snapshot wins
+TEST_F( ConfigWriterTest, BackToBackSavesCoalesce )
+{
+	constexpr int REQUEST_COUNT = 50;
+
+	// The first save blocks until every other request is queued
+	std::promise<void> firstStarted;
+	std::latch release( 1 );
+	std::atomic<int> saveCalls = 0;
+	std::atomic<int> savedCount = 0;
+	ConfigWriter writer( [&savedCount]( const std::filesystem::path&, bool saved )
+		{
+			if( saved )
+				++savedCount;
+		},
+		[&firstStarted, &release, &saveCalls]( const Config& config, const std::filesystem::path& filePath )
+		{
+			if( saveCalls++ == 0 ) {
+				firstStarted.set_value( );
+				release.wait( );
+			}
+			return config.saveToYaml( filePath );
+		} );
+
+	writer.requestSave( createSnapshot( 1 ), filePath_ );
+	firstStarted.get_future( ).wait( );
+	for( int i = 2; i <= REQUEST_COUNT; ++i )
+		writer.requestSave( createSnapshot( i ), filePath_ );
+	release.count_down( );
+	writer.flush( );
+
+	EXPECT_EQ( 2, savedCount );
+	EXPECT_EQ( 2, saveCalls );
+
+	auto loaded = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( loaded.has_value( ) );
+	EXPECT_EQ( static_cast< size_t >( REQUEST_COUNT ), loaded->getItems( ).size( ) );
+}
+
+// Test that pending saves are written when the writer is destroyed
+TEST_F( ConfigWriterTest, DestructorDrainsPendingSaves )
+{
+	{
+		ConfigWriter writer;
+		writer.requestSave( createSnapshot( 2 ), filePath_ );
+	}
+
+	auto loaded = Config::loadFromYaml( filePath_ );
+	ASSERT_TRUE( loaded.has_value( ) );
+	EXPECT_EQ( 2u, loaded->getItems( ).size( ) );
+}
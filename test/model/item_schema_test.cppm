@@ -0,0 +1,128 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+module;
+
+#include <gtest/gtest.h>
+
+export module item_schema_test;
+
+import model.item;
+import model.item_schema;
+import <limits>;
+import <optional>;
+import <string>;
+import <string_view>;
+import <tuple>;
+import <vector>;
+
+// Test the descriptors follow the constructor and their keys resolve at compile time
+TEST( ItemSchemaTest, Fields )
+{
+	static_assert( ItemSchema::FIELD_COUNT == 5 );
+	static_assert( ItemSchema::indexOf( "name" ) == 0 );
+	static_assert( ItemSchema::indexOf( "schedule" ) == 4 );
+	static_assert( ItemSchema::indexOf( "colour" ) == ItemSchema::FIELD_COUNT );
+	static_assert( ItemSchema::countFields( ItemSchema::TIMER_COLUMN ) == 3 );
+
+	ItemSchema::Values values;
+	EXPECT_TRUE( ItemSchema::parseField( values, ItemSchema::indexOf( "name" ), "Build" ) );
+	EXPECT_TRUE( ItemSchema::parseField( values, ItemSchema::indexOf( "timeout" ), "+300" ) );
+	EXPECT_TRUE( ItemSchema::parseField( values, ItemSchema::indexOf( "schedule" ), "every 5m" ) );
+	EXPECT_FALSE( ItemSchema::parseField( values, ItemSchema::indexOf( "timeout" ), "soon" ) );
+	EXPECT_FALSE( ItemSchema::parseField( values, ItemSchema::indexOf( "timeout" ), "" ) );
+	EXPECT_FALSE( ItemSchema::parseField( values, ItemSchema::indexOf( "schedule" ), "weekdays 25:00" ) );
+	EXPECT_EQ( Item( "Build", "", "", 300, "every 5m" ), ItemSchema::makeItem( values ) );
+
+	ItemSchema::reset( values );
+	EXPECT_EQ( Item( ), ItemSchema::makeItem( values ) );
+}
+
+// Test items survive the binary form and damaged bytes are rejected
+TEST( ItemSchemaTest, BinaryRoundTrip )
+{
+	for( const auto& item : { Item( ), Item( "Build Project", "Development", "make && make install", 300 ),
+		Item( "Zażółć", "Ünïcode", std::string( 300, 'x' ), -5, "weekdays 09:30" ) } ) {
+		std::string bytes;
+		ItemSchema::encode( item, bytes );
+		auto decoded = ItemSchema::decode( bytes );
+		ASSERT_TRUE( decoded.has_value( ) );
+		EXPECT_EQ( item, *decoded );
+
+		for( std::size_t length = 0; length < bytes.size( ); ++length )
+			EXPECT_FALSE( ItemSchema::decode( std::string_view( bytes ).substr( 0, length ) ).has_value( ) ) << length;
+		EXPECT_FALSE( ItemSchema::decode( bytes + "x" ).has_value( ) );
+	}
+}
+
+// Test integers beyond the range of int are rejected rather than wrapped
+TEST( ItemSchemaTest, BinaryIntegerRange )
+{
+	// Three empty strings, the timeout varint, then an empty schedule
+	auto withTimeout = []( std::string_view varint ) { return std::string( "\x05\0\0\0", 4 ) + std::string( varint ) + '\0'; };
+
+	std::string bytes;
+	ItemSchema::encode( Item( "", "", "", std::numeric_limits<int>::max( ) ), bytes );
+	EXPECT_EQ( withTimeout( "\xFE\xFF\xFF\xFF\x0F" ), bytes );
+
+	auto largest = ItemSchema::decode( withTimeout( "\xFE\xFF\xFF\xFF\x0F" ) );
+	ASSERT_TRUE( largest.has_value( ) );
+	EXPECT_EQ( std::numeric_limits<int>::max( ), largest->getTimeout( ) );
+	auto smallest = ItemSchema::decode( withTimeout( "\xFF\xFF\xFF\xFF\x0F" ) );
+	ASSERT_TRUE( smallest.has_value( ) );
+	EXPECT_EQ( std::numeric_limits<int>::min( ), smallest->getTimeout( ) );
+
+	EXPECT_FALSE( ItemSchema::decode( withTimeout( "\x80\x80\x80\x80\x10" ) ).has_value( ) );
+	EXPECT_FALSE( ItemSchema::decode( withTimeout( "\x81\x80\x80\x80\x10" ) ).has_value( ) );
+}
+
+// Test hashing covers every field
+TEST( ItemSchemaTest, Hash )
+{
+	Item item( "Build", "Development", "make", 300, "every 5m" );
+	EXPECT_EQ( ItemSchema::hash( item ), ItemSchema::hash( Item( item ) ) );
+	for( const auto& other : { item.withName( "Test" ), item.withType( "Quality" ), item.withAction( "make test" ),
+		item.withTimeout( 301 ), item.withSchedule( "" ), Item( "Buil", "dDevelopment", "make", 300, "every 5m" ) } )
+		EXPECT_NE( ItemSchema::hash( item ), ItemSchema::hash( other ) );
+}
+
+// Test list columns and their text
+TEST( ItemSchemaTest, Columns )
+{
+	std::vector<std::string> labels;
+	ItemSchema::forEachColumn( [&labels]( std::size_t column, std::string_view label )
+		{
+			EXPECT_EQ( labels.size( ), column );
+			labels.emplace_back( label );
+		} );
+	EXPECT_EQ( ( std::vector<std::string>{ "Name", "Type", "Action", "Timeout", "Schedule" } ), labels );
+
+	std::vector<std::string> texts;
+	ItemSchema::formatColumns( Item( "Build", "Development", "make", -30 ), [&texts]( std::size_t, std::string_view text )
+		{
+			texts.emplace_back( text );
+		} );
+	EXPECT_EQ( ( std::vector<std::string>{ "Build", "Development", "make", "-30", "" } ), texts );
+
+	texts.clear( );
+	ItemSchema::formatColumns( Item( "Build", "Development", "make", 30 ), [&texts]( std::size_t, std::string_view text )
+		{
+			texts.emplace_back( text );
+		}, ItemSchema::TIMER_COLUMN );
+	EXPECT_EQ( ( std::vector<std::string>{ "Build", "Development", "make" } ), texts );
+}
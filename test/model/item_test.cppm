@@ -23,7 +23,9 @@ module;
 export module item_test;
 
 import model.item;
+import <memory_resource>;
 import <string>;
+import <vector>;
 
 // Test fixture for Item tests
 class ItemTest : public ::testing::Test
@@ -173,3 +175,21 @@ TEST_F( ItemTest, FunctionalComposition )
 	EXPECT_EQ( TEST_ACTION, newItem.getAction( ) );
 	EXPECT_EQ( TEST_TIMEOUT, newItem.getTimeout( ) );
 }
+
+// Test pmr containers construct items in their memory resource
+TEST_F( ItemTest, UsesContainerAllocator )
+{
+	std::pmr::monotonic_buffer_resource arena;
+	std::pmr::vector<Item> items( &arena );
+	items.push_back( createTestItem( ) );
+	items.emplace_back( TEST_NAME, TEST_TYPE, TEST_ACTION, TEST_TIMEOUT );
+
+	EXPECT_EQ( &arena, items[ 0 ].get_allocator( ).resource( ) );
+	EXPECT_EQ( &arena, items[ 1 ].get_allocator( ).resource( ) );
+	EXPECT_EQ( items[ 0 ], items[ 1 ] );
+
+	// Plain copies and derived items use the default resource
+	Item copy = items[ 0 ];
+	EXPECT_EQ( std::pmr::get_default_resource( ), copy.get_allocator( ).resource( ) );
+	EXPECT_EQ( std::pmr::get_default_resource( ), items[ 0 ].withTimeout( 1 ).get_allocator( ).resource( ) );
+}
@@ -0,0 +1,284 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+module;
+
+#include <gtest/gtest.h>
+
+export module run_history_test;
+
+import model.run_history;
+import model.run_statistics;
+import model.item;
+import <algorithm>;
+import <cmath>;
+import <cstdint>;
+import <filesystem>;
+import <fstream>;
+import <numeric>;
+import <random>;
+import <string>;
+import <vector>;
+
+// Test fixture for RunHistory tests
+class RunHistoryTest : public ::testing::Test
+{
+protected:
+	void SetUp( ) override
+	{
+		filePath_ = std::filesystem::temp_directory_path( ) /
+			( "ticks_run_history_test_" + std::to_string( ::testing::UnitTest::GetInstance( )->random_seed( ) ) + ".bin" );
+		removeFiles( );
+	}
+
+	void TearDown( ) override
+	{
+		removeFiles( );
+	}
+
+	void removeFiles( ) const
+	{
+		std::filesystem::remove( filePath_ );
+		std::filesystem::remove( snapshotPath( ) );
+	}
+
+	[[nodiscard]] std::filesystem::path snapshotPath( ) const
+	{
+		auto path = filePath_;
+		path += ".stats";
+		return path;
+	}
+
+	// Record count completed runs of the given durations in seconds
+	static void recordRuns( RunHistory& history, std::uint64_t key, const std::vector<int>& durations )
+	{
+		std::int64_t start = 1'700'000'000'000;
+		for( auto seconds : durations ) {
+			history.record( RunRecord{ key, start, seconds * 1000ll, RunOutcome::Completed } );
+			start += 3'600'000;
+		}
+	}
+
+	const std::uint64_t KEY = RunHistory::keyOf( Item( "Build Project" ) );
+	std::filesystem::path filePath_;
+};
+
+// Test the quantile sketch tracks the distribution of many observations
+TEST( QuantileEstimatorTest, ApproximatesQuantiles )
+{
+	std::vector<double> values( 10'000 );
+	std::iota( values.begin( ), values.end( ), 1.0 );
+	std::shuffle( values.begin( ), values.end( ), std::mt19937( 42 ) );
+
+	QuantileEstimator median( 0.5 );
+	QuantileEstimator p90( 0.9 );
+	for( auto value : values ) {
+		median.add( value );
+		p90.add( value );
+	}
+
+	EXPECT_NEAR( 5'000.0, median.getEstimate( ), 150.0 );
+	EXPECT_NEAR( 9'000.0, p90.getEstimate( ), 150.0 );
+}
+
+// Test the quantile sketch is exact for few observations
+TEST( QuantileEstimatorTest, FewObservations )
+{
+	QuantileEstimator median( 0.5 );
+	EXPECT_TRUE( std::isnan( median.getEstimate( ) ) );
+
+	median.add( 30.0 );
+	median.add( 10.0 );
+	median.add( 20.0 );
+	EXPECT_DOUBLE_EQ( 20.0, median.getEstimate( ) );
+}
+
+// Test only completed runs feed the statistics
+TEST_F( RunHistoryTest, RecordsCompletedRuns )
+{
+	RunHistory history( filePath_ );
+	EXPECT_EQ( nullptr, history.getStatistics( KEY ) );
+
+	recordRuns( history, KEY, { 100, 200, 300 } );
+	history.record( RunRecord{ KEY, 0, 5'000'000, RunOutcome::Aborted } );
+
+	const auto* statistics = history.getStatistics( KEY );
+	ASSERT_NE( nullptr, statistics );
+	EXPECT_EQ( 3u, statistics->getCount( ) );
+	EXPECT_DOUBLE_EQ( 200.0, statistics->getMedian( ).getEstimate( ) );
+	EXPECT_GT( statistics->getAverage( ), 100.0 );
+	EXPECT_LT( statistics->getAverage( ), 300.0 );
+}
+
+// Test statistics survive reopening, from the snapshot or by replaying the history
+TEST_F( RunHistoryTest, ReopenRestoresStatistics )
+{
+	std::vector<int> durations( 500 );
+	for( std::size_t i = 0; i < durations.size( ); ++i )
+		durations[ i ] = 60 + static_cast< int >( i % 120 );
+
+	double median = 0.0;
+	double average = 0.0;
+	{
+		RunHistory history( filePath_ );
+		recordRuns( history, KEY, durations );
+		median = history.getStatistics( KEY )->getMedian( ).getEstimate( );
+		average = history.getStatistics( KEY )->getAverage( );
+	}
+
+	// The snapshot covers the whole history, so nothing is replayed
+	{
+		RunHistory history( filePath_ );
+		EXPECT_EQ( 0u, history.getReplayedCount( ) );
+		ASSERT_NE( nullptr, history.getStatistics( KEY ) );
+		EXPECT_EQ( durations.size( ), history.getStatistics( KEY )->getCount( ) );
+		EXPECT_DOUBLE_EQ( median, history.getStatistics( KEY )->getMedian( ).getEstimate( ) );
+		EXPECT_DOUBLE_EQ( average, history.getStatistics( KEY )->getAverage( ) );
+	}
+
+	// Without a snapshot the raw history is replayed
+	std::filesystem::remove( snapshotPath( ) );
+	{
+		RunHistory history( filePath_ );
+		EXPECT_EQ( durations.size( ), history.getReplayedCount( ) );
+		ASSERT_NE( nullptr, history.getStatistics( KEY ) );
+		EXPECT_DOUBLE_EQ( median, history.getStatistics( KEY )->getMedian( ).getEstimate( ) );
+		EXPECT_DOUBLE_EQ( average, history.getStatistics( KEY )->getAverage( ) );
+	}
+}
+
+// Test runs recorded after the snapshot are replayed on top of it
+TEST_F( RunHistoryTest, ReplaysRunsNewerThanSnapshot )
+{
+	{
+		RunHistory history( filePath_ );
+		recordRuns( history, KEY, { 10, 20 } );
+		history.flush( );
+		history.saveSnapshot( );
+		recordRuns( history, KEY, { 30 } );
+		history.flush( );
+
+		// Simulate a crash: keep the stale snapshot
+		std::filesystem::copy_file( snapshotPath( ), snapshotPath( ).string( ) + ".keep" );
+	}
+	std::filesystem::rename( snapshotPath( ).string( ) + ".keep", snapshotPath( ) );
+
+	RunHistory history( filePath_ );
+	EXPECT_EQ( 1u, history.getReplayedCount( ) );
+	ASSERT_NE( nullptr, history.getStatistics( KEY ) );
+	EXPECT_EQ( 3u, history.getStatistics( KEY )->getCount( ) );
+}
+
+// Test a partially written block is ignored and overwritten
+TEST_F( RunHistoryTest, IgnoresTruncatedBlock )
+{
+	{
+		RunHistory history( filePath_ );
+		recordRuns( history, KEY, { 10, 20 } );
+	}
+	std::filesystem::remove( snapshotPath( ) );
+	{
+		std::ofstream fout( filePath_, std::ios::binary | std::ios::app );
+		fout << "TRKB\x05";
+	}
+
+	{
+		RunHistory history( filePath_ );
+		EXPECT_EQ( 2u, history.getReplayedCount( ) );
+		recordRuns( history, KEY, { 30 } );
+	}
+	std::filesystem::remove( snapshotPath( ) );
+
+	RunHistory history( filePath_ );
+	EXPECT_EQ( 3u, history.getReplayedCount( ) );
+}
+
+// Test block headers whose sizes cannot hold their runs stop the replay
+TEST_F( RunHistoryTest, IgnoresCorruptBlockHeader )
+{
+	{
+		RunHistory history( filePath_ );
+		recordRuns( history, KEY, { 10, 20 } );
+	}
+	std::filesystem::remove( snapshotPath( ) );
+
+	// Header fields are little-endian: magic, run count, payload size
+	auto appendBlock = [this]( std::uint32_t count, std::uint32_t payloadSize, std::size_t payloadBytes )
+	{
+		std::string block = "TRKB";
+		for( auto value : { count, payloadSize } ) {
+			for( int shift = 0; shift < 32; shift += 8 )
+				block += static_cast< char >( ( value >> shift ) & 0xFF );
+		}
+		block.append( payloadBytes, '\0' );
+
+		std::ofstream fout( filePath_, std::ios::binary | std::ios::app );
+		fout.write( block.data( ), static_cast< std::streamsize >( block.size( ) ) );
+	};
+
+	// More runs than the payload can encode
+	appendBlock( 0xFFFFFFFF, 16, 16 );
+	{
+		RunHistory history( filePath_ );
+		EXPECT_EQ( 2u, history.getReplayedCount( ) );
+	}
+	std::filesystem::remove( snapshotPath( ) );
+
+	std::filesystem::resize_file( filePath_, std::filesystem::file_size( filePath_ ) - 28 );
+	// A payload size beyond the end of the file
+	appendBlock( 2, 0xFFFFFFF0, 16 );
+	{
+		RunHistory history( filePath_ );
+		EXPECT_EQ( 2u, history.getReplayedCount( ) );
+		recordRuns( history, KEY, { 30 } );
+	}
+	std::filesystem::remove( snapshotPath( ) );
+
+	RunHistory history( filePath_ );
+	EXPECT_EQ( 3u, history.getReplayedCount( ) );
+}
+
+// Test two histories on one file keep each other's blocks and share statistics
+TEST_F( RunHistoryTest, SharedFileKeepsBlocksOfBoth )
+{
+	{
+		RunHistory first( filePath_ );
+		RunHistory second( filePath_ );
+
+		recordRuns( first, KEY, { 10, 20 } );
+		ASSERT_TRUE( first.flush( ) );
+		recordRuns( second, KEY, { 30, 40, 50 } );
+		ASSERT_TRUE( second.flush( ) );
+		recordRuns( first, KEY, { 60 } );
+		ASSERT_TRUE( first.flush( ) );
+
+		// Each append took in the blocks the other wrote before it
+		EXPECT_EQ( 6u, first.getStatistics( KEY )->getCount( ) );
+		EXPECT_EQ( 5u, second.getStatistics( KEY )->getCount( ) );
+	}
+
+	{
+		RunHistory history( filePath_ );
+		ASSERT_NE( nullptr, history.getStatistics( KEY ) );
+		EXPECT_EQ( 6u, history.getStatistics( KEY )->getCount( ) );
+	}
+	std::filesystem::remove( snapshotPath( ) );
+
+	RunHistory history( filePath_ );
+	EXPECT_EQ( 6u, history.getReplayedCount( ) );
+}
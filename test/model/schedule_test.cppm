@@ -0,0 +1,192 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+module;
+
+#include <gtest/gtest.h>
+
+export module schedule_test;
+
+import model.schedule;
+import <chrono>;
+import <cstdlib>;
+import <ctime>;
+import <optional>;
+import <string>;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+	// Local time of a day in January 2024, when clocks do not change; the 1st was a Monday
+	Schedule::TimePoint localTime( int day, int hour, int minute, int second = 0 )
+	{
+		std::tm local{ };
+		local.tm_year = 2024 - 1900;
+		local.tm_mon = 0;
+		local.tm_mday = day;
+		local.tm_hour = hour;
+		local.tm_min = minute;
+		local.tm_sec = second;
+		local.tm_isdst = -1;
+		return Schedule::Clock::from_time_t( std::mktime( &local ) );
+	}
+}
+
+// Test valid expressions compile and invalid ones are rejected
+TEST( ScheduleTest, Parse )
+{
+	for( auto expression : { "every 90s", "Every 1h30m", "09:00", "daily 12:00 18:30", "weekdays 09:00",
+		"weekends 10:30", "mon,thu 08:30", "fri-mon *:15" } )
+		EXPECT_TRUE( Schedule::parse( expression ).has_value( ) ) << expression;
+
+	for( auto expression : { "", "every", "every 0s", "every 5", "every 5x", "weekdays", "25:00", "9:5",
+		"12:60", "someday 09:00", "every 5s 09:00" } )
+		EXPECT_FALSE( Schedule::parse( expression ).has_value( ) ) << expression;
+
+	auto interval = Schedule::parse( "every 1h30m" );
+	ASSERT_TRUE( interval.has_value( ) );
+	EXPECT_EQ( Schedule::Kind::Interval, interval->getKind( ) );
+	EXPECT_EQ( 90min, interval->getInterval( ) );
+}
+
+// Test interval series skip missed occurrences and keep their phase
+TEST( ScheduleTest, IntervalSeries )
+{
+	auto schedule = Schedule::parse( "every 10s" );
+	ASSERT_TRUE( schedule.has_value( ) );
+
+	auto start = Schedule::TimePoint( 1'000'000s );
+	EXPECT_EQ( start + 10s, schedule->nextAfter( start ) );
+	EXPECT_EQ( start + 10s, schedule->nextInSeries( start, start + 3s ) );
+	EXPECT_EQ( start + 50s, schedule->nextInSeries( start, start + 45s ) );
+	EXPECT_EQ( start + 50s, schedule->nextInSeries( start, start + 40s ) );
+}
+
+// Test calendar schedules find the next time on a matching day
+TEST( ScheduleTest, CalendarNextAfter )
+{
+	auto daily = Schedule::parse( "08:00 17:30" );
+	ASSERT_TRUE( daily.has_value( ) );
+	EXPECT_EQ( Schedule::Kind::Calendar, daily->getKind( ) );
+	EXPECT_EQ( localTime( 3, 8, 0 ), daily->nextAfter( localTime( 3, 7, 59, 30 ) ) );
+	EXPECT_EQ( localTime( 3, 17, 30 ), daily->nextAfter( localTime( 3, 8, 0 ) ) );
+	EXPECT_EQ( localTime( 4, 8, 0 ), daily->nextAfter( localTime( 3, 17, 30 ) ) );
+
+	// Friday evening moves on to Monday
+	auto weekdays = Schedule::parse( "weekdays 09:00" );
+	ASSERT_TRUE( weekdays.has_value( ) );
+	EXPECT_EQ( localTime( 8, 9, 0 ), weekdays->nextAfter( localTime( 5, 18, 0 ) ) );
+	EXPECT_EQ( localTime( 9, 9, 0 ), weekdays->nextAfter( localTime( 8, 9, 0 ) ) );
+
+	// A single day a week waits up to seven days, including the same day next week
+	auto weekly = Schedule::parse( "mon 09:00" );
+	ASSERT_TRUE( weekly.has_value( ) );
+	EXPECT_EQ( localTime( 8, 9, 0 ), weekly->nextAfter( localTime( 1, 9, 0 ) ) );
+
+	auto hourly = Schedule::parse( "sat-sun *:15" );
+	ASSERT_TRUE( hourly.has_value( ) );
+	EXPECT_EQ( localTime( 6, 0, 15 ), hourly->nextAfter( localTime( 4, 12, 0 ) ) );
+	EXPECT_EQ( localTime( 6, 13, 15 ), hourly->nextAfter( localTime( 6, 12, 20 ) ) );
+	EXPECT_EQ( localTime( 13, 0, 15 ), hourly->nextAfter( localTime( 7, 23, 15 ) ) );
+}
+
+#ifndef _WIN32
+
+// Test fixture running in central European time, whose clock changes are known
+class ScheduleDstTest : public ::testing::Test
+{
+protected:
+	void SetUp( ) override
+	{
+		if( const char* zone = std::getenv( "TZ" ) )
+			savedZone_ = zone;
+		::setenv( "TZ", "CET-1CEST,M3.5.0,M10.5.0/3", 1 );
+		::tzset( );
+	}
+
+	void TearDown( ) override
+	{
+		if( savedZone_ )
+			::setenv( "TZ", savedZone_->c_str( ), 1 );
+		else
+			::unsetenv( "TZ" );
+		::tzset( );
+	}
+
+	// A UTC time in 2024
+	static Schedule::TimePoint utcTime( int month, int day, int hour, int minute )
+	{
+		using namespace std::chrono;
+		return sys_days{ year{ 2024 } / month / day } + hours{ hour } + minutes{ minute };
+	}
+
+	// Let mktime last see a summer or a winter time, which sways how it guesses ambiguous ones
+	static void primeGuess( int month )
+	{
+		std::tm local{ };
+		local.tm_year = 2024 - 1900;
+		local.tm_mon = month - 1;
+		local.tm_mday = 1;
+		local.tm_hour = 12;
+		local.tm_isdst = -1;
+		std::mktime( &local );
+	}
+
+	std::optional<std::string> savedZone_;
+};
+
+// Test the repeated hour when clocks go back on 27 October, 03:00 CEST to 02:00 CET
+TEST_F( ScheduleDstTest, FallBack )
+{
+	auto schedule = Schedule::parse( "02:30" );
+	ASSERT_TRUE( schedule.has_value( ) );
+
+	for( int month : { 1, 7 } ) {
+		primeGuess( month );
+
+		// Before the change the first 02:30, at 00:30 UTC, comes next
+		EXPECT_EQ( utcTime( 10, 27, 0, 30 ), schedule->nextAfter( utcTime( 10, 27, 0, 10 ) ) );
+
+		// Once it passed, the repeated 02:30 does not run again that day
+		EXPECT_EQ( utcTime( 10, 28, 1, 30 ), schedule->nextAfter( utcTime( 10, 27, 0, 30 ) ) );
+
+		// Starting in the repeated hour, the earlier 02:30 lies before the start and the later one is taken
+		EXPECT_EQ( utcTime( 10, 27, 1, 30 ), schedule->nextAfter( utcTime( 10, 27, 1, 10 ) ) );
+	}
+}
+
+// Test the skipped hour when clocks go forward on 31 March, 02:00 CET to 03:00 CEST
+TEST_F( ScheduleDstTest, SpringForward )
+{
+	auto schedule = Schedule::parse( "02:30" );
+	ASSERT_TRUE( schedule.has_value( ) );
+
+	for( int month : { 1, 7 } ) {
+		primeGuess( month );
+
+		// The missing 02:30 runs as 03:30 CEST, then the days after keep their 02:30 CEST
+		EXPECT_EQ( utcTime( 3, 31, 1, 30 ), schedule->nextAfter( utcTime( 3, 31, 0, 0 ) ) );
+		EXPECT_EQ( utcTime( 4, 1, 0, 30 ), schedule->nextAfter( utcTime( 3, 31, 1, 30 ) ) );
+
+		// The day before still runs in winter time
+		EXPECT_EQ( utcTime( 3, 30, 1, 30 ), schedule->nextAfter( utcTime( 3, 30, 0, 0 ) ) );
+	}
+}
+
+#endif
@@ -0,0 +1,385 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+module;
+
+#include <gtest/gtest.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+export module shared_timer_table_test;
+
+import model.shared_timer_table;
+import <atomic>;
+import <cstdint>;
+import <memory>;
+import <optional>;
+import <set>;
+import <string>;
+import <thread>;
+import <vector>;
+
+#ifndef _WIN32
+
+// Test fixture for SharedTimerTable tests
+class SharedTimerTableTest : public ::testing::Test
+{
+protected:
+	void SetUp( ) override
+	{
+		name_ = "/ticks-test-" + std::to_string( ::getpid( ) ) + "-" +
+			std::to_string( ::testing::UnitTest::GetInstance( )->random_seed( ) );
+		SharedTimerTable::unlink( name_ );
+	}
+
+	void TearDown( ) override
+	{
+		SharedTimerTable::unlink( name_ );
+	}
+
+	[[nodiscard]] static SharedTimerState makeState( const std::string& name, std::int64_t deadline )
+	{
+		SharedTimerState state;
+		state.name = name;
+		state.type = "Maintenance";
+		state.action = "backup";
+		state.deadline = deadline;
+		state.duration = 60'000;
+		state.running = true;
+		return state;
+	}
+
+	std::string name_;
+};
+
+// Test published timers are visible through another mapping of the segment
+TEST_F( SharedTimerTableTest, PublishIsVisibleToOtherMappings )
+{
+	auto owner = SharedTimerTable::open( name_ );
+	auto viewer = SharedTimerTable::open( name_ );
+	ASSERT_NE( nullptr, owner );
+	ASSERT_NE( nullptr, viewer );
+
+	auto slot = owner->claim( );
+	ASSERT_TRUE( slot.has_value( ) );
+
+	// Claimed but unpublished slots are not listed
+	EXPECT_TRUE( viewer->snapshot( ).empty( ) );
+
+	owner->publish( *slot, makeState( "Backup Database", 1'234 ) );
+	auto entries = viewer->snapshot( );
+	ASSERT_EQ( 1u, entries.size( ) );
+	EXPECT_EQ( *slot, entries[ 0 ].slot );
+	EXPECT_EQ( owner->getProcessId( ), entries[ 0 ].ownerPid );
+	EXPECT_EQ( "Backup Database", entries[ 0 ].state.name );
+	EXPECT_EQ( "Maintenance", entries[ 0 ].state.type );
+	EXPECT_EQ( 1'234, entries[ 0 ].state.deadline );
+	EXPECT_TRUE( entries[ 0 ].state.running );
+	EXPECT_FALSE( entries[ 0 ].state.completed );
+
+	owner->release( *slot );
+	EXPECT_TRUE( viewer->snapshot( ).empty( ) );
+}
+
+// Test long text is truncated without splitting a UTF-8 character
+TEST_F( SharedTimerTableTest, TruncatesText )
+{
+	auto table = SharedTimerTable::open( name_ );
+	ASSERT_NE( nullptr, table );
+
+	auto slot = table->claim( );
+	ASSERT_TRUE( slot.has_value( ) );
+	table->publish( *slot, makeState( std::string( 62, 'a' ) + "\xC5\xBC" + "tail", 0 ) );
+
+	auto entry = table->read( *slot );
+	ASSERT_TRUE( entry.has_value( ) );
+	EXPECT_EQ( std::string( 62, 'a' ), entry->state.name );
+}
+
+// Test commands reach the owner only for the slot generation they were posted for
+TEST_F( SharedTimerTableTest, Commands )
+{
+	auto owner = SharedTimerTable::open( name_ );
+	auto viewer = SharedTimerTable::open( name_ );
+	ASSERT_NE( nullptr, owner );
+	ASSERT_NE( nullptr, viewer );
+
+	auto slot = owner->claim( );
+	ASSERT_TRUE( slot.has_value( ) );
+	owner->publish( *slot, makeState( "Build Project", 0 ) );
+	auto generation = viewer->read( *slot )->generation;
+
+	EXPECT_EQ( SharedTimerCommand::None, owner->takeCommand( *slot ) );
+	EXPECT_TRUE( viewer->postCommand( *slot, generation, SharedTimerCommand::Stop ) );
+	EXPECT_FALSE( viewer->postCommand( *slot, generation, SharedTimerCommand::Reset ) ); // One pending at a time
+	EXPECT_EQ( SharedTimerCommand::Stop, owner->takeCommand( *slot ) );
+	EXPECT_EQ( SharedTimerCommand::None, owner->takeCommand( *slot ) );
+
+	// After the slot is reused, commands for the old timer are rejected
+	owner->release( *slot );
+	auto reused = owner->claim( );
+	ASSERT_EQ( slot, reused );
+	EXPECT_FALSE( viewer->postCommand( *slot, generation, SharedTimerCommand::Start ) );
+}
+
+// Test concurrent claims from many mappings never hand out a slot twice
+TEST_F( SharedTimerTableTest, ConcurrentClaimsAreUnique )
+{
+	constexpr int THREAD_COUNT = 8;
+	std::vector<std::unique_ptr<SharedTimerTable>> tables;
+	for( int i = 0; i < THREAD_COUNT; ++i ) {
+		tables.push_back( SharedTimerTable::open( name_ ) );
+		ASSERT_NE( nullptr, tables.back( ) );
+	}
+
+	std::vector<std::vector<std::uint32_t>> claimed( THREAD_COUNT );
+	std::vector<std::thread> threads;
+	for( int i = 0; i < THREAD_COUNT; ++i ) {
+		threads.emplace_back( [&tables, &claimed, i]( )
+			{
+				while( auto slot = tables[ i ]->claim( ) )
+					claimed[ i ].push_back( *slot );
+			} );
+	}
+	for( auto& thread : threads )
+		thread.join( );
+
+	std::set<std::uint32_t> unique;
+	for( const auto& slots : claimed )
+		unique.insert( slots.begin( ), slots.end( ) );
+
+	std::size_t total = 0;
+	for( const auto& slots : claimed )
+		total += slots.size( );
+	EXPECT_EQ( SharedTimerTable::CAPACITY, unique.size( ) );
+	EXPECT_EQ( SharedTimerTable::CAPACITY, total );
+}
+
+// Test readers never observe a torn write
+TEST_F( SharedTimerTableTest, ReadsAreConsistent )
+{
+	auto owner = SharedTimerTable::open( name_ );
+	auto viewer = SharedTimerTable::open( name_ );
+	ASSERT_NE( nullptr, owner );
+	ASSERT_NE( nullptr, viewer );
+
+	auto slot = owner->claim( );
+	ASSERT_TRUE( slot.has_value( ) );
+	owner->publish( *slot, makeState( "0", 0 ) );
+
+	std::atomic<bool> done = false;
+	std::thread writer( [&]( )
+		{
+			for( std::int64_t i = 1; i <= 100'000; ++i )
+				owner->publish( *slot, makeState( std::to_string( i ), i ) );
+			done = true;
+		} );
+
+	int torn = 0;
+	int reads = 0;
+	while( !done ) {
+		if( auto entry = viewer->read( *slot ) ) {
+			torn += entry->state.name != std::to_string( entry->state.deadline );
+			++reads;
+		}
+	}
+	writer.join( );
+
+	EXPECT_EQ( 0, torn );
+	EXPECT_GT( reads, 0 );
+}
+
+// Test slots of exited processes can be reclaimed
+TEST_F( SharedTimerTableTest, ReapsDeadOwners )
+{
+	auto table = SharedTimerTable::open( name_ );
+	ASSERT_NE( nullptr, table );
+
+	pid_t child = ::fork( );
+	ASSERT_GE( child, 0 );
+	if( child == 0 ) {
+		// Exit without unwinding so the child's slot is left behind
+		auto childTable = SharedTimerTable::open( name_ );
+		if( childTable )
+			if( auto slot = childTable->claim( ) )
+				childTable->publish( *slot, makeState( "Orphan", 0 ) );
+		::_exit( 0 );
+	}
+	int status = 0;
+	::waitpid( child, &status, 0 );
+
+	auto entries = table->snapshot( );
+	ASSERT_EQ( 1u, entries.size( ) );
+	EXPECT_EQ( child, entries[ 0 ].ownerPid );
+
+	EXPECT_EQ( 1u, table->reapDeadOwners( ) );
+	EXPECT_TRUE( table->snapshot( ).empty( ) );
+}
+
+// Test a slot whose writer died mid-publish is readable again once reused
+TEST_F( SharedTimerTableTest, ReusesSlotOfWriterDeadMidPublish )
+{
+	auto table = SharedTimerTable::open( name_ );
+	ASSERT_NE( nullptr, table );
+
+	pid_t child = ::fork( );
+	ASSERT_GE( child, 0 );
+	if( child == 0 ) {
+		auto childTable = SharedTimerTable::open( name_ );
+		if( childTable )
+			if( auto slot = childTable->claim( ) )
+				childTable->publish( *slot, makeState( "Orphan", 0 ) );
+		::_exit( 0 );
+	}
+	int status = 0;
+	::waitpid( child, &status, 0 );
+
+	auto entries = table->snapshot( );
+	ASSERT_EQ( 1u, entries.size( ) );
+	auto orphan = entries[ 0 ].slot;
+
+	// Leave the sequence odd as a writer killed between its two bumps would; the segment
+	// is a 64-byte header followed by the slots, each starting with the 64-bit owner word
+	// and then the sequence word
+	{
+		int fd = ::shm_open( name_.c_str( ), O_RDWR, 0600 );
+		ASSERT_GE( fd, 0 );
+		struct stat fileStatus{ };
+		ASSERT_EQ( 0, ::fstat( fd, &fileStatus ) );
+		auto size = static_cast< std::size_t >( fileStatus.st_size );
+		void* mapping = ::mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+		::close( fd );
+		ASSERT_NE( MAP_FAILED, mapping );
+
+		auto slotSize = ( size - 64 ) / SharedTimerTable::CAPACITY;
+		auto* sequence = reinterpret_cast< std::atomic<std::uint32_t>* >(
+			static_cast< char* >( mapping ) + 64 + orphan * slotSize + sizeof( std::uint64_t ) );
+		sequence->fetch_add( 1 );
+		::munmap( mapping, size );
+	}
+	EXPECT_FALSE( table->read( orphan ).has_value( ) );
+	EXPECT_EQ( 1u, table->reapDeadOwners( ) );
+
+	// Claim until the orphaned slot comes around, then publish into it
+	std::vector<std::uint32_t> others;
+	std::optional<std::uint32_t> reused;
+	while( auto slot = table->claim( ) ) {
+		if( *slot == orphan ) {
+			reused = slot;
+			break;
+		}
+		others.push_back( *slot );
+	}
+	for( auto slot : others )
+		table->release( slot );
+	ASSERT_TRUE( reused.has_value( ) );
+
+	table->publish( *reused, makeState( "Reused", 0 ) );
+	auto entry = table->read( *reused );
+	ASSERT_TRUE( entry.has_value( ) );
+	EXPECT_EQ( "Reused", entry->state.name );
+}
+
+// Test reaping dead owners while other mappings claim never hands a slot to two owners
+TEST_F( SharedTimerTableTest, ReapingWhileClaimingKeepsOwnersUnique )
+{
+	constexpr int ROUND_COUNT = 20;
+	constexpr int CLAIMER_COUNT = 4;
+	constexpr int REAPER_COUNT = 4;
+
+	for( int round = 0; round < ROUND_COUNT; ++round ) {
+		// A dead process leaves every slot behind
+		pid_t child = ::fork( );
+		ASSERT_GE( child, 0 );
+		if( child == 0 ) {
+			auto childTable = SharedTimerTable::open( name_ );
+			if( childTable )
+				while( auto slot = childTable->claim( ) )
+					childTable->publish( *slot, makeState( "Orphan", 0 ) );
+			::_exit( 0 );
+		}
+		int status = 0;
+		::waitpid( child, &status, 0 );
+
+		std::vector<std::unique_ptr<SharedTimerTable>> tables;
+		for( int i = 0; i < CLAIMER_COUNT + REAPER_COUNT; ++i ) {
+			tables.push_back( SharedTimerTable::open( name_ ) );
+			ASSERT_NE( nullptr, tables.back( ) );
+		}
+
+		// Claimers keep trying until every orphan was reaped and the table is full again
+		std::atomic<bool> reaping = true;
+		std::atomic<std::size_t> reaped = 0;
+		std::vector<std::vector<std::uint32_t>> claimed( CLAIMER_COUNT );
+		std::vector<std::thread> claimers;
+		for( int i = 0; i < CLAIMER_COUNT; ++i ) {
+			claimers.emplace_back( [&tables, &claimed, &reaped, i]( )
+				{
+					while( true ) {
+						bool done = reaped >= SharedTimerTable::CAPACITY;
+						auto slot = tables[ i ]->claim( );
+						if( !slot ) {
+							if( done )
+								break;
+							continue;
+						}
+						tables[ i ]->publish( *slot, makeState( "Claimer " + std::to_string( i ), 0 ) );
+						claimed[ i ].push_back( *slot );
+					}
+				} );
+		}
+		std::vector<std::thread> reapers;
+		for( int i = 0; i < REAPER_COUNT; ++i ) {
+			reapers.emplace_back( [&tables, &reaped, &reaping, i]( )
+				{
+					while( reaping )
+						reaped += tables[ CLAIMER_COUNT + i ]->reapDeadOwners( );
+				} );
+		}
+
+		for( auto& thread : claimers )
+			thread.join( );
+		reaping = false;
+		for( auto& thread : reapers )
+			thread.join( );
+
+		// Every orphan was reaped exactly once and every slot has exactly one claimer
+		EXPECT_EQ( SharedTimerTable::CAPACITY, reaped.load( ) );
+		std::set<std::uint32_t> unique;
+		std::size_t total = 0;
+		for( int i = 0; i < CLAIMER_COUNT; ++i ) {
+			for( auto slot : claimed[ i ] ) {
+				unique.insert( slot );
+				auto entry = tables[ i ]->read( slot );
+				ASSERT_TRUE( entry.has_value( ) );
+				EXPECT_EQ( "Claimer " + std::to_string( i ), entry->state.name );
+			}
+			total += claimed[ i ].size( );
+		}
+		EXPECT_EQ( SharedTimerTable::CAPACITY, total );
+		EXPECT_EQ( total, unique.size( ) );
+	}
+}
+
+#endif
@@ -0,0 +1,186 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+module;
+
+#include <gtest/gtest.h>
+
+export module task_test;
+
+import model.async_event;
+import model.task;
+import model.timer_store;
+import model.item;
+import <chrono>;
+import <stdexcept>;
+import <string>;
+import <vector>;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+	// Wait for a build, then run the tests, then notify
+	Task buildThenTest( TimerStore& store, TimerStore::TimerId build, TimerStore::TimerId tests,
+		TimerStore::TimePoint testStart, std::vector<std::string>& log )
+	{
+		bool built = co_await store.completion( build );
+		if( !built ) {
+			log.push_back( "build removed" );
+			co_return;
+		}
+		log.push_back( "build done" );
+
+		store.start( tests, testStart );
+		co_await store.completion( tests );
+		log.push_back( "tests done" );
+	}
+
+	Task waitForEvent( AsyncEvent& event, std::vector<std::string>& log, std::string name )
+	{
+		bool set = co_await event;
+		log.push_back( name + ( set ? " set" : " cancelled" ) );
+	}
+
+	Task fail( AsyncEvent& event )
+	{
+		co_await event;
+		throw std::runtime_error( "failed" );
+	}
+
+	Task awaitTask( Task& task, bool& caught )
+	{
+		try {
+			co_await task;
+		}
+		catch( const std::runtime_error& ) {
+			caught = true;
+		}
+	}
+}
+
+// Test fixture for coroutine tests
+class TaskTest : public ::testing::Test
+{
+protected:
+	const TimerStore::TimePoint START = TimerStore::TimePoint( 1'000'000s );
+
+	TimerStore store_;
+	std::vector<std::string> log_;
+};
+
+// Test a coroutine sequences timers without nested callbacks
+TEST_F( TaskTest, SequencesTimers )
+{
+	auto build = store_.add( Item( "Build", "", "", 60 ) );
+	auto tests = store_.add( Item( "Tests", "", "", 30 ) );
+	store_.start( build, START );
+
+	auto task = buildThenTest( store_, build, tests, START + 60s, log_ );
+	EXPECT_FALSE( task.isDone( ) );
+
+	store_.update( START + 30s );
+	EXPECT_TRUE( log_.empty( ) );
+
+	store_.update( START + 60s );
+	EXPECT_EQ( std::vector<std::string>{ "build done" }, log_ );
+	EXPECT_TRUE( store_.isRunning( tests ) );
+
+	store_.update( START + 90s );
+	EXPECT_EQ( ( std::vector<std::string>{ "build done", "tests done" } ), log_ );
+	EXPECT_TRUE( task.isDone( ) );
+}
+
+// Test awaiting a completed, removed or unknown timer
+TEST_F( TaskTest, CompletedAndRemovedTimers )
+{
+	auto build = store_.add( Item( "Build", "", "", 0 ) );
+	auto tests = store_.add( Item( "Tests", "", "", 30 ) );
+	store_.start( build, START );
+	store_.update( START );
+
+	// Already completed, so the first wait does not suspend
+	auto task = buildThenTest( store_, build, tests, START, log_ );
+	EXPECT_EQ( std::vector<std::string>{ "build done" }, log_ );
+
+	// Removing the awaited timer resumes with a cancelled result
+	auto other = store_.add( Item( "Other", "", "", 30 ) );
+	auto removed = buildThenTest( store_, other, tests, START, log_ );
+	store_.remove( other );
+	EXPECT_EQ( ( std::vector<std::string>{ "build done", "build removed" } ), log_ );
+	EXPECT_TRUE( removed.isDone( ) );
+
+	auto unknown = buildThenTest( store_, 1'000, tests, START, log_ );
+	EXPECT_TRUE( unknown.isDone( ) );
+}
+
+// Test destroying a waiting task unlinks it from the timer
+TEST_F( TaskTest, DestroyingTaskCancelsWait )
+{
+	auto build = store_.add( Item( "Build", "", "", 10 ) );
+	auto tests = store_.add( Item( "Tests", "", "", 10 ) );
+	store_.start( build, START );
+	{
+		auto task = buildThenTest( store_, build, tests, START, log_ );
+		auto kept = buildThenTest( store_, build, tests, START + 10s, log_ );
+		kept.detach( );
+	}
+
+	store_.update( START + 10s );
+	EXPECT_EQ( std::vector<std::string>{ "build done" }, log_ );
+	store_.update( START + 20s );
+	EXPECT_EQ( ( std::vector<std::string>{ "build done", "tests done" } ), log_ );
+}
+
+// Test event waiters resume in order, and only while the event is set
+TEST_F( TaskTest, EventResumesWaitersInOrder )
+{
+	AsyncEvent event;
+	auto first = waitForEvent( event, log_, "first" );
+	auto second = waitForEvent( event, log_, "second" );
+	EXPECT_TRUE( log_.empty( ) );
+
+	event.set( );
+	EXPECT_EQ( ( std::vector<std::string>{ "first set", "second set" } ), log_ );
+
+	// Set events complete waits at once until reset
+	auto third = waitForEvent( event, log_, "third" );
+	EXPECT_TRUE( third.isDone( ) );
+
+	event.reset( );
+	auto fourth = waitForEvent( event, log_, "fourth" );
+	EXPECT_FALSE( fourth.isDone( ) );
+	event.cancel( );
+	EXPECT_EQ( "fourth cancelled", log_.back( ) );
+	EXPECT_FALSE( event.isSet( ) );
+}
+
+// Test exceptions reach an awaiting task or the owner
+TEST_F( TaskTest, PropagatesExceptions )
+{
+	AsyncEvent event;
+	auto failing = fail( event );
+	bool caught = false;
+	auto awaiting = awaitTask( failing, caught );
+
+	event.set( );
+	EXPECT_TRUE( caught );
+	EXPECT_TRUE( awaiting.isDone( ) );
+	EXPECT_TRUE( failing.isDone( ) );
+	EXPECT_THROW( failing.rethrowIfFailed( ), std::runtime_error );
+}
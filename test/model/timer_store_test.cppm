@@ -0,0 +1,551 @@
+/*
+ * Ticks - Timers, Events and GUI
+ * Copyright (C) 2025 Piotr Tkaczyk
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+module;
+
+#include <gtest/gtest.h>
+
+export module timer_store_test;
+
+import model.timer_store;
+import model.small_callback;
+import model.item;
+import model.completion_archive;
+import model.schedule;
+import <array>;
+import <chrono>;
+import <algorithm>;
+import <memory>;
+import <random>;
+import <string>;
+import <tuple>;
+import <vector>;
+
+using namespace std::chrono_literals;
+
+// Test fixture for TimerStore tests
+class TimerStoreTest : public ::testing::Test
+{
+protected:
+	const TimerStore::TimePoint START = TimerStore::TimePoint( 1'000'000s );
+	const Item TEST_ITEM = Item( "Test Item", "Test Type", "Test Action", 60 );
+
+	TimerStore store_;
+};
+
+// Test a new timer is stopped with its full duration
+TEST_F( TimerStoreTest, AddCreatesStoppedTimer )
+{
+	auto id = store_.add( TEST_ITEM );
+
+	EXPECT_TRUE( store_.contains( id ) );
+	EXPECT_EQ( 1u, store_.size( ) );
+	EXPECT_EQ( TEST_ITEM, store_.getItem( id ) );
+	EXPECT_FALSE( store_.isRunning( id ) );
+	EXPECT_FALSE( store_.isCompleted( id ) );
+	EXPECT_EQ( 60, store_.getRemainingSeconds( id, START ) );
+	EXPECT_EQ( "01:00", store_.getRemainingTimeString( id, START ) );
+}
+
+// Test remaining time counts down while running and freezes while stopped
+TEST_F( TimerStoreTest, StartStopKeepsRemainingTime )
+{
+	auto id = store_.add( TEST_ITEM );
+
+	store_.start( id, START );
+	EXPECT_TRUE( store_.isRunning( id ) );
+	EXPECT_EQ( START + 60s, store_.getETA( id, START ) );
+	EXPECT_EQ( 50, store_.getRemainingSeconds( id, START + 10s ) );
+	EXPECT_EQ( 51, store_.getRemainingSeconds( id, START + 9500ms ) ); // Partial seconds round up
+
+	store_.stop( id, START + 10s );
+	EXPECT_FALSE( store_.isRunning( id ) );
+	EXPECT_EQ( 50, store_.getRemainingSeconds( id, START + 100s ) );
+
+	store_.start( id, START + 100s );
+	EXPECT_EQ( START + 150s, store_.getETA( id, START + 100s ) );
+}
+
+// Test due timers complete on update and fire their callbacks once
+TEST_F( TimerStoreTest, UpdateCompletesDueTimers )
+{
+	int completedCount = 0;
+	auto shortId = store_.add( TEST_ITEM.withTimeout( 5 ), [&completedCount]( ) { ++completedCount; } );
+	auto longId = store_.add( TEST_ITEM, [&completedCount]( ) { ++completedCount; } );
+	auto stoppedId = store_.add( TEST_ITEM.withTimeout( 1 ) );
+
+	store_.start( shortId, START );
+	store_.start( longId, START );
+
+	EXPECT_EQ( 0u, store_.update( START + 4s ) );
+	EXPECT_EQ( 1u, store_.update( START + 5s ) );
+	EXPECT_EQ( 1, completedCount );
+	EXPECT_TRUE( store_.isCompleted( shortId ) );
+	EXPECT_FALSE( store_.isRunning( shortId ) );
+	EXPECT_EQ( 0, store_.getRemainingSeconds( shortId, START + 5s ) );
+	EXPECT_FALSE( store_.isCompleted( longId ) );
+	EXPECT_FALSE( store_.isCompleted( stoppedId ) );
+
+	EXPECT_EQ( 0u, store_.update( START + 6s ) );
+	EXPECT_EQ( 1, completedCount );
+
+	// A reset timer can complete again and keeps its callback
+	store_.reset( shortId );
+	EXPECT_FALSE( store_.isCompleted( shortId ) );
+	store_.start( shortId, START + 10s );
+	EXPECT_EQ( 2u, store_.update( START + 60s ) );
+	EXPECT_EQ( 3, completedCount );
+}
+
+// Test removing timers keeps ids stable and order intact
+TEST_F( TimerStoreTest, RemoveKeepsOtherTimers )
+{
+	std::array<TimerStore::TimerId, 4> ids;
+	for( int i = 0; i < 4; ++i )
+		ids[ i ] = store_.add( TEST_ITEM.withTimeout( 10 * ( i + 1 ) ) );
+
+	store_.remove( ids[ 1 ] );
+
+	EXPECT_FALSE( store_.contains( ids[ 1 ] ) );
+	EXPECT_EQ( 3u, store_.size( ) );
+	EXPECT_EQ( ( std::vector<TimerStore::TimerId>{ ids[ 0 ], ids[ 2 ], ids[ 3 ] } ), store_.getIds( ) );
+	EXPECT_EQ( 40, store_.getRemainingSeconds( ids[ 3 ], START ) );
+
+	// A new timer reuses the freed id and is listed last
+	auto newId = store_.add( TEST_ITEM );
+	EXPECT_EQ( ids[ 1 ], newId );
+	EXPECT_EQ( newId, store_.getIds( ).back( ) );
+}
+
+// Test equal items share one pooled copy
+TEST_F( TimerStoreTest, EqualItemsAreInterned )
+{
+	auto first = store_.add( TEST_ITEM );
+	auto second = store_.add( TEST_ITEM );
+	auto other = store_.add( TEST_ITEM.withName( "Other" ) );
+
+	EXPECT_EQ( store_.getItemHandle( first ), store_.getItemHandle( second ) );
+	EXPECT_NE( store_.getItemHandle( first ), store_.getItemHandle( other ) );
+
+	store_.remove( first );
+	EXPECT_EQ( TEST_ITEM, store_.getItem( second ) );
+}
+
+// Test freed pool slots are reused and stay interned
+TEST_F( TimerStoreTest, FreedItemsAreReinterned )
+{
+	auto first = store_.add( TEST_ITEM );
+	auto handle = store_.getItemHandle( first );
+	store_.remove( first );
+
+	auto reused = store_.add( TEST_ITEM.withName( "Other" ) );
+	auto shared = store_.add( TEST_ITEM.withName( "Other" ) );
+	EXPECT_EQ( handle, store_.getItemHandle( reused ) );
+	EXPECT_EQ( handle, store_.getItemHandle( shared ) );
+
+	// The released item is no longer found under its old contents
+	auto fresh = store_.add( TEST_ITEM );
+	EXPECT_NE( handle, store_.getItemHandle( fresh ) );
+	EXPECT_EQ( TEST_ITEM, store_.getItem( fresh ) );
+}
+
+// Test callbacks may modify the store while being invoked
+TEST_F( TimerStoreTest, CallbackCanAddTimers )
+{
+	TimerStore::TimerId followUp = 0;
+	bool added = false;
+	auto id = store_.add( TEST_ITEM.withTimeout( 1 ), [&]( )
+		{
+			followUp = store_.add( TEST_ITEM );
+			added = true;
+		} );
+
+	store_.start( id, START );
+	store_.update( START + 1s );
+
+	ASSERT_TRUE( added );
+	EXPECT_TRUE( store_.contains( followUp ) );
+	EXPECT_EQ( 2u, store_.size( ) );
+}
+
+// Test wakeups follow expiries and changes of the displayed seconds
+TEST_F( TimerStoreTest, NextDeadlines )
+{
+	EXPECT_FALSE( store_.getNextExpiry( ).has_value( ) );
+	EXPECT_FALSE( store_.getNextDisplayChange( START ).has_value( ) );
+
+	auto longId = store_.add( TEST_ITEM );
+	auto shortId = store_.add( TEST_ITEM.withTimeout( 5 ) );
+	std::ignore = store_.add( TEST_ITEM.withTimeout( 1 ) );
+
+	// Stopped timers never need a wakeup
+	EXPECT_FALSE( store_.getNextExpiry( ).has_value( ) );
+
+	store_.start( longId, START );
+	store_.start( shortId, START + 300ms );
+	EXPECT_EQ( START + 5300ms, store_.getNextExpiry( ) );
+	EXPECT_EQ( START + 1000ms, store_.getNextDisplayChange( START + 400ms ) );
+	EXPECT_EQ( START + 1300ms, store_.getNextDisplayChange( START + 1000ms ) );
+
+	// Nearby changes are folded, but never past an expiry
+	EXPECT_EQ( START + 1300ms, store_.getNextDisplayChange( START + 400ms, 500ms ) );
+	EXPECT_EQ( START + 5300ms, store_.getNextDisplayChange( START + 5250ms, 800ms ) );
+
+	// An overdue timer needs a wakeup right away
+	EXPECT_EQ( START + 6s, store_.getNextDisplayChange( START + 6s ) );
+
+	store_.stop( longId, START + 2s );
+	store_.update( START + 6s );
+	EXPECT_FALSE( store_.getNextExpiry( ).has_value( ) );
+}
+
+// Test recurring timers are re-armed on every occurrence instead of completing
+TEST_F( TimerStoreTest, RecurringTimersRearm )
+{
+	int fired = 0;
+	int runs = 0;
+	store_.setRunListener( [&runs]( const TimerStore::RunEnd& ) { ++runs; } );
+	auto id = store_.add( TEST_ITEM.withSchedule( "every 10s" ), [&fired]( ) { ++fired; } );
+	EXPECT_TRUE( store_.isRecurring( id ) );
+	EXPECT_EQ( 10, store_.getRemainingSeconds( id, START ) );
+
+	store_.start( id, START );
+	EXPECT_EQ( 1u, store_.update( START + 10s ) );
+	EXPECT_TRUE( store_.isRunning( id ) );
+	EXPECT_FALSE( store_.isCompleted( id ) );
+	EXPECT_EQ( START + 20s, store_.getETA( id, START + 10s ) );
+
+	// Missed occurrences fire once and keep the phase of the series
+	EXPECT_EQ( 1u, store_.update( START + 45s ) );
+	EXPECT_EQ( START + 50s, store_.getETA( id, START + 45s ) );
+	EXPECT_EQ( 2, fired );
+
+	// The series is a single run
+	EXPECT_EQ( 0, runs );
+	store_.reset( id );
+	EXPECT_EQ( 1, runs );
+	EXPECT_TRUE( store_.isRecurring( id ) );
+	EXPECT_FALSE( store_.isRunning( id ) );
+}
+
+// Test periods follow the timeout, the interval or the current calendar occurrence
+TEST_F( TimerStoreTest, PeriodsFollowSchedules )
+{
+	auto once = store_.add( TEST_ITEM );
+	auto interval = store_.add( TEST_ITEM.withSchedule( "every 10s" ) );
+	auto calendar = store_.add( TEST_ITEM.withSchedule( "*:15" ) );
+	EXPECT_EQ( 60s, store_.getPeriod( once, START ) );
+	EXPECT_EQ( 10s, store_.getPeriod( interval, START ) );
+
+	// A stopped calendar series reports the occurrence it would count down if started now
+	auto schedule = Schedule::parse( "*:15" );
+	ASSERT_TRUE( schedule.has_value( ) );
+	auto first = schedule->nextAfter( START );
+	auto second = schedule->nextAfter( first );
+	EXPECT_EQ( first - START, store_.getPeriod( calendar, START ) );
+
+	store_.start( calendar, START );
+	EXPECT_EQ( first - START, store_.getPeriod( calendar, START + 1s ) );
+
+	store_.update( first );
+	EXPECT_EQ( second - first, store_.getPeriod( calendar, first ) );
+}
+
+// Test abandoned runs end at the time given to reset and remove
+TEST_F( TimerStoreTest, AbandonedRunsEndAtGivenTime )
+{
+	std::vector<TimerStore::RunEnd> runEnds;
+	store_.setRunListener( [&runEnds]( const TimerStore::RunEnd& runEnd ) { runEnds.push_back( runEnd ); } );
+	auto first = store_.add( TEST_ITEM );
+	auto second = store_.add( TEST_ITEM.withName( "Other" ) );
+
+	store_.start( first, START );
+	store_.reset( first, START + 5s );
+	store_.start( second, START + 1s );
+	store_.resetAll( TimerSelector( ).withNameContaining( "Other" ), START + 6s );
+	store_.start( first, START + 10s );
+	store_.remove( first, START + 12s );
+	store_.start( second, START + 20s );
+	store_.removeAll( TimerSelector( ), START + 21s );
+
+	ASSERT_EQ( 4u, runEnds.size( ) );
+	EXPECT_EQ( START, runEnds[ 0 ].startedAt );
+	EXPECT_EQ( START + 5s, runEnds[ 0 ].endedAt );
+	EXPECT_EQ( START + 6s, runEnds[ 1 ].endedAt );
+	EXPECT_EQ( START + 10s, runEnds[ 2 ].startedAt );
+	EXPECT_EQ( START + 12s, runEnds[ 2 ].endedAt );
+	EXPECT_EQ( START + 21s, runEnds[ 3 ].endedAt );
+	EXPECT_FALSE( runEnds[ 3 ].completed );
+}
+
+// Test bulk operations act on exactly the timers a selector matches
+TEST_F( TimerStoreTest, BulkOperations )
+{
+	auto build = store_.add( Item( "Build", "Development", "make", 60 ) );
+	auto test = store_.add( Item( "Test", "Development", "ctest", 10 ) );
+	auto backup = store_.add( Item( "Backup", "Maintenance", "dump", 60 ) );
+	auto vacuum = store_.add( Item( "Vacuum", "Maintenance", "vacuum", 60 ) );
+
+	EXPECT_EQ( ( std::vector<std::string>{ "Development", "Maintenance" } ), store_.getTypes( ) );
+	EXPECT_EQ( 4u, store_.startAll( TimerSelector( ), START ) );
+	EXPECT_EQ( 2u, store_.stopAll( TimerSelector( ).withType( "Maintenance" ), START + 1s ) );
+	EXPECT_TRUE( store_.isRunning( build ) );
+	EXPECT_FALSE( store_.isRunning( backup ) );
+	EXPECT_FALSE( store_.isRunning( vacuum ) );
+
+	store_.update( START + 10s );
+	EXPECT_EQ( TimerState::Completed, store_.getState( test ) );
+
+	auto completed = store_.select( TimerSelector( ).withState( TimerState::Completed ) );
+	EXPECT_EQ( std::vector<TimerStore::TimerId>{ test }, completed );
+	auto byName = store_.select( TimerSelector( ).withType( "Maintenance" ).withNameContaining( "Vac" ) );
+	EXPECT_EQ( std::vector<TimerStore::TimerId>{ vacuum }, byName );
+	EXPECT_TRUE( store_.select( TimerSelector( ).withType( "Personal" ) ).empty( ) );
+
+	EXPECT_EQ( 1u, store_.resetAll( TimerSelector( ).withState( TimerState::Completed ) ) );
+	EXPECT_EQ( TimerState::Stopped, store_.getState( test ) );
+
+	EXPECT_EQ( 3u, store_.removeAll( TimerSelector( ).withState( TimerState::Stopped ) ) );
+	EXPECT_EQ( std::vector<TimerStore::TimerId>{ build }, store_.getIds( ) );
+	EXPECT_EQ( ( std::vector<std::string>{ "Development" } ), store_.getTypes( ) );
+}
+
+// Test the indexes agree with a full scan after a random mix of operations
+TEST_F( TimerStoreTest, IndexesFollowChanges )
+{
+	std::mt19937 random( 7 );
+	std::vector<TimerStore::TimerId> ids;
+	auto now = START;
+	for( int step = 0; step < 2'000; ++step ) {
+		now += 100ms;
+		auto choice = random( ) % 6;
+		if( ids.empty( ) || choice == 0 ) {
+			auto type = "Type " + std::to_string( random( ) % 4 );
+			ids.push_back( store_.add( Item( "Timer", type, "", 1 + static_cast< int >( random( ) % 3 ) ) ) );
+			continue;
+		}
+
+		auto id = ids[ random( ) % ids.size( ) ];
+		switch( choice ) {
+			case 1: store_.start( id, now ); break;
+			case 2: store_.stop( id, now ); break;
+			case 3: store_.reset( id ); break;
+			case 4: store_.update( now ); break;
+			default:
+				store_.remove( id );
+				ids.erase( std::find( ids.begin( ), ids.end( ), id ) );
+				break;
+		}
+	}
+
+	for( auto state : { TimerState::Stopped, TimerState::Running, TimerState::Completed } ) {
+		for( const auto& type : store_.getTypes( ) ) {
+			auto selector = TimerSelector( ).withType( type ).withState( state );
+			std::vector<TimerStore::TimerId> expected;
+			for( auto id : ids ) {
+				if( store_.getItem( id ).getType( ) == type && store_.getState( id ) == state )
+					expected.push_back( id );
+			}
+
+			auto selected = store_.select( selector );
+			std::sort( selected.begin( ), selected.end( ) );
+			std::sort( expected.begin( ), expected.end( ) );
+			EXPECT_EQ( expected, selected );
+		}
+	}
+}
+
+// Test retention evicts the oldest completed timers beyond its count and age
+TEST_F( TimerStoreTest, EvictsCompletedTimers )
+{
+	std::vector<TimerStore::TimerId> ids;
+	for( int i = 0; i < 5; ++i ) {
+		ids.push_back( store_.add( TEST_ITEM.withTimeout( i + 1 ) ) );
+		store_.start( ids.back( ), START );
+	}
+	auto running = store_.add( TEST_ITEM );
+	store_.start( running, START );
+	store_.update( START + 5s );
+
+	// A completion that was reset is no longer subject to retention
+	store_.reset( ids[ 0 ] );
+
+	std::vector<TimerStore::TimerId> evicted;
+	RetentionPolicy policy;
+	policy.keepCompleted = 2;
+	auto onEvict = [this, &evicted]( const TimerStore::Eviction& eviction )
+		{
+			evicted.push_back( eviction.id );
+			EXPECT_EQ( START, eviction.startedAt );
+		};
+	EXPECT_EQ( 2u, store_.evictCompleted( policy, START + 5s, onEvict ) );
+	EXPECT_EQ( ( std::vector<TimerStore::TimerId>{ ids[ 1 ], ids[ 2 ] } ), evicted );
+	EXPECT_FALSE( store_.contains( ids[ 1 ] ) );
+	EXPECT_TRUE( store_.contains( ids[ 0 ] ) );
+	EXPECT_TRUE( store_.contains( running ) );
+
+	// The rest completed at 4s and 5s; at 5.5s only the first is over a second old
+	policy.maxAgeSeconds = 1;
+	EXPECT_EQ( 0u, store_.evictCompleted( policy, START + 4500ms ) );
+	EXPECT_EQ( 1u, store_.evictCompleted( policy, START + 5500ms ) );
+	EXPECT_FALSE( store_.contains( ids[ 3 ] ) );
+	EXPECT_TRUE( store_.contains( ids[ 4 ] ) );
+}
+
+// Test small callables are stored inline and large ones still work
+TEST( SmallCallbackTest, InlineAndHeapStorage )
+{
+	int calls = 0;
+	auto small = [&calls]( ) { ++calls; };
+	std::array<char, 256> payload{ };
+	auto large = [&calls, payload]( ) { calls += 1 + payload[ 0 ]; };
+
+	EXPECT_TRUE( SmallCallback::isStoredInline<decltype( small )>( ) );
+	EXPECT_FALSE( SmallCallback::isStoredInline<decltype( large )>( ) );
+
+	SmallCallback first( small );
+	SmallCallback second( large );
+	first( );
+	second( );
+	EXPECT_EQ( 2, calls );
+
+	// Moving transfers the function and empties the source
+	SmallCallback moved( std::move( second ) );
+	EXPECT_FALSE( second );
+	moved( );
+	EXPECT_EQ( 3, calls );
+
+	first = std::move( moved );
+	first( );
+	EXPECT_EQ( 4, calls );
+	EXPECT_FALSE( SmallCallback( ) );
+}
+
+// Test move-only callables are accepted
+TEST( SmallCallbackTest, MoveOnlyFunction )
+{
+	auto value = std::make_unique<int>( 41 );
+	int result = 0;
+	SmallCallback callback( [value = std::move( value ), &result]( ) { result = *value + 1; } );
+
+	callback( );
+	EXPECT_EQ( 42, result );
+}
+
+// Test the archive keeps the newest records in a fixed ring
+TEST( CompletionArchiveTest, KeepsNewestRecords )
+{
+	CompletionArchive archive( 3 );
+	auto start = CompletionArchive::TimePoint( std::chrono::seconds( 1'000 ) );
+	for( int i = 0; i < 5; ++i )
+		archive.add( Item( "Run " + std::to_string( i ) ), start, start + std::chrono::seconds( i ) );
+
+	ASSERT_EQ( 3u, archive.size( ) );
+	EXPECT_EQ( 5u, archive.getTotalCount( ) );
+	EXPECT_EQ( "Run 2", archive[ 0 ].getName( ) );
+	EXPECT_EQ( "Run 4", archive[ 2 ].getName( ) );
+	EXPECT_EQ( 1'004'000, archive[ 2 ].completedAt );
+
+	archive.setCapacity( 2 );
+	ASSERT_EQ( 2u, archive.size( ) );
+	EXPECT_EQ( "Run 3", archive[ 0 ].getName( ) );
+	archive.add( Item( std::string( 100, 'x' ) ), start, start );
+	EXPECT_EQ( "Run 4", archive[ 0 ].getName( ) );
+	EXPECT_EQ( ArchivedRun::NAME_SIZE, archive[ 1 ].getName( ).size( ) );
+}
+
+// Test resizing a ring that wrapped keeps the newest records in order
+TEST( CompletionArchiveTest, ResizesWrappedRing )
+{
+	CompletionArchive archive( 4 );
+	auto start = CompletionArchive::TimePoint( std::chrono::seconds( 1'000 ) );
+	auto add = [&archive, start]( int i ) { archive.add( Item( "Run " + std::to_string( i ) ), start, start ); };
+	auto names = [&archive]( )
+		{
+			std::vector<std::string> result;
+			for( std::size_t i = 0; i < archive.size( ); ++i )
+				result.emplace_back( archive[ i ].getName( ) );
+			return result;
+		};
+	for( int i = 0; i < 6; ++i )
+		add( i );
+
+	// Growing keeps every record and fills the new room before overwriting
+	archive.setCapacity( 6 );
+	EXPECT_EQ( ( std::vector<std::string>{ "Run 2", "Run 3", "Run 4", "Run 5" } ), names( ) );
+	for( int i = 6; i < 9; ++i )
+		add( i );
+	EXPECT_EQ( ( std::vector<std::string>{ "Run 3", "Run 4", "Run 5", "Run 6", "Run 7", "Run 8" } ), names( ) );
+
+	// Shrinking a wrapped ring keeps the newest
+	archive.setCapacity( 3 );
+	EXPECT_EQ( ( std::vector<std::string>{ "Run 6", "Run 7", "Run 8" } ), names( ) );
+	add( 9 );
+	EXPECT_EQ( ( std::vector<std::string>{ "Run 7", "Run 8", "Run 9" } ), names( ) );
+
+	archive.setCapacity( 0 );
+	add( 10 );
+	EXPECT_EQ( 0u, archive.size( ) );
+	EXPECT_EQ( 11u, archive.getTotalCount( ) );
+}
+
+// Test long names are cut at a character boundary
+TEST( CompletionArchiveTest, TruncatesAtCharacterBoundary )
+{
+	CompletionArchive archive( 2 );
+	auto start = CompletionArchive::TimePoint( std::chrono::seconds( 1'000 ) );
+
+	// A three-byte character would straddle the end of the buffer
+	std::string euros = "a";
+	for( int i = 0; i < 20; ++i )
+		euros += "\xE2\x82\xAC";
+	archive.add( Item( euros ), start, start );
+	EXPECT_EQ( euros.substr( 0, 46 ), archive[ 0 ].getName( ) );
+
+	std::string fits( ArchivedRun::NAME_SIZE - 2, 'a' );
+	archive.add( Item( fits + "\xC3\xA9" ), start, start );
+	EXPECT_EQ( fits + "\xC3\xA9", archive[ 1 ].getName( ) );
+}
+
+// Test completed timers are archived once older than the policy's age, however few there are
+TEST_F( TimerStoreTest, ArchivesCompletedTimersByAge )
+{
+	for( int timeout : { 1, 2, 30 } )
+		store_.start( store_.add( TEST_ITEM.withName( "Timer " + std::to_string( timeout ) ).withTimeout( timeout ) ), START );
+	store_.update( START + 30s );
+
+	RetentionPolicy policy;
+	policy.maxAgeSeconds = 10;
+	CompletionArchive archive( 10 );
+	auto onEvict = [&archive]( const TimerStore::Eviction& eviction )
+		{
+			archive.add( eviction.item, eviction.startedAt, eviction.completedAt );
+		};
+
+	// Completed at 1s, 2s and 30s; at 12s only the first is over ten seconds old
+	EXPECT_EQ( 1u, store_.evictCompleted( policy, START + 12s, onEvict ) );
+	ASSERT_EQ( 1u, archive.size( ) );
+	EXPECT_EQ( "Timer 1", archive[ 0 ].getName( ) );
+	EXPECT_EQ( 1'000'001'000, archive[ 0 ].completedAt );
+
+	EXPECT_EQ( 0u, store_.evictCompleted( policy, START + 12s, onEvict ) );
+	EXPECT_EQ( 1u, store_.evictCompleted( policy, START + 40s, onEvict ) );
+	ASSERT_EQ( 2u, archive.size( ) );
+	EXPECT_EQ( "Timer 2", archive[ 1 ].getName( ) );
+	EXPECT_EQ( 1u, store_.size( ) );
+}